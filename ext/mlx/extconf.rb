@@ -91,4 +91,7 @@ $CPPFLAGS = "#{$CPPFLAGS} -I#{include_dir}"
 $LDFLAGS = "#{$LDFLAGS} -L#{lib_dir} #{rpath_flag(lib_dir)}"
 $libs = "-lmlx #{$libs}"
 
+# zlib provides deflate for savez_compressed / compressed .npz loads.
+have_header("zlib.h") && have_library("z", "deflate", "zlib.h")
+
 create_makefile("mlx/native")
@@ -1,21 +1,44 @@
 #include <ruby.h>
+#include <ruby/memory_view.h>
 #include <ruby/thread.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <ctime>
 #include <exception>
 #include <fstream>
 #include <functional>
 #include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "mlx/allocator.h"
 #include "mlx/array.h"
 #include "mlx/backend/metal/metal.h"
 #include "mlx/compile.h"
@@ -56,6 +79,10 @@ static VALUE cFunction;
 static VALUE cFunctionExporter;
 static VALUE cGroup;
 static VALUE cKernel;
+static VALUE cDLPackCapsule;
+static VALUE cTreeSpec;
+static VALUE cCompileCache;
+static VALUE cSafetensorsFile;
 
 struct DtypeWrapper {
   mx::Dtype dtype;
@@ -69,12 +96,95 @@ struct DeviceWrapper {
   DeviceWrapper() : device(mx::Device::cpu, 0) {}
 };
 
+struct ArrayScope;
+
 struct ArrayWrapper {
   mx::array array;
+  // Bytes last reported to Ruby's GC via rb_gc_adjust_memory_usage.
+  size_t reported_bytes;
+  // Innermost MLX::Core.scope that will release this wrapper, if any.
+  ArrayScope* scope;
+  bool released;
+
+  ArrayWrapper() : array(0.0f), reported_bytes(0), scope(nullptr), released(false) {}
+  explicit ArrayWrapper(mx::array value)
+      : array(std::move(value)), reported_bytes(0), scope(nullptr), released(false) {}
+
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr) noexcept;
+};
+
+// Op results are wrapped and collected at a very high rate, so wrapper
+// storage is recycled through a freelist instead of the global allocator.
+// Both paths run with the GVL held.
+struct ArrayWrapperPool {
+  static constexpr size_t kMaxCached = 4096;
+  std::vector<void*> blocks;
+  uint64_t created = 0;
+  uint64_t freed = 0;
+  uint64_t pool_hits = 0;
+  uint64_t live = 0;
+};
+
+static ArrayWrapperPool array_wrapper_pool;
+
+void* ArrayWrapper::operator new(size_t size) {
+  auto& pool = array_wrapper_pool;
+  pool.created++;
+  pool.live++;
+  if (size == sizeof(ArrayWrapper) && !pool.blocks.empty()) {
+    void* block = pool.blocks.back();
+    pool.blocks.pop_back();
+    pool.pool_hits++;
+    return block;
+  }
+  return ::operator new(size);
+}
+
+void ArrayWrapper::operator delete(void* ptr) noexcept {
+  auto& pool = array_wrapper_pool;
+  pool.freed++;
+  pool.live--;
+  if (ptr != nullptr && pool.blocks.size() < ArrayWrapperPool::kMaxCached) {
+    pool.blocks.push_back(ptr);
+    return;
+  }
+  ::operator delete(ptr);
+}
 
-  ArrayWrapper() : array(0.0f) {}
+// Wrappers created while a scope is active. Tracking is weak: wrappers
+// collected by the GC remove themselves before the scope exits.
+struct ArrayScope {
+  ArrayScope* parent;
+  std::unordered_set<ArrayWrapper*> tracked;
 };
 
+// The innermost scope lives in fiber-local storage (Thread#[]), not a C++
+// thread_local: fibers share a native thread, and arrays created inside an
+// Enumerator or other fiber must not join a scope another fiber opened.
+// `open_array_scopes` lets array_wrap skip the lookup when no scope is open.
+static size_t open_array_scopes = 0;
+
+static ID array_scope_key() {
+  static const ID key = rb_intern("__mlx_array_scope__");
+  return key;
+}
+
+static ArrayScope* current_array_scope() {
+  if (open_array_scopes == 0) {
+    return nullptr;
+  }
+  VALUE stored = rb_thread_local_aref(rb_thread_current(), array_scope_key());
+  return NIL_P(stored) ? nullptr : reinterpret_cast<ArrayScope*>(static_cast<uintptr_t>(NUM2ULL(stored)));
+}
+
+static void set_current_array_scope(ArrayScope* scope) {
+  rb_thread_local_aset(
+      rb_thread_current(),
+      array_scope_key(),
+      scope == nullptr ? Qnil : ULL2NUM(static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(scope))));
+}
+
 struct StreamWrapper {
   mx::Stream stream;
 
@@ -117,6 +227,42 @@ struct KernelWrapper {
   VALUE refs;
 };
 
+// Minimal DLPack ABI (v0.8) used to exchange tensors with other native
+// libraries without copies.
+struct DLDevice {
+  int32_t device_type;
+  int32_t device_id;
+};
+
+struct DLDataType {
+  uint8_t code;
+  uint8_t bits;
+  uint16_t lanes;
+};
+
+struct DLTensor {
+  void* data;
+  DLDevice device;
+  int32_t ndim;
+  DLDataType dtype;
+  int64_t* shape;
+  int64_t* strides;
+  uint64_t byte_offset;
+};
+
+struct DLManagedTensor {
+  DLTensor dl_tensor;
+  void* manager_ctx;
+  void (*deleter)(DLManagedTensor* self);
+};
+
+struct DLPackCapsuleWrapper {
+  DLManagedTensor* tensor;
+  bool consumed;
+
+  DLPackCapsuleWrapper() : tensor(nullptr), consumed(false) {}
+};
+
 static void dtype_free(void* ptr) {
   delete static_cast<DtypeWrapper*>(ptr);
 }
@@ -134,11 +280,32 @@ static const rb_data_type_t dtype_data_type = {
 };
 
 static void array_free(void* ptr) {
-  delete static_cast<ArrayWrapper*>(ptr);
+  auto* wrapper = static_cast<ArrayWrapper*>(ptr);
+  if (wrapper->scope != nullptr) {
+    wrapper->scope->tracked.erase(wrapper);
+  }
+  if (wrapper->reported_bytes > 0) {
+    rb_gc_adjust_memory_usage(-static_cast<ssize_t>(wrapper->reported_bytes));
+  }
+  delete wrapper;
 }
 
-static size_t array_memsize(const void*) {
-  return sizeof(ArrayWrapper);
+// Views that share a buffer are each charged their full nbytes; that
+// overstates memory, which only makes collection more eager.
+static size_t array_memsize(const void* ptr) {
+  const auto* wrapper = static_cast<const ArrayWrapper*>(ptr);
+  return sizeof(ArrayWrapper) + wrapper->array.nbytes();
+}
+
+// Keeps Ruby's malloc accounting in step with the buffer the wrapper pins,
+// so large arrays raise GC pressure in proportion to their size.
+static void array_wrapper_account(ArrayWrapper* wrapper) {
+  const size_t nbytes = wrapper->array.nbytes();
+  if (nbytes != wrapper->reported_bytes) {
+    rb_gc_adjust_memory_usage(
+        static_cast<ssize_t>(nbytes) - static_cast<ssize_t>(wrapper->reported_bytes));
+    wrapper->reported_bytes = nbytes;
+  }
 }
 
 static const rb_data_type_t array_data_type = {
@@ -149,6 +316,48 @@ static const rb_data_type_t array_data_type = {
     RUBY_TYPED_FREE_IMMEDIATELY,
 };
 
+static void array_scope_track(ArrayWrapper* wrapper) {
+  ArrayScope* scope = current_array_scope();
+  if (scope != nullptr) {
+    wrapper->scope = scope;
+    scope->tracked.insert(wrapper);
+  }
+}
+
+// Hands a wrapper to the enclosing scope, or untracks it at the outermost
+// level, so it survives the exit of the scope that created it.
+static void array_scope_keep(ArrayWrapper* wrapper) {
+  ArrayScope* scope = wrapper->scope;
+  if (scope == nullptr || scope != current_array_scope()) {
+    return;
+  }
+  scope->tracked.erase(wrapper);
+  wrapper->scope = scope->parent;
+  if (scope->parent != nullptr) {
+    scope->parent->tracked.insert(wrapper);
+  }
+}
+
+static void array_wrapper_release(ArrayWrapper* wrapper) {
+  wrapper->array = mx::array(0.0f);
+  wrapper->released = true;
+  wrapper->scope = nullptr;
+  if (wrapper->reported_bytes > 0) {
+    rb_gc_adjust_memory_usage(-static_cast<ssize_t>(wrapper->reported_bytes));
+    wrapper->reported_bytes = 0;
+  }
+}
+
+// Wrappers released by MLX::Core.scope hold only a placeholder array.
+static ArrayWrapper* array_wrapper_get(VALUE object) {
+  ArrayWrapper* wrapper = nullptr;
+  TypedData_Get_Struct(object, ArrayWrapper, &array_data_type, wrapper);
+  if (wrapper->released) {
+    rb_raise(rb_eRuntimeError, "MLX::Core::Array was released when its scope exited");
+  }
+  return wrapper;
+}
+
 static void device_free(void* ptr) {
   delete static_cast<DeviceWrapper*>(ptr);
 }
@@ -266,8 +475,29 @@ static const rb_data_type_t kernel_data_type = {
     RUBY_TYPED_FREE_IMMEDIATELY,
 };
 
+static void dlpack_capsule_free(void* ptr) {
+  auto* wrapper = static_cast<DLPackCapsuleWrapper*>(ptr);
+  if (wrapper != nullptr && wrapper->tensor != nullptr && !wrapper->consumed &&
+      wrapper->tensor->deleter != nullptr) {
+    wrapper->tensor->deleter(wrapper->tensor);
+  }
+  delete wrapper;
+}
+
+static size_t dlpack_capsule_memsize(const void*) {
+  return sizeof(DLPackCapsuleWrapper);
+}
+
+static const rb_data_type_t dlpack_capsule_data_type = {
+    "MLX::Core::DLPackCapsule",
+    {nullptr, dlpack_capsule_free, dlpack_capsule_memsize, nullptr, nullptr},
+    nullptr,
+    nullptr,
+    RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
 // Forward declarations for helpers with mutually dependent ordering.
-static VALUE array_wrap(const mx::array& array);
+static VALUE array_wrap(mx::array array);
 static mx::array array_unwrap(VALUE object);
 static std::unordered_map<std::string, mx::array> array_map_from_ruby_hash(VALUE value);
 
@@ -582,101 +812,275 @@ static bool is_numeric_scalar(VALUE value) {
       RB_TYPE_P(value, T_TRUE) || RB_TYPE_P(value, T_FALSE);
 }
 
+// Scalar operands of binary ops are small constants that recur on every
+// step (`x * 2`, `x + 0.5`), so the arrays built for them are kept in a
+// bounded cache keyed by dtype and value bits.
+struct ScalarConstantKey {
+  int dtype;
+  int kind;
+  uint64_t bits;
+
+  bool operator==(const ScalarConstantKey& other) const {
+    return dtype == other.dtype && kind == other.kind && bits == other.bits;
+  }
+};
+
+struct ScalarConstantKeyHash {
+  size_t operator()(const ScalarConstantKey& key) const {
+    return std::hash<uint64_t>{}(key.bits) ^ (static_cast<size_t>(key.dtype) << 8) ^
+        static_cast<size_t>(key.kind);
+  }
+};
+
+static constexpr size_t kScalarConstantCacheLimit = 256;
+
+static std::unordered_map<ScalarConstantKey, mx::array, ScalarConstantKeyHash>& scalar_constant_cache() {
+  static std::unordered_map<ScalarConstantKey, mx::array, ScalarConstantKeyHash> cache;
+  return cache;
+}
+
 template <typename T>
-static T scalar_value_from_ruby(VALUE value) {
+static mx::array cached_scalar_constant(int kind, T value, const mx::Dtype& dtype) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(value));
+  const ScalarConstantKey key{static_cast<int>(dtype.val()), kind, bits};
+  auto& cache = scalar_constant_cache();
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  if (cache.size() >= kScalarConstantCacheLimit) {
+    cache.clear();
+  }
+  return cache.emplace(key, mx::array(value, dtype)).first->second;
+}
+
+// Python MLX weak-scalar rule for a Ruby scalar combined with an array: the
+// scalar adopts the array's dtype instead of promoting it. Only integers
+// outside the int32 range widen a narrower integer dtype to int64; smaller
+// out-of-range values wrap (int8 + 300), as in Python MLX. Integers paired
+// with bool_ become int32, and floats paired with non-floating arrays
+// become float32.
+static mx::array weak_scalar_array(VALUE value, const mx::Dtype& dtype) {
+  if (RB_TYPE_P(value, T_TRUE) || RB_TYPE_P(value, T_FALSE)) {
+    return cached_scalar_constant(0, value == Qtrue, mx::bool_);
+  }
   if (RB_INTEGER_TYPE_P(value)) {
-    return static_cast<T>(NUM2LL(value));
+    const int64_t integer = static_cast<int64_t>(NUM2LL(value));
+    mx::Dtype out = dtype == mx::bool_ ? mx::int32 : dtype;
+    if (mx::issubdtype(out, mx::integer) && out.size() < 8 &&
+        (integer > std::numeric_limits<int32_t>::max() || integer < std::numeric_limits<int32_t>::min())) {
+      out = mx::int64;
+    }
+    return cached_scalar_constant(1, integer, out);
+  }
+  return cached_scalar_constant(
+      2, static_cast<double>(NUM2DBL(value)), mx::issubdtype(dtype, mx::inexact) ? dtype : mx::float32);
+}
+
+struct BinaryOperands {
+  mx::array lhs;
+  mx::array rhs;
+};
+
+// Converts the operands of a binary op. When exactly one side is an MLX
+// array, a Ruby scalar on the other side is weakly typed; everything else
+// converts as MLX::Core.array would.
+static BinaryOperands binary_operands(VALUE a, VALUE b) {
+  const bool a_array = rb_obj_is_kind_of(a, cArray);
+  const bool b_array = rb_obj_is_kind_of(b, cArray);
+  if (a_array && !b_array && is_numeric_scalar(b)) {
+    const mx::array& lhs = array_wrapper_get(a)->array;
+    return {lhs, weak_scalar_array(b, lhs.dtype())};
+  }
+  if (b_array && !a_array && is_numeric_scalar(a)) {
+    const mx::array& rhs = array_wrapper_get(b)->array;
+    return {weak_scalar_array(a, rhs.dtype()), rhs};
+  }
+  return {array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)};
+}
+
+// Byte size of a host buffer for `shape`/`dtype`. Shapes may come from
+// untrusted file headers, so negative dimensions and size_t overflow are
+// rejected instead of wrapping.
+static size_t checked_byte_count(const mx::Shape& shape, const mx::Dtype& dtype) {
+  size_t count = static_cast<size_t>(dtype.size());
+  for (auto dim : shape) {
+    if (dim < 0) {
+      throw std::invalid_argument("array dimensions must be non-negative, got " + std::to_string(dim));
+    }
+    if (__builtin_mul_overflow(count, static_cast<size_t>(dim), &count)) {
+      throw std::invalid_argument("array byte size overflows size_t");
+    }
+  }
+  return count;
+}
+
+// Allocates an MLX-owned buffer and lets `fill` write the raw element bytes
+// into it, so host data lands in the array storage with a single copy.
+template <typename Fill>
+static mx::array array_from_host_fill(const mx::Shape& shape, const mx::Dtype& dtype, Fill&& fill) {
+  const size_t nbytes = checked_byte_count(shape, dtype);
+  if (nbytes == 0) {
+    return mx::zeros(shape, dtype);
+  }
+  auto buffer = mx::allocator::malloc(nbytes);
+  try {
+    fill(buffer.raw_ptr(), nbytes);
+  } catch (...) {
+    mx::allocator::free(buffer);
+    throw;
+  }
+  return mx::array(std::move(buffer), shape, dtype);
+}
+
+// Only the first element at each depth is visited; the fill pass checks
+// every other row against this shape before writing into it.
+static mx::Shape nested_array_shape(VALUE value) {
+  mx::Shape shape;
+  while (RB_TYPE_P(value, T_ARRAY)) {
+    const long len = RARRAY_LEN(value);
+    shape.push_back(static_cast<mx::ShapeElem>(len));
+    if (len == 0) {
+      break;
+    }
+    value = RARRAY_AREF(value, 0);
+  }
+  return shape;
+}
+
+template <typename T>
+static T nested_scalar_cast(VALUE value) {
+  if (FIXNUM_P(value)) {
+    return static_cast<T>(FIX2LONG(value));
   }
   if (RB_FLOAT_TYPE_P(value)) {
-    return static_cast<T>(NUM2DBL(value));
+    return static_cast<T>(RFLOAT_VALUE(value));
   }
-  if (RB_TYPE_P(value, T_TRUE) || RB_TYPE_P(value, T_FALSE)) {
-    return static_cast<T>(value == Qtrue ? 1.0 : 0.0);
+  if (value == Qtrue || value == Qfalse) {
+    return static_cast<T>(value == Qtrue ? 1 : 0);
+  }
+  if (RB_INTEGER_TYPE_P(value)) {
+    if constexpr (std::is_same_v<T, uint64_t>) {
+      return static_cast<T>(NUM2ULL(value));
+    } else {
+      return static_cast<T>(NUM2LL(value));
+    }
   }
-  rb_raise(rb_eTypeError, "expected numeric/boolean scalar");
+  rb_raise(rb_eTypeError, "nested arrays must contain only numeric/boolean scalars");
   return static_cast<T>(0);
 }
 
 template <typename T>
-static void infer_shape_and_flatten_typed(
-    VALUE value,
-    size_t depth,
-    mx::Shape& shape,
-    std::vector<T>& flat) {
+struct NestedFill {
+  VALUE root;
+  const mx::Shape* shape;
+  T* cursor;
+};
+
+template <typename T>
+static void nested_fill_typed(VALUE value, size_t depth, NestedFill<T>& fill) {
+  const mx::Shape& shape = *fill.shape;
   if (RB_TYPE_P(value, T_ARRAY)) {
+    if (depth >= shape.size()) {
+      rb_raise(rb_eArgError, "inconsistent nested array depth");
+    }
     const long len = RARRAY_LEN(value);
-    if (shape.size() == depth) {
-      shape.push_back(static_cast<mx::ShapeElem>(len));
-    } else if (shape[depth] != len) {
+    if (shape[depth] != len) {
       rb_raise(rb_eArgError, "ragged array input is not supported");
     }
-
-    if (shape.size() > depth + 1) {
-      size_t subtree_size = 1;
-      for (size_t i = depth + 1; i < shape.size(); ++i) {
-        subtree_size *= static_cast<size_t>(shape[i]);
+    if (depth + 1 == shape.size()) {
+      for (long i = 0; i < len; ++i) {
+        VALUE item = RARRAY_AREF(value, i);
+        if (RB_TYPE_P(item, T_ARRAY)) {
+          rb_raise(rb_eArgError, "inconsistent nested array depth");
+        }
+        *fill.cursor++ = nested_scalar_cast<T>(item);
       }
-      flat.reserve(flat.size() + static_cast<size_t>(len) * subtree_size);
+      return;
     }
-
     for (long i = 0; i < len; ++i) {
-      infer_shape_and_flatten_typed<T>(rb_ary_entry(value, i), depth + 1, shape, flat);
+      nested_fill_typed<T>(RARRAY_AREF(value, i), depth + 1, fill);
     }
     return;
   }
+  rb_raise(rb_eArgError, "inconsistent nested array depth");
+}
 
-  if (!is_numeric_scalar(value)) {
-    rb_raise(rb_eTypeError, "nested arrays must contain only numeric/boolean scalars");
-  }
-  if (shape.size() != depth) {
-    rb_raise(rb_eArgError, "inconsistent nested array depth");
-  }
-  flat.push_back(scalar_value_from_ruby<T>(value));
+template <typename T>
+static VALUE nested_fill_protected(VALUE arg) {
+  auto* fill = reinterpret_cast<NestedFill<T>*>(arg);
+  nested_fill_typed<T>(fill->root, 0, *fill);
+  return Qnil;
 }
 
-static void infer_shape_and_flatten(
-    VALUE value,
-    size_t depth,
-    mx::Shape& shape,
-    std::vector<double>& flat) {
-  infer_shape_and_flatten_typed<double>(value, depth, shape, flat);
+// Writes the nested Ruby array straight into an MLX buffer of the target
+// element type. Errors raised mid-fill release the buffer before
+// propagating.
+template <typename T>
+static mx::array nested_array_typed(VALUE value, const mx::Shape& shape, const mx::Dtype& dtype) {
+  if (checked_byte_count(shape, dtype) == 0) {
+    // Empty results skip the fill, so walk the rows here to still reject
+    // ragged input such as [[], [1, 2]]. No element is ever written.
+    NestedFill<T> fill{value, &shape, nullptr};
+    nested_fill_typed<T>(value, 0, fill);
+    return mx::zeros(shape, dtype);
+  }
+  int state = 0;
+  {
+    auto out = array_from_host_fill(shape, dtype, [&](void* dst, size_t) {
+      NestedFill<T> fill{value, &shape, static_cast<T*>(dst)};
+      rb_protect(nested_fill_protected<T>, reinterpret_cast<VALUE>(&fill), &state);
+    });
+    if (state == 0) {
+      return out;
+    }
+  }
+  rb_jump_tag(state);
+  return mx::array(0.0f);
 }
 
 static mx::array tensor_array_from_ruby(VALUE value, const std::optional<mx::Dtype>& dtype) {
-  mx::Dtype target_dtype = dtype.value_or(mx::float32);
-  mx::Dtype build_dtype = target_dtype;
+  const mx::Dtype target_dtype = dtype.value_or(mx::float32);
+  const mx::Shape shape = nested_array_shape(value);
 
-  // MLX does not support float64 on GPU. Build with float32 and cast only
-  // when a different target dtype was explicitly requested.
-  if (build_dtype == mx::float64) {
-    build_dtype = mx::float32;
-  }
-
-  if (build_dtype == mx::float32) {
-    mx::Shape shape;
-    std::vector<float> data;
-    infer_shape_and_flatten_typed<float>(value, 0, shape, data);
-    mx::array a(data.begin(), shape, build_dtype);
-    if (target_dtype != build_dtype) {
-      a = mx::astype(std::move(a), target_dtype);
-    }
-    return a;
-  } else {
-    mx::Shape shape;
-    std::vector<double> data;
-    infer_shape_and_flatten(value, 0, shape, data);
-    mx::array a(data.begin(), shape, build_dtype);
-    if (target_dtype != build_dtype) {
-      a = mx::astype(std::move(a), target_dtype);
-    }
-    return a;
+  switch (target_dtype.val()) {
+    case mx::Dtype::Val::bool_:
+      return nested_array_typed<bool>(value, shape, target_dtype);
+    case mx::Dtype::Val::uint8:
+      return nested_array_typed<uint8_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::uint16:
+      return nested_array_typed<uint16_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::uint32:
+      return nested_array_typed<uint32_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::uint64:
+      return nested_array_typed<uint64_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::int8:
+      return nested_array_typed<int8_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::int16:
+      return nested_array_typed<int16_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::int32:
+      return nested_array_typed<int32_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::int64:
+      return nested_array_typed<int64_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::float16:
+      return nested_array_typed<mx::float16_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::bfloat16:
+      return nested_array_typed<mx::bfloat16_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::complex64:
+      return nested_array_typed<mx::complex64_t>(value, shape, target_dtype);
+    case mx::Dtype::Val::float64:
+      // MLX does not support float64 on GPU. Build with float32 and cast
+      // only because float64 was explicitly requested.
+      return mx::astype(nested_array_typed<float>(value, shape, mx::float32), target_dtype);
+    default:
+      return nested_array_typed<float>(value, shape, mx::float32);
   }
 }
 
 static mx::array array_from_ruby(VALUE value, const std::optional<mx::Dtype>& dtype) {
   if (rb_obj_is_kind_of(value, cArray)) {
-    ArrayWrapper* wrapper = nullptr;
-    TypedData_Get_Struct(value, ArrayWrapper, &array_data_type, wrapper);
+    ArrayWrapper* wrapper = array_wrapper_get(value);
     return cast_if_needed(wrapper->array, dtype);
   }
   if (RB_TYPE_P(value, T_ARRAY)) {
@@ -685,10 +1089,84 @@ static mx::array array_from_ruby(VALUE value, const std::optional<mx::Dtype>& dt
   return scalar_array_from_ruby(value, dtype);
 }
 
-static VALUE array_wrap(const mx::array& array) {
-  auto* wrapper = new ArrayWrapper();
-  wrapper->array = array;
-  return TypedData_Wrap_Struct(cArray, &array_data_type, wrapper);
+struct NestedLeafKinds {
+  bool integers = true;
+  bool booleans = true;
+  bool wide = false;
+};
+
+static void nested_leaf_kinds(VALUE value, NestedLeafKinds& kinds) {
+  const long len = RARRAY_LEN(value);
+  for (long i = 0; i < len && (kinds.integers || kinds.booleans); ++i) {
+    VALUE item = RARRAY_AREF(value, i);
+    if (RB_TYPE_P(item, T_ARRAY)) {
+      nested_leaf_kinds(item, kinds);
+      continue;
+    }
+    const bool integer = RB_INTEGER_TYPE_P(item);
+    kinds.integers = kinds.integers && integer;
+    kinds.booleans = kinds.booleans && (item == Qtrue || item == Qfalse);
+    if (integer && !kinds.wide) {
+      const long long v = NUM2LL(item);
+      kinds.wide = v < std::numeric_limits<int32_t>::min() || v > std::numeric_limits<int32_t>::max();
+    }
+  }
+}
+
+// Plain Ruby lists used as indices or ids keep their element kind instead
+// of the float32 default: all-Integer leaves become int32 (int64 when a
+// value does not fit) and all-boolean leaves become bool_.
+static mx::array array_from_ruby_list(VALUE value) {
+  NestedLeafKinds kinds;
+  nested_leaf_kinds(value, kinds);
+  if (kinds.integers && kinds.booleans) {
+    return tensor_array_from_ruby(value, std::nullopt);
+  }
+  if (kinds.integers) {
+    return tensor_array_from_ruby(value, kinds.wide ? mx::int64 : mx::int32);
+  }
+  if (kinds.booleans) {
+    return tensor_array_from_ruby(value, mx::bool_);
+  }
+  return tensor_array_from_ruby(value, std::nullopt);
+}
+
+// Optional policy that starts a GC once MLX active memory crosses
+// `fraction` of the memory limit. After each triggered collection the next
+// one waits until active memory grows by another 1/16 of the limit, so a
+// working set that legitimately sits above the threshold does not cause a
+// GC on every wrap.
+struct GcMemoryPolicy {
+  double fraction = 0.0;
+  size_t next_trigger = 0;
+};
+
+static GcMemoryPolicy gc_memory_policy;
+
+static void maybe_start_gc_for_memory_pressure() {
+  if (gc_memory_policy.fraction <= 0.0) {
+    return;
+  }
+  const size_t limit = mx::get_memory_limit();
+  if (limit == 0) {
+    return;
+  }
+  const size_t threshold = static_cast<size_t>(static_cast<double>(limit) * gc_memory_policy.fraction);
+  const size_t active = mx::get_active_memory();
+  if (active < threshold || active < gc_memory_policy.next_trigger) {
+    return;
+  }
+  rb_gc_start();
+  gc_memory_policy.next_trigger = mx::get_active_memory() + limit / 16;
+}
+
+static VALUE array_wrap(mx::array array) {
+  maybe_start_gc_for_memory_pressure();
+  auto* wrapper = new ArrayWrapper(std::move(array));
+  array_wrapper_account(wrapper);
+  VALUE object = TypedData_Wrap_Struct(cArray, &array_data_type, wrapper);
+  array_scope_track(wrapper);
+  return object;
 }
 
 static mx::array array_unwrap(VALUE object) {
@@ -696,8 +1174,7 @@ static mx::array array_unwrap(VALUE object) {
     rb_raise(rb_eTypeError, "expected MLX::Core::Array");
   }
 
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(object, ArrayWrapper, &array_data_type, wrapper);
+  ArrayWrapper* wrapper = array_wrapper_get(object);
   return wrapper->array;
 }
 
@@ -1181,81 +1658,66 @@ static void rethrow_captured_exception(const std::exception_ptr& error) {
   }
 }
 
+// Which kind of work a binding entry point performs. Graph construction is
+// microsecond-scale and keeps the GVL by default; evaluation and file I/O
+// block and release it so other Ruby threads can run.
+enum class GvlWork : size_t { Graph = 0, Eval = 1, IO = 2 };
+
+struct GvlPolicy {
+  static constexpr size_t kKinds = 3;
+  bool release[kKinds] = {false, true, true};
+  uint64_t held_calls[kKinds] = {0, 0, 0};
+  uint64_t released_calls[kKinds] = {0, 0, 0};
+  uint64_t released_ns[kKinds] = {0, 0, 0};
+};
+
+static GvlPolicy gvl_policy;
+
+// Runs `fn` with or without the GVL according to gvl_policy. C++ exceptions
+// thrown without the GVL are carried back and rethrown once it is held
+// again; time spent unlocked is accumulated per kind of work.
 template <typename Fn>
-static mx::array call_mx_array_without_gvl(Fn&& fn) {
-  using FnType = std::decay_t<Fn>;
+static std::invoke_result_t<Fn&> call_with_gvl_policy(GvlWork work, Fn&& fn) {
+  using Result = std::invoke_result_t<Fn&>;
+  using Storage = std::conditional_t<std::is_void_v<Result>, std::monostate, std::optional<Result>>;
+  const auto kind = static_cast<size_t>(work);
+  if (!gvl_policy.release[kind]) {
+    gvl_policy.held_calls[kind]++;
+    return fn();
+  }
+
   struct Payload {
-    FnType* fn;
-    mx::array output;
+    std::remove_reference_t<Fn>* fn;
+    Storage output;
     std::exception_ptr error;
+    uint64_t elapsed_ns;
   };
   auto call_without_gvl = [](void* arg) -> void* {
     auto* payload = reinterpret_cast<Payload*>(arg);
+    const auto start = std::chrono::steady_clock::now();
     try {
-      payload->output = (*payload->fn)();
+      if constexpr (std::is_void_v<Result>) {
+        (*payload->fn)();
+      } else {
+        payload->output.emplace((*payload->fn)());
+      }
     } catch (...) {
       payload->error = std::current_exception();
     }
+    payload->elapsed_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+            .count());
     return nullptr;
   };
 
-  FnType fn_local = std::forward<Fn>(fn);
-  Payload payload{&fn_local, mx::array(0.0f), nullptr};
+  Payload payload{&fn, Storage{}, nullptr, 0};
   rb_thread_call_without_gvl(call_without_gvl, &payload, RUBY_UBF_IO, nullptr);
+  gvl_policy.released_calls[kind]++;
+  gvl_policy.released_ns[kind] += payload.elapsed_ns;
   rethrow_captured_exception(payload.error);
-  return payload.output;
-}
-
-struct FunctionVectorCallPayload {
-  FunctionWrapper* wrapper;
-  const std::vector<mx::array>* inputs;
-  std::vector<mx::array>* outputs;
-  std::exception_ptr error;
-};
-
-static void* function_vector_call_without_gvl(void* arg) {
-  auto* payload = reinterpret_cast<FunctionVectorCallPayload*>(arg);
-  try {
-    *payload->outputs = payload->wrapper->vector_fn(*payload->inputs);
-  } catch (...) {
-    payload->error = std::current_exception();
-  }
-  return nullptr;
-}
-
-struct FunctionArgsKwCallPayload {
-  FunctionWrapper* wrapper;
-  const mx::Args* args;
-  const mx::Kwargs* kwargs;
-  std::vector<mx::array>* outputs;
-  std::exception_ptr error;
-};
-
-static void* function_args_kwargs_call_without_gvl(void* arg) {
-  auto* payload = reinterpret_cast<FunctionArgsKwCallPayload*>(arg);
-  try {
-    *payload->outputs = payload->wrapper->args_kwargs_fn(*payload->args, *payload->kwargs);
-  } catch (...) {
-    payload->error = std::current_exception();
-  }
-  return nullptr;
-}
-
-struct FunctionValueGradCallPayload {
-  FunctionWrapper* wrapper;
-  const std::vector<mx::array>* inputs;
-  std::pair<std::vector<mx::array>, std::vector<mx::array>>* outputs;
-  std::exception_ptr error;
-};
-
-static void* function_value_grad_call_without_gvl(void* arg) {
-  auto* payload = reinterpret_cast<FunctionValueGradCallPayload*>(arg);
-  try {
-    *payload->outputs = payload->wrapper->value_grad_fn(*payload->inputs);
-  } catch (...) {
-    payload->error = std::current_exception();
+  if constexpr (!std::is_void_v<Result>) {
+    return std::move(*payload.output);
   }
-  return nullptr;
 }
 
 static VALUE function_call(int argc, VALUE* argv, VALUE self) {
@@ -1282,13 +1744,7 @@ static VALUE function_call(int argc, VALUE* argv, VALUE self) {
       mx::Kwargs kwargs = NIL_P(kwargs_hash) ? mx::Kwargs{} : array_map_from_ruby_hash(kwargs_hash);
       std::vector<mx::array> outputs;
       if (wrapper->release_gvl) {
-        FunctionArgsKwCallPayload payload{wrapper, &args, &kwargs, &outputs, nullptr};
-        rb_thread_call_without_gvl(
-            function_args_kwargs_call_without_gvl,
-            &payload,
-            RUBY_UBF_IO,
-            nullptr);
-        rethrow_captured_exception(payload.error);
+        outputs = call_with_gvl_policy(GvlWork::Eval, [&]() { return wrapper->args_kwargs_fn(args, kwargs); });
       } else {
         outputs = wrapper->args_kwargs_fn(args, kwargs);
       }
@@ -1307,13 +1763,7 @@ static VALUE function_call(int argc, VALUE* argv, VALUE self) {
     if (wrapper->returns_value_and_grad) {
       std::pair<std::vector<mx::array>, std::vector<mx::array>> result;
       if (wrapper->release_gvl) {
-        FunctionValueGradCallPayload payload{wrapper, &inputs, &result, nullptr};
-        rb_thread_call_without_gvl(
-            function_value_grad_call_without_gvl,
-            &payload,
-            RUBY_UBF_IO,
-            nullptr);
-        rethrow_captured_exception(payload.error);
+        result = call_with_gvl_policy(GvlWork::Eval, [&]() { return wrapper->value_grad_fn(inputs); });
       } else {
         result = wrapper->value_grad_fn(inputs);
       }
@@ -1325,13 +1775,7 @@ static VALUE function_call(int argc, VALUE* argv, VALUE self) {
 
     std::vector<mx::array> outputs;
     if (wrapper->release_gvl) {
-      FunctionVectorCallPayload payload{wrapper, &inputs, &outputs, nullptr};
-      rb_thread_call_without_gvl(
-          function_vector_call_without_gvl,
-          &payload,
-          RUBY_UBF_IO,
-          nullptr);
-      rethrow_captured_exception(payload.error);
+      outputs = call_with_gvl_policy(GvlWork::Eval, [&]() { return wrapper->vector_fn(inputs); });
     } else {
       outputs = wrapper->vector_fn(inputs);
     }
@@ -2016,7 +2460,9 @@ static VALUE group_to_s(VALUE self) {
 
 static VALUE array_alloc(VALUE klass) {
   auto* wrapper = new ArrayWrapper();
-  return TypedData_Wrap_Struct(klass, &array_data_type, wrapper);
+  VALUE object = TypedData_Wrap_Struct(klass, &array_data_type, wrapper);
+  array_scope_track(wrapper);
+  return object;
 }
 
 static VALUE array_initialize(int argc, VALUE* argv, VALUE self) {
@@ -2028,6 +2474,7 @@ static VALUE array_initialize(int argc, VALUE* argv, VALUE self) {
     ArrayWrapper* wrapper = nullptr;
     TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
     wrapper->array = array_from_ruby(value, optional_dtype_from_value(dtype));
+    array_wrapper_account(wrapper);
     return self;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -2036,20 +2483,17 @@ static VALUE array_initialize(int argc, VALUE* argv, VALUE self) {
 }
 
 static VALUE array_ndim(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
+  ArrayWrapper* wrapper = array_wrapper_get(self);
   return INT2NUM(static_cast<int>(wrapper->array.ndim()));
 }
 
 static VALUE array_size(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
+  ArrayWrapper* wrapper = array_wrapper_get(self);
   return ULL2NUM(static_cast<unsigned long long>(wrapper->array.size()));
 }
 
 static VALUE array_shape(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
+  ArrayWrapper* wrapper = array_wrapper_get(self);
 
   VALUE shape = rb_ary_new_capa(static_cast<long>(wrapper->array.ndim()));
   for (auto dim : wrapper->array.shape()) {
@@ -2059,8 +2503,7 @@ static VALUE array_shape(VALUE self) {
 }
 
 static VALUE array_dtype(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
+  ArrayWrapper* wrapper = array_wrapper_get(self);
   return dtype_wrap(wrapper->array.dtype());
 }
 
@@ -2099,8 +2542,7 @@ static VALUE ruby_scalar_from_array(const mx::array& array) {
 }
 
 static VALUE array_item(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
+  ArrayWrapper* wrapper = array_wrapper_get(self);
   if (wrapper->array.size() != 1) {
     rb_raise(rb_eRuntimeError, "item is only available for size-1 arrays");
   }
@@ -2136,190 +2578,69 @@ static VALUE build_flat_ruby_array(size_t size, ValueAt value_at) {
   return out;
 }
 
-static VALUE array_to_a(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
-
-  if (wrapper->array.ndim() == 0) {
-    wrapper->array.eval();
-    return ruby_scalar_from_array(wrapper->array);
-  }
-
-  if (wrapper->array.ndim() == 1) {
-    wrapper->array.eval();
-    const size_t size = wrapper->array.size();
-    switch (wrapper->array.dtype()) {
-      case mx::bool_: {
-        const bool* data = wrapper->array.data<bool>();
-        return build_flat_ruby_array(size, [&](size_t i) { return data[i] ? Qtrue : Qfalse; });
-      }
-      case mx::uint8: {
-        const uint8_t* data = wrapper->array.data<uint8_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return UINT2NUM(data[i]); });
-      }
-      case mx::uint16: {
-        const uint16_t* data = wrapper->array.data<uint16_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return UINT2NUM(data[i]); });
-      }
-      case mx::uint32: {
-        const uint32_t* data = wrapper->array.data<uint32_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return UINT2NUM(data[i]); });
-      }
-      case mx::uint64: {
-        const uint64_t* data = wrapper->array.data<uint64_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return ULL2NUM(data[i]); });
-      }
-      case mx::int8: {
-        const int8_t* data = wrapper->array.data<int8_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return INT2NUM(data[i]); });
-      }
-      case mx::int16: {
-        const int16_t* data = wrapper->array.data<int16_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return INT2NUM(data[i]); });
-      }
-      case mx::int32: {
-        const int32_t* data = wrapper->array.data<int32_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return INT2NUM(data[i]); });
-      }
-      case mx::int64: {
-        const int64_t* data = wrapper->array.data<int64_t>();
-        return build_flat_ruby_array(size, [&](size_t i) { return LL2NUM(data[i]); });
-      }
-      case mx::float16: {
-        const mx::float16_t* data = wrapper->array.data<mx::float16_t>();
-        return build_flat_ruby_array(
-            size, [&](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
-      }
-      case mx::bfloat16: {
-        const mx::bfloat16_t* data = wrapper->array.data<mx::bfloat16_t>();
-        return build_flat_ruby_array(
-            size, [&](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
-      }
-      case mx::float32: {
-        const float* data = wrapper->array.data<float>();
-        return build_flat_ruby_array(
-            size, [&](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
-      }
-      case mx::float64: {
-        const double* data = wrapper->array.data<double>();
-        return build_flat_ruby_array(size, [&](size_t i) { return DBL2NUM(data[i]); });
-      }
-      default:
-        rb_raise(rb_eTypeError, "to_a unsupported for current dtype in this phase");
-        return Qnil;
+// Evaluates with the GVL released and returns a row-contiguous array whose
+// elements can be read directly. float16/bfloat16 are widened to float32 by
+// one vectorized cast here, before any Ruby objects are created.
+static mx::array host_array_for_ruby(const mx::array& array) {
+  return call_with_gvl_policy(GvlWork::Eval, [host = array]() mutable {
+    if (host.dtype() == mx::float16 || host.dtype() == mx::bfloat16) {
+      host = mx::astype(host, mx::float32);
     }
-  }
-
-  const mx::Shape shape = wrapper->array.shape();
-  mx::array flat = mx::reshape(
-      wrapper->array, mx::Shape{static_cast<mx::ShapeElem>(wrapper->array.size())});
-  flat.eval();
+    host.eval();
+    if (!host.flags().row_contiguous) {
+      host = mx::contiguous(host);
+      host.eval();
+    }
+    return host;
+  });
+}
 
-  size_t idx = 0;
-  switch (flat.dtype()) {
+template <typename Visit>
+static VALUE visit_host_elements(const mx::array& host, Visit&& visit) {
+  switch (host.dtype()) {
     case mx::bool_: {
-      const bool* data = flat.data<bool>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return data[i] ? Qtrue : Qfalse; });
+      const bool* data = host.data<bool>();
+      return visit([data](size_t i) { return data[i] ? Qtrue : Qfalse; });
     }
     case mx::uint8: {
-      const uint8_t* data = flat.data<uint8_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return UINT2NUM(data[i]); });
+      const uint8_t* data = host.data<uint8_t>();
+      return visit([data](size_t i) { return UINT2NUM(data[i]); });
     }
     case mx::uint16: {
-      const uint16_t* data = flat.data<uint16_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return UINT2NUM(data[i]); });
+      const uint16_t* data = host.data<uint16_t>();
+      return visit([data](size_t i) { return UINT2NUM(data[i]); });
     }
     case mx::uint32: {
-      const uint32_t* data = flat.data<uint32_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return UINT2NUM(data[i]); });
+      const uint32_t* data = host.data<uint32_t>();
+      return visit([data](size_t i) { return UINT2NUM(data[i]); });
     }
     case mx::uint64: {
-      const uint64_t* data = flat.data<uint64_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return ULL2NUM(data[i]); });
+      const uint64_t* data = host.data<uint64_t>();
+      return visit([data](size_t i) { return ULL2NUM(data[i]); });
     }
     case mx::int8: {
-      const int8_t* data = flat.data<int8_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return INT2NUM(data[i]); });
+      const int8_t* data = host.data<int8_t>();
+      return visit([data](size_t i) { return INT2NUM(data[i]); });
     }
     case mx::int16: {
-      const int16_t* data = flat.data<int16_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return INT2NUM(data[i]); });
+      const int16_t* data = host.data<int16_t>();
+      return visit([data](size_t i) { return INT2NUM(data[i]); });
     }
     case mx::int32: {
-      const int32_t* data = flat.data<int32_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return INT2NUM(data[i]); });
+      const int32_t* data = host.data<int32_t>();
+      return visit([data](size_t i) { return INT2NUM(data[i]); });
     }
     case mx::int64: {
-      const int64_t* data = flat.data<int64_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return LL2NUM(data[i]); });
-    }
-    case mx::float16: {
-      const mx::float16_t* data = flat.data<mx::float16_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
-    }
-    case mx::bfloat16: {
-      const mx::bfloat16_t* data = flat.data<mx::bfloat16_t>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
+      const int64_t* data = host.data<int64_t>();
+      return visit([data](size_t i) { return LL2NUM(data[i]); });
     }
     case mx::float32: {
-      const float* data = flat.data<float>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
+      const float* data = host.data<float>();
+      return visit([data](size_t i) { return DBL2NUM(static_cast<double>(data[i])); });
     }
     case mx::float64: {
-      const double* data = flat.data<double>();
-      return build_nested_ruby_array(
-          shape,
-          0,
-          idx,
-          [&](size_t i) { return DBL2NUM(data[i]); });
+      const double* data = host.data<double>();
+      return visit([data](size_t i) { return DBL2NUM(data[i]); });
     }
     default:
       rb_raise(rb_eTypeError, "to_a unsupported for current dtype in this phase");
@@ -2327,15 +2648,97 @@ static VALUE array_to_a(VALUE self) {
   }
 }
 
-static VALUE array_to_s(VALUE self) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
+static VALUE array_to_a(VALUE self) {
+  ArrayWrapper* wrapper = array_wrapper_get(self);
 
-  std::ostringstream out;
-  out << "#<MLX::Core::Array shape=[";
-  for (size_t i = 0; i < wrapper->array.ndim(); ++i) {
-    if (i > 0) {
-      out << ",";
+  try {
+    const mx::array host = host_array_for_ruby(wrapper->array);
+
+    if (host.ndim() == 0) {
+      return visit_host_elements(host, [](auto value_at) { return value_at(0); });
+    }
+
+    if (host.ndim() == 1) {
+      return visit_host_elements(host, [&](auto value_at) {
+        return build_flat_ruby_array(host.size(), value_at);
+      });
+    }
+
+    return visit_host_elements(host, [&](auto value_at) {
+      size_t idx = 0;
+      return build_nested_ruby_array(host.shape(), 0, idx, value_at);
+    });
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+// Yields rows along the first axis, `slice_size` at a time. The evaluated
+// array is pinned in a Ruby wrapper so only one slice of Ruby objects is
+// alive at once and a break from the block leaks nothing.
+static VALUE array_yield_rows(VALUE self, long slice_size, bool yield_single_rows) {
+  VALUE pinned = Qnil;
+  try {
+    pinned = array_wrap(host_array_for_ruby(array_unwrap(self)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+
+  ArrayWrapper* wrapper = array_wrapper_get(pinned);
+  const mx::array& host = wrapper->array;
+  if (host.ndim() == 0) {
+    rb_raise(rb_eTypeError, "iteration over a 0-d array");
+  }
+
+  const long rows = static_cast<long>(host.shape(0));
+  const size_t row_size = rows == 0 ? 0 : host.size() / static_cast<size_t>(rows);
+  visit_host_elements(host, [&](auto value_at) {
+    auto build_row = [&](long row) {
+      size_t idx = static_cast<size_t>(row) * row_size;
+      return build_nested_ruby_array(host.shape(), 1, idx, value_at);
+    };
+    for (long start = 0; start < rows; start += slice_size) {
+      if (yield_single_rows) {
+        rb_yield(build_row(start));
+        continue;
+      }
+      const long stop = std::min(rows, start + slice_size);
+      VALUE slice = rb_ary_new_capa(stop - start);
+      for (long row = start; row < stop; ++row) {
+        rb_ary_push(slice, build_row(row));
+      }
+      rb_yield(slice);
+    }
+    return Qnil;
+  });
+  RB_GC_GUARD(pinned);
+  return self;
+}
+
+static VALUE array_each_row(VALUE self) {
+  RETURN_ENUMERATOR(self, 0, nullptr);
+  return array_yield_rows(self, 1, true);
+}
+
+static VALUE array_each_slice(VALUE self, VALUE slice_size) {
+  RETURN_ENUMERATOR(self, 1, &slice_size);
+  const long size = NUM2LONG(slice_size);
+  if (size <= 0) {
+    rb_raise(rb_eArgError, "slice size must be positive");
+  }
+  return array_yield_rows(self, size, false);
+}
+
+static VALUE array_to_s(VALUE self) {
+  ArrayWrapper* wrapper = array_wrapper_get(self);
+
+  std::ostringstream out;
+  out << "#<MLX::Core::Array shape=[";
+  for (size_t i = 0; i < wrapper->array.ndim(); ++i) {
+    if (i > 0) {
+      out << ",";
     }
     out << wrapper->array.shape(i);
   }
@@ -2345,823 +2748,2293 @@ static VALUE array_to_s(VALUE self) {
   return rb_utf8_str_new(value.c_str(), static_cast<long>(value.size()));
 }
 
-static VALUE array_binary_op(VALUE self, VALUE other, const std::function<mx::array(mx::array, mx::array)>& op) {
-  ArrayWrapper* wrapper = nullptr;
-  TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
-
-  auto rhs = array_from_ruby(other, std::nullopt);
-  auto out = op(wrapper->array, rhs);
-  return array_wrap(out);
-}
+// MemoryView export keeps an evaluated, row-contiguous reference to the
+// array alive until the consumer releases the view.
+struct ArrayMemoryView {
+  mx::array array;
+  std::vector<ssize_t> shape;
+  std::vector<ssize_t> strides;
+};
 
-static VALUE array_add(VALUE self, VALUE other) {
-  return array_binary_op(self, other, [](mx::array a, mx::array b) { return mx::add(a, b); });
+static const char* memory_view_format(const mx::Dtype& dtype) {
+  switch (dtype.val()) {
+    case mx::Dtype::Val::bool_:
+    case mx::Dtype::Val::uint8:
+      return "C";
+    case mx::Dtype::Val::uint16:
+      return "S";
+    case mx::Dtype::Val::uint32:
+      return "L";
+    case mx::Dtype::Val::uint64:
+      return "Q";
+    case mx::Dtype::Val::int8:
+      return "c";
+    case mx::Dtype::Val::int16:
+      return "s";
+    case mx::Dtype::Val::int32:
+      return "l";
+    case mx::Dtype::Val::int64:
+      return "q";
+    case mx::Dtype::Val::float32:
+      return "f";
+    case mx::Dtype::Val::float64:
+      return "d";
+    case mx::Dtype::Val::complex64:
+      return "ff";
+    // Half-precision types have no pack specifier. Labelling them as
+    // uint16 would let consumers misread the data, so no view is offered.
+    default:
+      return nullptr;
+  }
 }
 
-static VALUE array_subtract(VALUE self, VALUE other) {
-  return array_binary_op(self, other, [](mx::array a, mx::array b) { return mx::subtract(a, b); });
+static bool array_memory_view_available_p(VALUE obj) {
+  return rb_obj_is_kind_of(obj, cArray);
 }
 
-static VALUE array_multiply(VALUE self, VALUE other) {
-  return array_binary_op(self, other, [](mx::array a, mx::array b) { return mx::multiply(a, b); });
-}
+static bool array_memory_view_get(VALUE obj, rb_memory_view_t* view, int flags) {
+  if ((flags & RUBY_MEMORY_VIEW_WRITABLE) != 0) {
+    return false;
+  }
 
-static VALUE array_divide(VALUE self, VALUE other) {
-  return array_binary_op(self, other, [](mx::array a, mx::array b) { return mx::divide(a, b); });
-}
+  ArrayWrapper* wrapper = array_wrapper_get(obj);
+  const char* format = memory_view_format(wrapper->array.dtype());
+  if (format == nullptr) {
+    return false;
+  }
 
-static VALUE array_aref(VALUE self, VALUE index) {
+  ArrayMemoryView* holder = nullptr;
   try {
-    ArrayWrapper* wrapper = nullptr;
-    TypedData_Get_Struct(self, ArrayWrapper, &array_data_type, wrapper);
-
-    if (!RB_INTEGER_TYPE_P(index)) {
-      rb_raise(rb_eTypeError, "index must be an integer in this phase");
-    }
-    if (wrapper->array.ndim() == 0) {
-      rb_raise(rb_eArgError, "cannot index a scalar array");
+    mx::array exported = wrapper->array;
+    exported.eval();
+    if (!exported.flags().row_contiguous) {
+      exported = mx::contiguous(exported);
+      exported.eval();
     }
+    holder = new ArrayMemoryView{std::move(exported), {}, {}};
+  } catch (const std::exception&) {
+    return false;
+  }
 
-    int i = NUM2INT(index);
-    const int axis_size = wrapper->array.shape(0);
-    if (i < 0) {
-      i += axis_size;
-    }
-    if (i < 0 || i >= axis_size) {
-      rb_raise(rb_eIndexError, "index out of range");
-    }
+  const auto& array = holder->array;
+  const ssize_t itemsize = static_cast<ssize_t>(array.itemsize());
+  const size_t ndim = array.ndim();
+  holder->shape.resize(ndim);
+  holder->strides.resize(ndim);
+  ssize_t stride = itemsize;
+  for (size_t i = ndim; i-- > 0;) {
+    holder->shape[i] = static_cast<ssize_t>(array.shape(static_cast<int>(i)));
+    holder->strides[i] = stride;
+    stride *= holder->shape[i];
+  }
+
+  view->obj = obj;
+  view->data = const_cast<char*>(array.data<char>());
+  view->byte_size = static_cast<ssize_t>(array.nbytes());
+  view->readonly = true;
+  view->format = format;
+  view->item_size = itemsize;
+  view->item_desc.components = nullptr;
+  view->item_desc.length = 0;
+  view->ndim = static_cast<ssize_t>(ndim);
+  view->shape = holder->shape.data();
+  view->strides = holder->strides.data();
+  view->sub_offsets = nullptr;
+  view->private_data = holder;
+  return true;
+}
+
+static bool array_memory_view_release(VALUE, rb_memory_view_t* view) {
+  delete static_cast<ArrayMemoryView*>(view->private_data);
+  view->private_data = nullptr;
+  return true;
+}
+
+static const rb_memory_view_entry_t array_memory_view_entry = {
+    array_memory_view_get,
+    array_memory_view_release,
+    array_memory_view_available_p,
+};
 
-    mx::Shape start(wrapper->array.ndim(), 0);
-    mx::Shape stop = wrapper->array.shape();
-    start[0] = i;
-    stop[0] = i + 1;
+enum DLPackTypeCode : uint8_t {
+  kDLPackInt = 0,
+  kDLPackUInt = 1,
+  kDLPackFloat = 2,
+  kDLPackBfloat = 4,
+  kDLPackComplex = 5,
+  kDLPackBool = 6,
+};
 
-    auto sliced = mx::slice(wrapper->array, start, stop);
-    auto squeezed = mx::squeeze(sliced, 0);
-    return array_wrap(squeezed);
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+enum DLPackDeviceType : int32_t {
+  kDLPackCPU = 1,
+  kDLPackCUDAHost = 3,
+  kDLPackCUDAManaged = 13,
+};
+
+static DLDataType dlpack_dtype_from_mx(const mx::Dtype& dtype) {
+  const uint8_t bits = static_cast<uint8_t>(dtype.size() * 8);
+  switch (dtype.val()) {
+    case mx::Dtype::Val::bool_:
+      return {kDLPackBool, bits, 1};
+    case mx::Dtype::Val::uint8:
+    case mx::Dtype::Val::uint16:
+    case mx::Dtype::Val::uint32:
+    case mx::Dtype::Val::uint64:
+      return {kDLPackUInt, bits, 1};
+    case mx::Dtype::Val::int8:
+    case mx::Dtype::Val::int16:
+    case mx::Dtype::Val::int32:
+    case mx::Dtype::Val::int64:
+      return {kDLPackInt, bits, 1};
+    case mx::Dtype::Val::float16:
+    case mx::Dtype::Val::float32:
+    case mx::Dtype::Val::float64:
+      return {kDLPackFloat, bits, 1};
+    case mx::Dtype::Val::bfloat16:
+      return {kDLPackBfloat, bits, 1};
+    case mx::Dtype::Val::complex64:
+      return {kDLPackComplex, bits, 1};
+    default:
+      throw std::invalid_argument("[dlpack] unsupported dtype for export");
+  }
+}
+
+static mx::Dtype mx_dtype_from_dlpack(const DLDataType& dtype) {
+  if (dtype.lanes != 1) {
+    throw std::invalid_argument("[dlpack] vector lanes are not supported");
+  }
+  switch (dtype.code) {
+    case kDLPackBool:
+      if (dtype.bits == 8) return mx::bool_;
+      break;
+    case kDLPackUInt:
+      if (dtype.bits == 8) return mx::uint8;
+      if (dtype.bits == 16) return mx::uint16;
+      if (dtype.bits == 32) return mx::uint32;
+      if (dtype.bits == 64) return mx::uint64;
+      break;
+    case kDLPackInt:
+      if (dtype.bits == 8) return mx::int8;
+      if (dtype.bits == 16) return mx::int16;
+      if (dtype.bits == 32) return mx::int32;
+      if (dtype.bits == 64) return mx::int64;
+      break;
+    case kDLPackFloat:
+      if (dtype.bits == 16) return mx::float16;
+      if (dtype.bits == 32) return mx::float32;
+      if (dtype.bits == 64) return mx::float64;
+      break;
+    case kDLPackBfloat:
+      if (dtype.bits == 16) return mx::bfloat16;
+      break;
+    case kDLPackComplex:
+      if (dtype.bits == 64) return mx::complex64;
+      break;
+    default:
+      break;
   }
+  throw std::invalid_argument("[dlpack] unsupported tensor dtype");
 }
 
-static VALUE core_array(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE value;
-    VALUE dtype;
-    rb_scan_args(argc, argv, "11", &value, &dtype);
-    return array_wrap(array_from_ruby(value, optional_dtype_from_value(dtype)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+// Owns the exported array (and therefore its buffer) until the consumer
+// calls the DLManagedTensor deleter.
+struct DLPackExportContext {
+  mx::array array;
+  std::vector<int64_t> shape;
+  std::vector<int64_t> strides;
+  DLManagedTensor tensor;
+};
+
+static void dlpack_export_deleter(DLManagedTensor* self) {
+  delete static_cast<DLPackExportContext*>(self->manager_ctx);
+}
+
+static DLManagedTensor* dlpack_export_array(mx::array array, DLDevice device) {
+  array.eval();
+  if (!array.flags().row_contiguous) {
+    array = mx::contiguous(array);
+    array.eval();
+  }
+
+  auto* context = new DLPackExportContext{std::move(array), {}, {}, {}};
+  const auto& exported = context->array;
+  const size_t ndim = exported.ndim();
+  context->shape.resize(ndim);
+  context->strides.resize(ndim);
+  int64_t stride = 1;
+  for (size_t i = ndim; i-- > 0;) {
+    context->shape[i] = exported.shape(static_cast<int>(i));
+    context->strides[i] = stride;
+    stride *= context->shape[i];
+  }
+
+  DLTensor& tensor = context->tensor.dl_tensor;
+  tensor.data = const_cast<char*>(exported.data<char>());
+  tensor.device = device;
+  tensor.ndim = static_cast<int32_t>(ndim);
+  tensor.dtype = dlpack_dtype_from_mx(exported.dtype());
+  tensor.shape = context->shape.data();
+  tensor.strides = context->strides.data();
+  tensor.byte_offset = 0;
+  context->tensor.manager_ctx = context;
+  context->tensor.deleter = dlpack_export_deleter;
+  return &context->tensor;
+}
+
+// Takes ownership of a foreign DLManagedTensor. Host-accessible memory is
+// wrapped without a copy; the producer's deleter runs once MLX no longer
+// needs the buffer.
+static mx::array dlpack_import_tensor(DLManagedTensor* managed) {
+  if (managed == nullptr) {
+    throw std::invalid_argument("[dlpack] null DLManagedTensor");
+  }
+  auto release = [managed](void*) {
+    if (managed->deleter != nullptr) {
+      managed->deleter(managed);
+    }
+  };
+
+  const DLTensor& tensor = managed->dl_tensor;
+  const int32_t device_type = tensor.device.device_type;
+  if (device_type != kDLPackCPU && device_type != kDLPackCUDAHost &&
+      device_type != kDLPackCUDAManaged) {
+    release(nullptr);
+    throw std::invalid_argument("[dlpack] only host-accessible tensors can be imported");
   }
-}
 
-static VALUE core_broadcast_shapes(int argc, VALUE* argv, VALUE) {
+  mx::Dtype dtype = mx::float32;
   try {
-    if (argc == 0) {
-      rb_raise(rb_eArgError, "broadcast_shapes expects at least one shape");
+    dtype = mx_dtype_from_dlpack(tensor.dtype);
+  } catch (...) {
+    release(nullptr);
+    throw;
+  }
+
+  mx::Shape shape;
+  shape.reserve(static_cast<size_t>(tensor.ndim));
+  size_t size = 1;
+  for (int32_t i = 0; i < tensor.ndim; ++i) {
+    shape.push_back(static_cast<mx::ShapeElem>(tensor.shape[i]));
+    size *= static_cast<size_t>(tensor.shape[i]);
+  }
+  if (size == 0) {
+    release(nullptr);
+    return mx::zeros(shape, dtype);
+  }
+
+  void* data = static_cast<char*>(tensor.data) + tensor.byte_offset;
+  bool row_major = true;
+  if (tensor.strides != nullptr) {
+    int64_t expected = 1;
+    for (int32_t i = tensor.ndim; i-- > 0;) {
+      if (tensor.shape[i] != 1 && tensor.strides[i] != expected) {
+        row_major = false;
+      }
+      expected *= tensor.shape[i];
     }
+  }
+  if (row_major) {
+    return mx::array(data, std::move(shape), dtype, release);
+  }
 
-    auto result = shape_from_ruby(argv[0]);
-    for (int i = 1; i < argc; ++i) {
-      result = mx::broadcast_shapes(result, shape_from_ruby(argv[i]));
+  // Strided producers are viewed through as_strided over the span they
+  // cover, which keeps the import zero-copy.
+  mx::Strides strides;
+  strides.reserve(static_cast<size_t>(tensor.ndim));
+  int64_t span = 1;
+  for (int32_t i = 0; i < tensor.ndim; ++i) {
+    if (tensor.strides[i] < 0) {
+      release(nullptr);
+      throw std::invalid_argument("[dlpack] negative strides are not supported");
     }
+    strides.push_back(tensor.strides[i]);
+    span += (tensor.shape[i] - 1) * tensor.strides[i];
+  }
+  mx::array flat(data, mx::Shape{static_cast<mx::ShapeElem>(span)}, dtype, release);
+  return mx::as_strided(std::move(flat), std::move(shape), std::move(strides), 0);
+}
 
-    VALUE out = rb_ary_new_capa(static_cast<long>(result.size()));
-    for (auto dim : result) {
-      rb_ary_push(out, INT2NUM(dim));
+static DLDevice dlpack_device_from_ruby(VALUE device) {
+  DLDevice out{kDLPackCPU, 0};
+  if (RB_TYPE_P(device, T_ARRAY) && RARRAY_LEN(device) == 2) {
+    VALUE type = rb_ary_entry(device, 0);
+    VALUE index = rb_ary_entry(device, 1);
+    if (RB_INTEGER_TYPE_P(type)) {
+      out.device_type = NUM2INT(type);
+    }
+    if (RB_INTEGER_TYPE_P(index)) {
+      out.device_id = NUM2INT(index);
     }
-    return out;
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
   }
+  return out;
 }
 
-static VALUE core_add(VALUE, VALUE a, VALUE b) {
+static DLPackCapsuleWrapper* dlpack_capsule_unwrap(VALUE self) {
+  DLPackCapsuleWrapper* wrapper = nullptr;
+  TypedData_Get_Struct(self, DLPackCapsuleWrapper, &dlpack_capsule_data_type, wrapper);
+  return wrapper;
+}
+
+static VALUE dlpack_capsule_alloc(VALUE klass) {
+  auto* wrapper = new DLPackCapsuleWrapper();
+  return TypedData_Wrap_Struct(klass, &dlpack_capsule_data_type, wrapper);
+}
+
+// The managed tensor is exported lazily so capsules that are handed back to
+// MLX never force evaluation. `address` only borrows the tensor: the capsule
+// still owns it and runs its deleter when collected, so the address must not
+// be imported. `consume` hands ownership over instead.
+static VALUE dlpack_capsule_address(VALUE self) {
   try {
-    mx::array lhs = array_from_ruby(a, std::nullopt);
-    mx::array rhs = array_from_ruby(b, std::nullopt);
-    return array_wrap(call_mx_array_without_gvl([&]() { return mx::add(lhs, rhs); }));
+    auto* wrapper = dlpack_capsule_unwrap(self);
+    if (wrapper->consumed) {
+      rb_raise(rb_eRuntimeError, "DLPack capsule was already consumed");
+    }
+    if (wrapper->tensor == nullptr) {
+      mx::array array = array_unwrap(rb_ivar_get(self, cached_intern_id("@array")));
+      DLDevice device = dlpack_device_from_ruby(rb_ivar_get(self, cached_intern_id("@device")));
+      wrapper->tensor = dlpack_export_array(std::move(array), device);
+    }
+    return ULL2NUM(static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(wrapper->tensor)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_subtract(VALUE, VALUE a, VALUE b) {
+static VALUE dlpack_capsule_consume(VALUE self) {
+  VALUE address = dlpack_capsule_address(self);
+  dlpack_capsule_unwrap(self)->consumed = true;
+  return address;
+}
+
+static VALUE dlpack_capsule_consumed_p(VALUE self) {
+  return dlpack_capsule_unwrap(self)->consumed ? Qtrue : Qfalse;
+}
+
+static VALUE core_from_dlpack_address(VALUE, VALUE address) {
   try {
-    mx::array lhs = array_from_ruby(a, std::nullopt);
-    mx::array rhs = array_from_ruby(b, std::nullopt);
-    return array_wrap(call_mx_array_without_gvl([&]() { return mx::subtract(lhs, rhs); }));
+    auto* managed = reinterpret_cast<DLManagedTensor*>(
+        static_cast<uintptr_t>(NUM2ULL(address)));
+    return array_wrap(dlpack_import_tensor(managed));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_multiply(VALUE, VALUE a, VALUE b) {
+// Instance methods below are the per-op hot path of model code. They read
+// `self` straight from the wrapper and take positional arguments from argv
+// without rb_scan_args, skipping the Ruby forwarding layer entirely.
+template <typename Op>
+static VALUE array_binary_op(VALUE self, VALUE other, Op&& op) {
   try {
-    mx::array lhs = array_from_ruby(a, std::nullopt);
-    mx::array rhs = array_from_ruby(b, std::nullopt);
-    return array_wrap(call_mx_array_without_gvl([&]() { return mx::multiply(lhs, rhs); }));
+    // Copied so the op keeps its input even if the wrapper is reassigned
+    // while the GVL is released.
+    mx::array lhs = array_wrapper_get(self)->array;
+    mx::array rhs = is_numeric_scalar(other) ? weak_scalar_array(other, lhs.dtype()) : array_from_ruby(other, std::nullopt);
+    return array_wrap(call_with_gvl_policy(GvlWork::Graph, [&]() { return op(lhs, rhs); }));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_divide(VALUE, VALUE a, VALUE b) {
+template <typename Op>
+static VALUE array_unary_op(VALUE self, Op&& op) {
   try {
-    mx::array lhs = array_from_ruby(a, std::nullopt);
-    mx::array rhs = array_from_ruby(b, std::nullopt);
-    return array_wrap(call_mx_array_without_gvl([&]() { return mx::divide(lhs, rhs); }));
+    return array_wrap(op(array_wrapper_get(self)->array));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_power(VALUE, VALUE a, VALUE b) {
+// (axis = nil, keepdims = false), where axis is nil, an Integer, or an
+// Array of Integers.
+template <typename Reduce>
+static VALUE array_reduce_op(int argc, VALUE* argv, VALUE self, Reduce&& reduce) {
+  if (argc > 2) {
+    rb_error_arity(argc, 0, 2);
+  }
   try {
-    return array_wrap(mx::power(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    const mx::array& a = array_wrapper_get(self)->array;
+    VALUE axis = argc > 0 ? argv[0] : Qnil;
+    const bool keepdims = argc > 1 && RTEST(argv[1]);
+    if (NIL_P(axis)) {
+      std::vector<int> axes(a.ndim());
+      for (size_t i = 0; i < axes.size(); ++i) {
+        axes[i] = static_cast<int>(i);
+      }
+      return array_wrap(reduce(a, axes, keepdims));
+    }
+    if (RB_INTEGER_TYPE_P(axis)) {
+      return array_wrap(reduce(a, std::vector<int>{NUM2INT(axis)}, keepdims));
+    }
+    return array_wrap(reduce(a, int_vector_from_ruby(axis), keepdims));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_remainder(VALUE, VALUE a, VALUE b) {
+static VALUE array_add(VALUE self, VALUE other) {
+  return array_binary_op(self, other, [](const mx::array& a, const mx::array& b) { return mx::add(a, b); });
+}
+
+static VALUE array_subtract(VALUE self, VALUE other) {
+  return array_binary_op(
+      self, other, [](const mx::array& a, const mx::array& b) { return mx::subtract(a, b); });
+}
+
+static VALUE array_multiply(VALUE self, VALUE other) {
+  return array_binary_op(
+      self, other, [](const mx::array& a, const mx::array& b) { return mx::multiply(a, b); });
+}
+
+static VALUE array_divide(VALUE self, VALUE other) {
+  return array_binary_op(self, other, [](const mx::array& a, const mx::array& b) { return mx::divide(a, b); });
+}
+
+static VALUE array_matmul(VALUE self, VALUE other) {
+  return array_binary_op(self, other, [](const mx::array& a, const mx::array& b) { return mx::matmul(a, b); });
+}
+
+static VALUE array_square(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::square(a); });
+}
+
+static VALUE array_sqrt(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::sqrt(a); });
+}
+
+static VALUE array_rsqrt(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::rsqrt(a); });
+}
+
+static VALUE array_exp(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::exp(a); });
+}
+
+static VALUE array_log(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::log(a); });
+}
+
+static VALUE array_abs(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::abs(a); });
+}
+
+static VALUE array_negative(VALUE self) {
+  return array_unary_op(self, [](const mx::array& a) { return mx::negative(a); });
+}
+
+static VALUE array_sum(int argc, VALUE* argv, VALUE self) {
+  return array_reduce_op(argc, argv, self, [](const mx::array& a, const std::vector<int>& axes, bool keepdims) {
+    return mx::sum(a, axes, keepdims);
+  });
+}
+
+static VALUE array_mean(int argc, VALUE* argv, VALUE self) {
+  return array_reduce_op(argc, argv, self, [](const mx::array& a, const std::vector<int>& axes, bool keepdims) {
+    return mx::mean(a, axes, keepdims);
+  });
+}
+
+static VALUE array_max(int argc, VALUE* argv, VALUE self) {
+  return array_reduce_op(argc, argv, self, [](const mx::array& a, const std::vector<int>& axes, bool keepdims) {
+    return mx::max(a, axes, keepdims);
+  });
+}
+
+static VALUE array_min(int argc, VALUE* argv, VALUE self) {
+  return array_reduce_op(argc, argv, self, [](const mx::array& a, const std::vector<int>& axes, bool keepdims) {
+    return mx::min(a, axes, keepdims);
+  });
+}
+
+// reshape(shape) or reshape(d0, d1, ...).
+static VALUE array_reshape(int argc, VALUE* argv, VALUE self) {
   try {
-    return array_wrap(mx::remainder(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    const mx::array& a = array_wrapper_get(self)->array;
+    if (argc == 1 && RB_TYPE_P(argv[0], T_ARRAY)) {
+      return array_wrap(mx::reshape(a, shape_from_ruby(argv[0])));
+    }
+    mx::Shape shape;
+    shape.reserve(static_cast<size_t>(argc));
+    for (int i = 0; i < argc; ++i) {
+      shape.push_back(static_cast<mx::ShapeElem>(NUM2INT(argv[i])));
+    }
+    return array_wrap(mx::reshape(a, std::move(shape)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_divmod(VALUE, VALUE a, VALUE b) {
+static VALUE array_transpose(int argc, VALUE* argv, VALUE self) {
+  if (argc > 1) {
+    rb_error_arity(argc, 0, 1);
+  }
   try {
-    auto result = mx::divmod(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt));
-    VALUE out = rb_ary_new_capa(2);
-    if (result.size() != 2) {
-      rb_raise(rb_eRuntimeError, "divmod returned unexpected number of outputs");
+    const mx::array& a = array_wrapper_get(self)->array;
+    if (argc == 0 || NIL_P(argv[0])) {
+      return array_wrap(mx::transpose(a));
     }
-    rb_ary_push(out, array_wrap(result[0]));
-    rb_ary_push(out, array_wrap(result[1]));
-    return out;
+    return array_wrap(mx::transpose(a, int_vector_from_ruby(argv[0])));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_slice(int argc, VALUE* argv, VALUE) {
+static VALUE array_flatten(int argc, VALUE* argv, VALUE self) {
+  if (argc > 2) {
+    rb_error_arity(argc, 0, 2);
+  }
   try {
-    VALUE array;
-    VALUE start;
-    VALUE stop;
-    VALUE strides;
-    rb_scan_args(argc, argv, "31", &array, &start, &stop, &strides);
-
-    auto a = array_unwrap(array);
-    auto start_shape = shape_from_ruby(start);
-    auto stop_shape = shape_from_ruby(stop);
-
-    if (NIL_P(strides)) {
-      return array_wrap(mx::slice(a, start_shape, stop_shape));
-    }
-    auto stride_shape = shape_from_ruby(strides);
-    return array_wrap(mx::slice(a, start_shape, stop_shape, stride_shape));
+    const mx::array& a = array_wrapper_get(self)->array;
+    const int start_axis = argc > 0 && !NIL_P(argv[0]) ? NUM2INT(argv[0]) : 0;
+    const int end_axis = argc > 1 && !NIL_P(argv[1]) ? NUM2INT(argv[1]) : -1;
+    return array_wrap(mx::flatten(a, start_axis, end_axis));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_slice_update(int argc, VALUE* argv, VALUE) {
+static VALUE array_astype(int argc, VALUE* argv, VALUE self) {
+  if (argc < 1 || argc > 2) {
+    rb_error_arity(argc, 1, 2);
+  }
   try {
-    VALUE src;
-    VALUE update;
-    VALUE start;
-    VALUE stop;
-    VALUE strides;
-    rb_scan_args(argc, argv, "41", &src, &update, &start, &stop, &strides);
-
-    auto src_a = array_unwrap(src);
-    auto update_a = array_unwrap(update);
-    auto start_shape = shape_from_ruby(start);
-    auto stop_shape = shape_from_ruby(stop);
-    if (NIL_P(strides)) {
-      return array_wrap(mx::slice_update(src_a, update_a, start_shape, stop_shape));
+    const mx::array& a = array_wrapper_get(self)->array;
+    const mx::Dtype dtype = optional_dtype_from_value(argv[0]).value_or(mx::float32);
+    if (argc == 2 && !NIL_P(argv[1])) {
+      return array_wrap(mx::astype(a, dtype, stream_or_device_from_value(argv[1])));
     }
-    auto stride_shape = shape_from_ruby(strides);
-    return array_wrap(mx::slice_update(src_a, update_a, start_shape, stop_shape, stride_shape));
+    return array_wrap(mx::astype(a, dtype));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_take(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE indices;
-    VALUE axis;
-    rb_scan_args(argc, argv, "21", &array, &indices, &axis);
-    auto a = array_unwrap(array);
+// NumPy-style indexing. Ruby index values are parsed once into IndexItems:
+// Integer, Range / ArithmeticSequence (slices, `(0..) % 2`, `9.step(0, -1)`),
+// nil (newaxis), :"..." / :ellipsis, and index arrays (MLX arrays or Ruby
+// lists of integers or booleans). Several indices, or a Ruby Array holding a
+// Range, nil, ellipsis or MLX array, index one axis each.
+static std::string shape_to_string(const mx::Shape& shape);
 
-    if (RB_INTEGER_TYPE_P(indices)) {
-      const int idx = NUM2INT(indices);
-      if (NIL_P(axis)) {
-        return array_wrap(mx::take(a, idx));
-      }
-      return array_wrap(mx::take(a, idx, NUM2INT(axis)));
+struct IndexTypeError : std::invalid_argument {
+  using std::invalid_argument::invalid_argument;
+};
+
+enum class IndexKind { Integer, Slice, Ellipsis, NewAxis, Array };
+
+struct IndexItem {
+  IndexKind kind = IndexKind::Integer;
+  int64_t value = 0;
+  std::optional<int64_t> begin;
+  std::optional<int64_t> end;
+  int64_t step = 1;
+  bool exclude_end = true;
+  std::optional<mx::array> array;
+};
+
+struct ResolvedSlice {
+  int64_t start;
+  int64_t step;
+  int64_t count;
+};
+
+static void raise_index_exception(const std::exception& error) {
+  if (dynamic_cast<const IndexTypeError*>(&error) != nullptr) {
+    rb_raise(rb_eTypeError, "%s", error.what());
+  }
+  if (dynamic_cast<const std::out_of_range*>(&error) != nullptr) {
+    rb_raise(rb_eIndexError, "%s", error.what());
+  }
+  if (dynamic_cast<const std::invalid_argument*>(&error) != nullptr) {
+    rb_raise(rb_eArgError, "%s", error.what());
+  }
+  raise_std_exception(error);
+}
+
+static bool index_is_ellipsis(VALUE value) {
+  if (!SYMBOL_P(value)) {
+    return false;
+  }
+  const ID id = SYM2ID(value);
+  return id == cached_intern_id("...") || id == cached_intern_id("ellipsis");
+}
+
+static bool index_range_components(VALUE value, rb_arithmetic_sequence_components_t* components) {
+  if (RB_INTEGER_TYPE_P(value) || RB_TYPE_P(value, T_ARRAY) || NIL_P(value) || SYMBOL_P(value)) {
+    return false;
+  }
+  return rb_arithmetic_sequence_extract(value, components) != 0;
+}
+
+static bool index_array_is_tuple(VALUE value) {
+  const long length = RARRAY_LEN(value);
+  for (long i = 0; i < length; ++i) {
+    VALUE entry = rb_ary_entry(value, i);
+    rb_arithmetic_sequence_components_t components;
+    if (NIL_P(entry) || index_is_ellipsis(entry) || rb_obj_is_kind_of(entry, cArray) ||
+        index_range_components(entry, &components)) {
+      return true;
     }
+  }
+  return false;
+}
 
-    auto idx_array = RB_TYPE_P(indices, T_ARRAY)
-        ? array_from_ruby(indices, std::make_optional(mx::int32))
-        : array_from_ruby(indices, std::nullopt);
-    if (NIL_P(axis)) {
-      return array_wrap(mx::take(a, idx_array));
+static std::optional<int64_t> index_range_bound(VALUE value) {
+  if (NIL_P(value)) {
+    return std::nullopt;
+  }
+  if (!RB_INTEGER_TYPE_P(value)) {
+    throw IndexTypeError("slice bounds must be Integers or nil");
+  }
+  return static_cast<int64_t>(NUM2LL(value));
+}
+
+static IndexItem index_item_from_ruby(VALUE value) {
+  IndexItem item;
+  if (RB_INTEGER_TYPE_P(value)) {
+    item.value = static_cast<int64_t>(NUM2LL(value));
+    return item;
+  }
+  if (NIL_P(value)) {
+    item.kind = IndexKind::NewAxis;
+    return item;
+  }
+  if (index_is_ellipsis(value)) {
+    item.kind = IndexKind::Ellipsis;
+    return item;
+  }
+  if (rb_obj_is_kind_of(value, cArray)) {
+    item.kind = IndexKind::Array;
+    item.array = array_wrapper_get(value)->array;
+    return item;
+  }
+  if (RB_TYPE_P(value, T_ARRAY)) {
+    item.kind = IndexKind::Array;
+    item.array = RARRAY_LEN(value) == 0 ? mx::zeros({0}, mx::int32) : array_from_ruby_list(value);
+    return item;
+  }
+  rb_arithmetic_sequence_components_t components;
+  if (index_range_components(value, &components)) {
+    item.kind = IndexKind::Slice;
+    item.begin = index_range_bound(components.begin);
+    item.end = index_range_bound(components.end);
+    if (!RB_INTEGER_TYPE_P(components.step)) {
+      throw IndexTypeError("slice step must be an Integer");
     }
-    return array_wrap(mx::take(a, idx_array, NUM2INT(axis)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+    item.step = static_cast<int64_t>(NUM2LL(components.step));
+    if (item.step == 0) {
+      throw std::invalid_argument("slice step cannot be zero");
+    }
+    item.exclude_end = RTEST(components.exclude_end);
+    return item;
   }
+  throw IndexTypeError(std::string("unsupported index type ") + rb_obj_classname(value));
 }
 
-static VALUE core_take_along_axis(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE indices;
-    VALUE axis;
-    rb_scan_args(argc, argv, "21", &array, &indices, &axis);
+static std::vector<IndexItem> index_items_from_ruby(int argc, const VALUE* argv) {
+  std::vector<IndexItem> items;
+  if (argc == 1 && RB_TYPE_P(argv[0], T_ARRAY) && index_array_is_tuple(argv[0])) {
+    const long length = RARRAY_LEN(argv[0]);
+    items.reserve(static_cast<size_t>(length));
+    for (long i = 0; i < length; ++i) {
+      items.push_back(index_item_from_ruby(rb_ary_entry(argv[0], i)));
+    }
+    return items;
+  }
+  items.reserve(static_cast<size_t>(argc));
+  for (int i = 0; i < argc; ++i) {
+    items.push_back(index_item_from_ruby(argv[i]));
+  }
+  return items;
+}
 
-    auto a = array_unwrap(array);
-    auto idx = RB_TYPE_P(indices, T_ARRAY)
-        ? array_from_ruby(indices, std::make_optional(mx::int32))
-        : array_from_ruby(indices, std::nullopt);
+// Ruby ranges are inclusive unless built with `...`; the result follows
+// Python slice clamping so out-of-range bounds select nothing rather than
+// raising.
+static ResolvedSlice resolve_index_slice(const IndexItem& item, int64_t size) {
+  const auto wrap = [size](int64_t bound) { return bound < 0 ? bound + size : bound; };
+  if (item.step > 0) {
+    int64_t start = item.begin ? std::clamp<int64_t>(wrap(*item.begin), 0, size) : 0;
+    int64_t stop = size;
+    if (item.end) {
+      stop = std::clamp<int64_t>(wrap(*item.end) + (item.exclude_end ? 0 : 1), 0, size);
+    }
+    const int64_t count = stop > start ? (stop - start + item.step - 1) / item.step : 0;
+    return {start, item.step, count};
+  }
+  int64_t start = item.begin ? std::clamp<int64_t>(wrap(*item.begin), -1, size - 1) : size - 1;
+  int64_t stop = -1;
+  if (item.end) {
+    stop = std::clamp<int64_t>(wrap(*item.end) - (item.exclude_end ? 0 : 1), -1, size - 1);
+  }
+  const int64_t count = start > stop ? (start - stop - item.step - 1) / -item.step : 0;
+  return {start, item.step, count};
+}
 
-    if (NIL_P(axis)) {
-      auto flat = mx::reshape(a, mx::Shape{-1});
-      return array_wrap(mx::take_along_axis(flat, idx, 0));
+static bool index_slice_is_full(const IndexItem& item, int64_t size) {
+  if (item.kind != IndexKind::Slice || item.step != 1) {
+    return false;
+  }
+  const ResolvedSlice slice = resolve_index_slice(item, size);
+  return slice.start == 0 && slice.count == size;
+}
+
+static IndexItem index_full_slice() {
+  IndexItem item;
+  item.kind = IndexKind::Slice;
+  return item;
+}
+
+static IndexItem index_coordinate_array(mx::array coordinates) {
+  IndexItem item;
+  item.kind = IndexKind::Array;
+  item.array = std::move(coordinates);
+  return item;
+}
+
+// Expands the ellipsis, bounds-checks integers, normalizes negative entries
+// of integer arrays on device, and replaces boolean masks with the integer
+// coordinates of their true elements (the only step that reads values on
+// the host). Full slices at the end are dropped, so every remaining
+// non-newaxis item indexes the next leading axis of `shape`.
+static std::vector<IndexItem> expand_index_items(std::vector<IndexItem> items, const mx::Shape& shape) {
+  const int ndim = static_cast<int>(shape.size());
+  int consumed = 0;
+  int ellipses = 0;
+  for (const auto& item : items) {
+    if (item.kind == IndexKind::Ellipsis) {
+      ellipses += 1;
+    } else if (item.kind == IndexKind::Array && item.array->dtype() == mx::bool_) {
+      consumed += std::max(1, static_cast<int>(item.array->ndim()));
+    } else if (item.kind != IndexKind::NewAxis) {
+      consumed += 1;
+    }
+  }
+  if (ellipses > 1) {
+    throw std::invalid_argument("an index can only have a single ellipsis");
+  }
+  if (consumed > ndim) {
+    throw std::out_of_range(
+        "too many indices for array: array is " + std::to_string(ndim) + "-dimensional, but " +
+        std::to_string(consumed) + " were indexed");
+  }
+
+  std::vector<IndexItem> expanded;
+  expanded.reserve(items.size() + static_cast<size_t>(ndim));
+  int axis = 0;
+  for (auto& item : items) {
+    switch (item.kind) {
+      case IndexKind::Ellipsis:
+        for (int i = consumed; i < ndim; ++i) {
+          expanded.push_back(index_full_slice());
+          axis += 1;
+        }
+        break;
+      case IndexKind::NewAxis:
+        expanded.push_back(std::move(item));
+        break;
+      case IndexKind::Integer: {
+        const int64_t size = shape[axis];
+        const int64_t index = item.value < 0 ? item.value + size : item.value;
+        if (index < 0 || index >= size) {
+          throw std::out_of_range(
+              "index " + std::to_string(item.value) + " is out of bounds for axis " + std::to_string(axis) +
+              " with size " + std::to_string(size));
+        }
+        item.value = index;
+        expanded.push_back(std::move(item));
+        axis += 1;
+        break;
+      }
+      case IndexKind::Slice:
+        expanded.push_back(std::move(item));
+        axis += 1;
+        break;
+      case IndexKind::Array: {
+        const mx::array& index = *item.array;
+        if (index.dtype() == mx::bool_) {
+          if (index.ndim() == 0) {
+            throw std::invalid_argument("0-dimensional boolean indices are not supported");
+          }
+          const int mask_ndim = static_cast<int>(index.ndim());
+          for (int i = 0; i < mask_ndim; ++i) {
+            if (index.shape(i) != shape[axis + i]) {
+              throw std::out_of_range(
+                  "boolean index did not match indexed array along axis " + std::to_string(axis + i) +
+                  "; size is " + std::to_string(shape[axis + i]) + " but boolean index size is " +
+                  std::to_string(index.shape(i)));
+            }
+          }
+          const mx::array host = host_array_for_ruby(index);
+          const bool* flags = host.data<bool>();
+          const size_t total = host.size();
+          std::vector<std::vector<int32_t>> coordinates(static_cast<size_t>(mask_ndim));
+          for (size_t flat = 0; flat < total; ++flat) {
+            if (!flags[flat]) {
+              continue;
+            }
+            size_t rest = flat;
+            for (int d = mask_ndim - 1; d >= 0; --d) {
+              const size_t extent = static_cast<size_t>(index.shape(d));
+              coordinates[d].push_back(static_cast<int32_t>(rest % extent));
+              rest /= extent;
+            }
+          }
+          for (auto& coordinate : coordinates) {
+            const int count = static_cast<int>(coordinate.size());
+            expanded.push_back(index_coordinate_array(
+                count == 0 ? mx::zeros({0}, mx::int32) : mx::array(coordinate.begin(), {count}, mx::int32)));
+          }
+          axis += mask_ndim;
+          break;
+        }
+        if (!mx::issubdtype(index.dtype(), mx::integer)) {
+          throw IndexTypeError("array indices must be integers or booleans");
+        }
+        mx::array normalized = mx::astype(index, mx::int32);
+        if (mx::issubdtype(index.dtype(), mx::signedinteger)) {
+          normalized = mx::where(
+              mx::less(normalized, mx::array(0, mx::int32)),
+              mx::add(normalized, mx::array(static_cast<int>(shape[axis]), mx::int32)),
+              normalized);
+        }
+        item.array = std::move(normalized);
+        expanded.push_back(std::move(item));
+        axis += 1;
+        break;
+      }
     }
-    return array_wrap(mx::take_along_axis(a, idx, NUM2INT(axis)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
   }
+
+  while (!expanded.empty() && expanded.back().kind == IndexKind::Slice && axis > 0 &&
+         index_slice_is_full(expanded.back(), shape[axis - 1])) {
+    expanded.pop_back();
+    axis -= 1;
+  }
+  return expanded;
 }
 
-static VALUE core_put_along_axis(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE indices;
-    VALUE values;
-    VALUE axis;
-    rb_scan_args(argc, argv, "31", &array, &indices, &values, &axis);
+// Result layout of an expanded index. Integers alongside index arrays take
+// part in broadcasting, and the broadcast dimensions go where the first of
+// them was when they are adjacent, otherwise in front (NumPy rules).
+struct IndexLayout {
+  int axes = 0;
+  bool advanced = false;
+  mx::Shape advanced_shape;
+  size_t advanced_position = 0;
+  size_t newaxes_before_advanced = 0;
+  mx::Shape result_shape;
+  std::vector<int> newaxis_positions;
+  std::vector<ResolvedSlice> slices;
+};
 
-    auto a = array_unwrap(array);
-    auto idx = RB_TYPE_P(indices, T_ARRAY)
-        ? array_from_ruby(indices, std::make_optional(mx::int32))
-        : array_from_ruby(indices, std::nullopt);
-    auto vals = array_from_ruby(values, std::nullopt);
+static IndexLayout index_layout(const std::vector<IndexItem>& items, const mx::Shape& shape) {
+  IndexLayout layout;
+  layout.slices.resize(items.size());
+  for (const auto& item : items) {
+    if (item.kind == IndexKind::Array) {
+      layout.advanced = true;
+      layout.advanced_shape = mx::broadcast_shapes(layout.advanced_shape, item.array->shape());
+    }
+  }
+
+  bool seen_advanced = false;
+  bool gap_after_advanced = false;
+  bool adjacent = true;
+  size_t dims_before = 0;
+  size_t newaxes_before = 0;
+  for (size_t i = 0; i < items.size(); ++i) {
+    const auto& item = items[i];
+    const bool is_advanced =
+        layout.advanced && (item.kind == IndexKind::Array || item.kind == IndexKind::Integer);
+    if (is_advanced) {
+      if (!seen_advanced) {
+        layout.advanced_position = dims_before;
+        layout.newaxes_before_advanced = newaxes_before;
+      } else if (gap_after_advanced) {
+        adjacent = false;
+      }
+      seen_advanced = true;
+    } else if (seen_advanced && item.kind != IndexKind::Integer) {
+      gap_after_advanced = true;
+    }
+
+    if (item.kind == IndexKind::Slice) {
+      layout.slices[i] = resolve_index_slice(item, shape[layout.axes]);
+      layout.result_shape.push_back(static_cast<int>(layout.slices[i].count));
+      dims_before += 1;
+    } else if (item.kind == IndexKind::NewAxis) {
+      layout.newaxis_positions.push_back(static_cast<int>(dims_before));
+      layout.result_shape.push_back(1);
+      dims_before += 1;
+      newaxes_before += seen_advanced ? 0 : 1;
+    }
+    if (item.kind != IndexKind::NewAxis) {
+      layout.axes += 1;
+    }
+  }
+  if (!adjacent) {
+    layout.advanced_position = 0;
+    layout.newaxes_before_advanced = 0;
+  }
+  if (layout.advanced) {
+    layout.result_shape.insert(
+        layout.result_shape.begin() + static_cast<std::ptrdiff_t>(layout.advanced_position),
+        layout.advanced_shape.begin(),
+        layout.advanced_shape.end());
+    for (int& position : layout.newaxis_positions) {
+      if (position >= static_cast<int>(layout.advanced_position)) {
+        position += static_cast<int>(layout.advanced_shape.size());
+      }
+    }
+  }
+  layout.result_shape.insert(layout.result_shape.end(), shape.begin() + layout.axes, shape.end());
+  return layout;
+}
 
-    if (NIL_P(axis)) {
-      auto flat = mx::reshape(a, mx::Shape{-1});
-      auto updated = mx::put_along_axis(flat, idx, vals, 0);
-      return array_wrap(mx::reshape(updated, a.shape()));
+static bool shape_broadcasts_to(const mx::Shape& from, const mx::Shape& to) {
+  if (from.size() > to.size()) {
+    return false;
+  }
+  const size_t offset = to.size() - from.size();
+  for (size_t i = 0; i < from.size(); ++i) {
+    if (from[i] != 1 && from[i] != to[offset + i]) {
+      return false;
     }
-    return array_wrap(mx::put_along_axis(a, idx, vals, NUM2INT(axis)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
   }
+  return true;
 }
 
-static VALUE core_pad(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE pad_width;
-    VALUE mode;
-    VALUE constant_values;
-    rb_scan_args(argc, argv, "22", &array, &pad_width, &mode, &constant_values);
+// Leading singleton dimensions beyond the target rank are dropped before
+// broadcasting, as NumPy does for assignment.
+static mx::array index_update_value(mx::array value, const mx::Shape& target) {
+  while (value.ndim() > target.size() && value.shape(0) == 1) {
+    value = mx::squeeze(value, 0);
+  }
+  if (!shape_broadcasts_to(value.shape(), target)) {
+    throw std::invalid_argument(
+        "cannot broadcast assigned value of shape " + shape_to_string(value.shape()) + " to indexed shape " +
+        shape_to_string(target));
+  }
+  return mx::broadcast_to(value, target);
+}
 
-    auto a = array_unwrap(array);
-    auto pad_value = NIL_P(constant_values)
-        ? mx::array(0)
-        : array_from_ruby(constant_values, std::nullopt);
-    const std::string mode_v = NIL_P(mode) ? "constant" : StringValueCStr(mode);
+// Scatter form of an expanded index: every indexed axis becomes an int32
+// index array broadcast over the result dimensions, and updates of the
+// result shape reshape to `update_shape` (newaxis entries only affect the
+// update). Requires at least one indexed axis.
+struct IndexScatter {
+  std::vector<mx::array> indices;
+  std::vector<int> axes;
+  mx::Shape update_shape;
+};
 
-    if (RB_INTEGER_TYPE_P(pad_width)) {
-      return array_wrap(mx::pad(a, NUM2INT(pad_width), pad_value, mode_v));
+static IndexScatter index_scatter(
+    const std::vector<IndexItem>& items,
+    const IndexLayout& layout,
+    const mx::Shape& shape) {
+  mx::Shape index_shape;
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (items[i].kind == IndexKind::Slice) {
+      index_shape.push_back(static_cast<int>(layout.slices[i].count));
+    }
+  }
+  const size_t advanced_at = layout.advanced_position - layout.newaxes_before_advanced;
+  index_shape.insert(
+      index_shape.begin() + static_cast<std::ptrdiff_t>(advanced_at),
+      layout.advanced_shape.begin(),
+      layout.advanced_shape.end());
+
+  IndexScatter scatter;
+  size_t slice_dim = 0;
+  for (size_t i = 0; i < items.size(); ++i) {
+    const IndexItem& item = items[i];
+    if (item.kind == IndexKind::NewAxis) {
+      continue;
+    }
+    mx::Shape placed(index_shape.size(), 1);
+    mx::array index = mx::array(0, mx::int32);
+    if (item.kind == IndexKind::Slice) {
+      const ResolvedSlice& slice = layout.slices[i];
+      const size_t dim = slice_dim < advanced_at ? slice_dim : slice_dim + layout.advanced_shape.size();
+      placed[dim] = static_cast<int>(slice.count);
+      index = mx::arange(
+          static_cast<double>(slice.start),
+          static_cast<double>(slice.start + slice.count * slice.step),
+          static_cast<double>(slice.step),
+          mx::int32);
+      slice_dim += 1;
+    } else if (item.kind == IndexKind::Integer) {
+      index = mx::array(static_cast<int>(item.value), mx::int32);
+    } else {
+      std::copy(layout.advanced_shape.begin(), layout.advanced_shape.end(), placed.begin() + advanced_at);
+      index = mx::broadcast_to(*item.array, layout.advanced_shape);
     }
+    scatter.indices.push_back(mx::broadcast_to(mx::reshape(index, placed), index_shape));
+    scatter.axes.push_back(static_cast<int>(scatter.axes.size()));
+  }
 
-    if (!RB_TYPE_P(pad_width, T_ARRAY)) {
-      rb_raise(
-          rb_eTypeError,
-          "pad_width must be an Integer, [before, after], or [[before, after], ...]");
+  scatter.update_shape = index_shape;
+  scatter.update_shape.insert(scatter.update_shape.end(), scatter.axes.size(), 1);
+  scatter.update_shape.insert(scatter.update_shape.end(), shape.begin() + layout.axes, shape.end());
+  return scatter;
+}
+
+static mx::array array_set_item(const mx::array& src, std::vector<IndexItem> items, mx::array value) {
+  value = mx::astype(value, src.dtype());
+  const mx::Shape& shape = src.shape();
+
+  // A leading boolean mask is a lazy select that never leaves the device
+  // when the value only varies along the unmasked trailing axes (or is a
+  // scalar). A value with per-selected-element entries must be consumed in
+  // mask order, which `where` cannot express, so it takes the scatter path.
+  size_t value_rank = value.ndim();
+  for (size_t i = 0; i < value.ndim() && value.shape(static_cast<int>(i)) == 1; ++i) {
+    value_rank -= 1;
+  }
+  if (items.size() == 1 && items[0].kind == IndexKind::Array && items[0].array->dtype() == mx::bool_ &&
+      items[0].array->ndim() > 0 && items[0].array->ndim() <= src.ndim() &&
+      value_rank <= src.ndim() - items[0].array->ndim() && shape_broadcasts_to(value.shape(), shape)) {
+    const mx::array& mask = *items[0].array;
+    if (std::equal(mask.shape().begin(), mask.shape().end(), shape.begin())) {
+      mx::Shape mask_shape = mask.shape();
+      mask_shape.resize(shape.size(), 1);
+      return mx::where(mx::reshape(mask, mask_shape), mx::broadcast_to(value, shape), src);
     }
+  }
 
-    const long len = RARRAY_LEN(pad_width);
-    if (len == 0) {
-      rb_raise(rb_eArgError, "pad_width must not be empty");
+  items = expand_index_items(std::move(items), shape);
+  const IndexLayout layout = index_layout(items, shape);
+  const mx::array update = index_update_value(value, layout.result_shape);
+  for (const int extent : layout.result_shape) {
+    if (extent == 0) {
+      return src;
     }
+  }
 
-    VALUE first = rb_ary_entry(pad_width, 0);
-    if (RB_INTEGER_TYPE_P(first)) {
-      if (len == 1) {
-        return array_wrap(mx::pad(a, NUM2INT(first), pad_value, mode_v));
+  const mx::Shape trailing(shape.begin() + layout.axes, shape.end());
+  bool basic = !layout.advanced;
+  for (size_t i = 0; basic && i < items.size(); ++i) {
+    basic = items[i].kind != IndexKind::Slice || layout.slices[i].step > 0;
+  }
+
+  if (basic) {
+    mx::Shape start(shape.size(), 0);
+    mx::Shape stop = shape;
+    mx::Shape strides(shape.size(), 1);
+    mx::Shape update_shape;
+    int axis = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+      if (items[i].kind == IndexKind::NewAxis) {
+        continue;
       }
-      if (len != 2 || !RB_INTEGER_TYPE_P(rb_ary_entry(pad_width, 1))) {
-        rb_raise(rb_eTypeError, "pad_width array must be [before, after]");
+      if (items[i].kind == IndexKind::Integer) {
+        start[axis] = static_cast<int>(items[i].value);
+        stop[axis] = start[axis] + 1;
+        update_shape.push_back(1);
+      } else {
+        const ResolvedSlice& slice = layout.slices[i];
+        start[axis] = static_cast<int>(slice.start);
+        stop[axis] = static_cast<int>(slice.start + (slice.count - 1) * slice.step + 1);
+        strides[axis] = static_cast<int>(slice.step);
+        update_shape.push_back(static_cast<int>(slice.count));
       }
-      std::pair<int, int> pair{NUM2INT(first), NUM2INT(rb_ary_entry(pad_width, 1))};
-      return array_wrap(mx::pad(a, pair, pad_value, mode_v));
+      axis += 1;
     }
+    update_shape.insert(update_shape.end(), trailing.begin(), trailing.end());
+    return mx::slice_update(src, mx::reshape(update, update_shape), start, stop, strides);
+  }
 
-    std::vector<std::pair<int, int>> widths;
-    widths.reserve(static_cast<size_t>(len));
-    for (long i = 0; i < len; ++i) {
-      VALUE entry = rb_ary_entry(pad_width, i);
-      if (!RB_TYPE_P(entry, T_ARRAY) || RARRAY_LEN(entry) != 2) {
-        rb_raise(
-            rb_eTypeError,
-            "pad_width nested form must be [[before, after], ...]");
+  IndexScatter scatter = index_scatter(items, layout, shape);
+  return mx::scatter(src, scatter.indices, mx::reshape(update, scatter.update_shape), scatter.axes);
+}
+
+enum class IndexReduce { Add, Subtract, Multiply, Divide, Maximum, Minimum };
+
+static IndexReduce index_reduce_from_ruby(VALUE op) {
+  static const std::pair<const char*, IndexReduce> kReductions[] = {
+      {"add", IndexReduce::Add},
+      {"subtract", IndexReduce::Subtract},
+      {"multiply", IndexReduce::Multiply},
+      {"divide", IndexReduce::Divide},
+      {"maximum", IndexReduce::Maximum},
+      {"minimum", IndexReduce::Minimum},
+  };
+  const ID id = rb_sym2id(op);
+  for (const auto& [name, reduce] : kReductions) {
+    if (id == cached_intern_id(name)) {
+      return reduce;
+    }
+  }
+  throw std::invalid_argument(std::string("unsupported at[] update ") + rb_id2name(id));
+}
+
+// Accumulating counterpart of array_set_item behind Array#at[]: repeated
+// indices combine instead of overwriting. Subtract and divide scatter the
+// negated and reciprocal values, as in Python MLX.
+static mx::array array_index_reduce(
+    const mx::array& src,
+    std::vector<IndexItem> items,
+    mx::array value,
+    IndexReduce op) {
+  value = mx::astype(value, src.dtype());
+  const mx::Shape& shape = src.shape();
+  items = expand_index_items(std::move(items), shape);
+  const IndexLayout layout = index_layout(items, shape);
+  mx::array update = index_update_value(value, layout.result_shape);
+  for (const int extent : layout.result_shape) {
+    if (extent == 0) {
+      return src;
+    }
+  }
+
+  if (layout.axes == 0) {
+    update = mx::reshape(update, shape);
+    switch (op) {
+      case IndexReduce::Add:
+        return mx::add(src, update);
+      case IndexReduce::Subtract:
+        return mx::subtract(src, update);
+      case IndexReduce::Multiply:
+        return mx::multiply(src, update);
+      case IndexReduce::Divide:
+        return mx::divide(src, update);
+      case IndexReduce::Maximum:
+        return mx::maximum(src, update);
+      case IndexReduce::Minimum:
+        return mx::minimum(src, update);
+    }
+  }
+
+  IndexScatter scatter = index_scatter(items, layout, shape);
+  update = mx::reshape(update, scatter.update_shape);
+  switch (op) {
+    case IndexReduce::Add:
+      return mx::scatter_add(src, scatter.indices, update, scatter.axes);
+    case IndexReduce::Subtract:
+      return mx::scatter_add(src, scatter.indices, mx::negative(update), scatter.axes);
+    case IndexReduce::Multiply:
+      return mx::scatter_prod(src, scatter.indices, update, scatter.axes);
+    case IndexReduce::Divide:
+      return mx::scatter_prod(src, scatter.indices, mx::reciprocal(update), scatter.axes);
+    case IndexReduce::Maximum:
+      return mx::scatter_max(src, scatter.indices, update, scatter.axes);
+    case IndexReduce::Minimum:
+      return mx::scatter_min(src, scatter.indices, update, scatter.axes);
+  }
+  return src;
+}
+
+static VALUE array_setitem(int argc, VALUE* argv, VALUE self) {
+  if (argc < 2) {
+    rb_error_arity(argc, 2, UNLIMITED_ARGUMENTS);
+  }
+  try {
+    const mx::array& src = array_wrapper_get(self)->array;
+    std::vector<IndexItem> items = index_items_from_ruby(argc - 1, argv);
+    mx::array value = array_from_ruby(argv[argc - 1], src.dtype());
+    return array_wrap(array_set_item(src, std::move(items), std::move(value)));
+  } catch (const std::exception& error) {
+    raise_index_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE array_at_update(int argc, VALUE* argv, VALUE self) {
+  if (argc < 3) {
+    rb_error_arity(argc, 3, UNLIMITED_ARGUMENTS);
+  }
+  try {
+    const mx::array& src = array_wrapper_get(self)->array;
+    Check_Type(argv[0], T_SYMBOL);
+    const IndexReduce op = index_reduce_from_ruby(argv[0]);
+    std::vector<IndexItem> items = index_items_from_ruby(argc - 2, argv + 1);
+    mx::array value = array_from_ruby(argv[argc - 1], src.dtype());
+    return array_wrap(array_index_reduce(src, std::move(items), std::move(value), op));
+  } catch (const std::exception& error) {
+    raise_index_exception(error);
+    return Qnil;
+  }
+}
+
+// Compiles an index into at most one strided mx::slice, then either a take
+// (one index array), a gather over the indexed axes, or squeezes for
+// integers, and finally expand_dims for newaxis entries. Slices and
+// integers stay views of `src`.
+static mx::array array_get_item(const mx::array& src, std::vector<IndexItem> items) {
+  const mx::Shape& shape = src.shape();
+  items = expand_index_items(std::move(items), shape);
+  const IndexLayout layout = index_layout(items, shape);
+
+  mx::Shape start(shape.size(), 0);
+  mx::Shape stop = shape;
+  mx::Shape strides(shape.size(), 1);
+  bool sliced = false;
+  std::vector<int> integer_axes;
+  std::vector<int> advanced_axes;
+  std::vector<const IndexItem*> advanced_items;
+  int axis = 0;
+  for (size_t i = 0; i < items.size(); ++i) {
+    const IndexItem& item = items[i];
+    if (item.kind == IndexKind::NewAxis) {
+      continue;
+    }
+    if (item.kind == IndexKind::Slice) {
+      const ResolvedSlice& slice = layout.slices[i];
+      if (slice.count == 0) {
+        start[axis] = 0;
+        stop[axis] = 0;
+      } else if (slice.step > 0) {
+        start[axis] = static_cast<int>(slice.start);
+        stop[axis] = static_cast<int>(slice.start + (slice.count - 1) * slice.step + 1);
+        strides[axis] = static_cast<int>(slice.step);
+      } else {
+        // mx::slice reads negative bounds from the end, so "before index 0"
+        // is spelled -size - 1 as in Python.
+        const int64_t last = slice.start + (slice.count - 1) * slice.step - 1;
+        start[axis] = static_cast<int>(slice.start);
+        stop[axis] = static_cast<int>(last < 0 ? -shape[axis] - 1 : last);
+        strides[axis] = static_cast<int>(slice.step);
       }
-      VALUE lo = rb_ary_entry(entry, 0);
-      VALUE hi = rb_ary_entry(entry, 1);
-      if (!RB_INTEGER_TYPE_P(lo) || !RB_INTEGER_TYPE_P(hi)) {
-        rb_raise(rb_eTypeError, "pad_width entries must be integers");
+      sliced = sliced || start[axis] != 0 || stop[axis] != shape[axis] || strides[axis] != 1;
+    } else if (item.kind == IndexKind::Integer && !layout.advanced) {
+      start[axis] = static_cast<int>(item.value);
+      stop[axis] = start[axis] + 1;
+      sliced = true;
+      integer_axes.push_back(axis);
+    } else {
+      advanced_axes.push_back(axis);
+      advanced_items.push_back(&item);
+    }
+    axis += 1;
+  }
+
+  mx::array out = sliced ? mx::slice(src, start, stop, strides) : src;
+  if (!integer_axes.empty()) {
+    out = mx::squeeze(out, integer_axes);
+  }
+
+  if (advanced_items.size() == 1 && advanced_items[0]->kind == IndexKind::Array) {
+    out = mx::take(out, *advanced_items[0]->array, advanced_axes[0]);
+  } else if (!advanced_items.empty()) {
+    std::vector<mx::array> indices;
+    indices.reserve(advanced_items.size());
+    for (const IndexItem* item : advanced_items) {
+      indices.push_back(mx::broadcast_to(
+          item->kind == IndexKind::Integer ? mx::array(static_cast<int>(item->value), mx::int32) : *item->array,
+          layout.advanced_shape));
+    }
+    mx::Shape slice_sizes = out.shape();
+    for (const int indexed : advanced_axes) {
+      slice_sizes[indexed] = 1;
+    }
+    out = mx::gather(out, indices, advanced_axes, slice_sizes);
+
+    const int advanced_ndim = static_cast<int>(layout.advanced_shape.size());
+    std::vector<int> gathered_axes;
+    for (const int indexed : advanced_axes) {
+      gathered_axes.push_back(advanced_ndim + indexed);
+    }
+    out = mx::squeeze(out, gathered_axes);
+
+    // gather puts the broadcast index dimensions first; adjacent advanced
+    // indices keep them where the first one was.
+    const int position = static_cast<int>(layout.advanced_position - layout.newaxes_before_advanced);
+    if (position > 0) {
+      std::vector<int> order;
+      order.reserve(out.ndim());
+      for (int d = 0; d < position; ++d) {
+        order.push_back(advanced_ndim + d);
       }
-      widths.push_back({NUM2INT(lo), NUM2INT(hi)});
+      for (int d = 0; d < advanced_ndim; ++d) {
+        order.push_back(d);
+      }
+      for (int d = advanced_ndim + position; d < static_cast<int>(out.ndim()); ++d) {
+        order.push_back(d);
+      }
+      out = mx::transpose(out, order);
     }
-    if (widths.size() == 1) {
-      return array_wrap(mx::pad(a, widths[0], pad_value, mode_v));
+  }
+
+  if (!layout.newaxis_positions.empty()) {
+    out = mx::expand_dims(out, layout.newaxis_positions);
+  }
+  return out;
+}
+
+static VALUE array_aref(int argc, VALUE* argv, VALUE self) {
+  if (argc < 1) {
+    rb_error_arity(argc, 1, UNLIMITED_ARGUMENTS);
+  }
+  try {
+    ArrayWrapper* wrapper = array_wrapper_get(self);
+
+    // x[i] is the hot path of every iteration loop; skip the general parser.
+    if (argc == 1 && RB_INTEGER_TYPE_P(argv[0])) {
+      if (wrapper->array.ndim() == 0) {
+        rb_raise(rb_eArgError, "cannot index a scalar array");
+      }
+
+      int i = NUM2INT(argv[0]);
+      const int axis_size = wrapper->array.shape(0);
+      if (i < 0) {
+        i += axis_size;
+      }
+      if (i < 0 || i >= axis_size) {
+        rb_raise(rb_eIndexError, "index out of range");
+      }
+
+      mx::Shape start(wrapper->array.ndim(), 0);
+      mx::Shape stop = wrapper->array.shape();
+      start[0] = i;
+      stop[0] = i + 1;
+      return array_wrap(mx::squeeze(mx::slice(wrapper->array, start, stop), 0));
     }
-    return array_wrap(mx::pad(a, widths, pad_value, mode_v));
+
+    return array_wrap(array_get_item(wrapper->array, index_items_from_ruby(argc, argv)));
   } catch (const std::exception& error) {
-    raise_std_exception(error);
+    raise_index_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_unflatten(VALUE, VALUE array, VALUE axis, VALUE shape) {
+static VALUE core_array(int argc, VALUE* argv, VALUE) {
   try {
-    return array_wrap(mx::unflatten(array_unwrap(array), NUM2INT(axis), shape_from_ruby(shape)));
+    VALUE value;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "11", &value, &dtype);
+    return array_wrap(array_from_ruby(value, optional_dtype_from_value(dtype)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_as_strided(int argc, VALUE* argv, VALUE) {
+static mx::Shape shape_for_host_bytes(VALUE shape, size_t nbytes, const mx::Dtype& dtype) {
+  if (NIL_P(shape)) {
+    const size_t itemsize = static_cast<size_t>(dtype.size());
+    if (nbytes % itemsize != 0) {
+      rb_raise(rb_eArgError, "byte length %zu is not a multiple of the dtype size %zu", nbytes, itemsize);
+    }
+    return mx::Shape{static_cast<mx::ShapeElem>(nbytes / itemsize)};
+  }
+  if (RB_INTEGER_TYPE_P(shape)) {
+    VALUE dims = rb_ary_new_from_args(1, shape);
+    return shape_from_ruby(dims);
+  }
+  return shape_from_ruby(shape);
+}
+
+static VALUE core_from_bytes(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE array;
+    VALUE data;
     VALUE shape;
-    VALUE strides;
-    VALUE offset;
-    rb_scan_args(argc, argv, "31", &array, &shape, &strides, &offset);
-    const size_t offset_v = NIL_P(offset) ? 0 : static_cast<size_t>(NUM2ULL(offset));
-    return array_wrap(mx::as_strided(
-        array_unwrap(array),
-        shape_from_ruby(shape),
-        strides_from_ruby(strides),
-        offset_v));
+    VALUE dtype;
+    rb_scan_args(argc, argv, "12", &data, &shape, &dtype);
+
+    StringValue(data);
+    const mx::Dtype dtype_v = optional_dtype_from_value(dtype).value_or(mx::float32);
+    const size_t nbytes = static_cast<size_t>(RSTRING_LEN(data));
+    const mx::Shape shape_v = shape_for_host_bytes(shape, nbytes, dtype_v);
+    const size_t expected = checked_byte_count(shape_v, dtype_v);
+    if (expected != nbytes) {
+      rb_raise(
+          rb_eArgError,
+          "from_bytes expected %zu bytes for the requested shape and dtype, got %zu",
+          expected,
+          nbytes);
+    }
+
+    const char* src = RSTRING_PTR(data);
+    auto out = array_from_host_fill(shape_v, dtype_v, [src](void* dst, size_t n) {
+      std::memcpy(dst, src, n);
+    });
+    RB_GC_GUARD(data);
+    return array_wrap(out);
+  } catch (const std::invalid_argument& error) {
+    rb_raise(rb_eArgError, "%s", error.what());
+    return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_concatenate(int argc, VALUE* argv, VALUE) {
+static VALUE io_position_protected(VALUE io) {
+  return rb_funcall(io, cached_intern_id("pos"), 0);
+}
+
+struct FromIoReadError : std::exception {
+  FromIoReadError(int error_number, size_t expected, size_t read)
+      : error_number(error_number), expected(expected), read(read) {}
+  const char* what() const noexcept override {
+    return "from_io read failed";
+  }
+  int error_number;
+  size_t expected;
+  size_t read;
+};
+
+static VALUE core_from_io(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE arrays;
-    VALUE axis;
-    rb_scan_args(argc, argv, "11", &arrays, &axis);
-    auto values = array_vector_from_ruby(arrays);
-    if (NIL_P(axis)) {
-      return array_wrap(mx::concatenate(std::move(values)));
-    }
-    return array_wrap(mx::concatenate(std::move(values), NUM2INT(axis)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
-  }
-}
+    VALUE io;
+    VALUE shape;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "21", &io, &shape, &dtype);
 
-static VALUE core_concat(int argc, VALUE* argv, VALUE self) {
-  return core_concatenate(argc, argv, self);
-}
+    if (NIL_P(shape)) {
+      rb_raise(rb_eArgError, "from_io requires a shape");
+    }
+    const mx::Dtype dtype_v = optional_dtype_from_value(dtype).value_or(mx::float32);
+    const mx::Shape shape_v = shape_for_host_bytes(shape, 0, dtype_v);
+    const size_t nbytes = checked_byte_count(shape_v, dtype_v);
+
+    // Seekable IO objects are read with pread(2) from the logical position
+    // (which accounts for Ruby's own read buffer) without holding the GVL.
+    // Anything else (pipes, StringIO, custom readers) falls back to #read.
+    int state = 0;
+    VALUE position = Qnil;
+    if (RB_TYPE_P(io, T_FILE)) {
+      position = rb_protect(io_position_protected, io, &state);
+      if (state != 0) {
+        rb_set_errinfo(Qnil);
+        position = Qnil;
+      }
+    }
 
-static VALUE core_stack(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE arrays;
-    VALUE axis;
-    rb_scan_args(argc, argv, "11", &arrays, &axis);
-    auto values = array_vector_from_ruby(arrays);
-    if (NIL_P(axis)) {
-      return array_wrap(mx::stack(values));
+    if (NIL_P(position)) {
+      VALUE data = rb_funcall(io, cached_intern_id("read"), 1, SIZET2NUM(nbytes));
+      if (NIL_P(data)) {
+        data = rb_str_new(nullptr, 0);
+      }
+      VALUE forwarded[3] = {data, shape, dtype};
+      return core_from_bytes(3, forwarded, Qnil);
     }
-    return array_wrap(mx::stack(values, NUM2INT(axis)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
-  }
-}
 
-static VALUE core_split(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE split_spec;
-    VALUE axis;
-    rb_scan_args(argc, argv, "21", &array, &split_spec, &axis);
+    const int fd = NUM2INT(rb_funcall(io, cached_intern_id("fileno"), 0));
+    const off_t offset = static_cast<off_t>(NUM2LL(position));
 
-    auto a = array_unwrap(array);
-    if (RB_INTEGER_TYPE_P(split_spec)) {
-      const int parts = NUM2INT(split_spec);
-      if (NIL_P(axis)) {
-        return ruby_array_of_arrays(mx::split(a, parts));
+    struct CoreFromIoPayload {
+      int fd;
+      off_t offset;
+      void* dst;
+      size_t nbytes;
+      size_t read;
+      int error_number;
+    };
+    auto core_from_io_read = [](void* arg) -> void* {
+      auto* payload = reinterpret_cast<CoreFromIoPayload*>(arg);
+      auto* dst = static_cast<char*>(payload->dst);
+      while (payload->read < payload->nbytes) {
+        const ssize_t n = ::pread(
+            payload->fd,
+            dst + payload->read,
+            payload->nbytes - payload->read,
+            payload->offset + static_cast<off_t>(payload->read));
+        if (n < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          payload->error_number = errno;
+          break;
+        }
+        if (n == 0) {
+          break;
+        }
+        payload->read += static_cast<size_t>(n);
       }
-      return ruby_array_of_arrays(mx::split(a, parts, NUM2INT(axis)));
-    }
+      return nullptr;
+    };
 
-    auto indices = shape_from_ruby(split_spec);
-    if (NIL_P(axis)) {
-      return ruby_array_of_arrays(mx::split(a, indices));
+    // A failed or short read throws from inside the fill so the buffer is
+    // released before the Ruby exception is raised below.
+    CoreFromIoPayload payload{fd, offset, nullptr, nbytes, 0, 0};
+    VALUE result = array_wrap(array_from_host_fill(shape_v, dtype_v, [&](void* dst, size_t) {
+      payload.dst = dst;
+      call_with_gvl_policy(GvlWork::IO, [&]() { core_from_io_read(&payload); });
+      if (payload.error_number != 0 || payload.read != payload.nbytes) {
+        throw FromIoReadError{payload.error_number, payload.nbytes, payload.read};
+      }
+    }));
+    rb_funcall(io, cached_intern_id("seek"), 1, LL2NUM(static_cast<long long>(offset) + static_cast<long long>(nbytes)));
+    return result;
+  } catch (const FromIoReadError& error) {
+    if (error.error_number != 0) {
+      rb_syserr_fail(error.error_number, "from_io");
     }
-    return ruby_array_of_arrays(mx::split(a, indices, NUM2INT(axis)));
+    rb_raise(rb_eEOFError, "from_io expected %zu bytes, got %zu before end of file", error.expected, error.read);
+    return Qnil;
+  } catch (const std::invalid_argument& error) {
+    rb_raise(rb_eArgError, "%s", error.what());
+    return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_repeat(int argc, VALUE* argv, VALUE) {
+static VALUE core_broadcast_shapes(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE array;
-    VALUE repeats;
-    VALUE axis;
-    rb_scan_args(argc, argv, "21", &array, &repeats, &axis);
+    if (argc == 0) {
+      rb_raise(rb_eArgError, "broadcast_shapes expects at least one shape");
+    }
 
-    auto a = array_unwrap(array);
-    const int repeats_v = NUM2INT(repeats);
-    if (NIL_P(axis)) {
-      return array_wrap(mx::repeat(a, repeats_v));
+    auto result = shape_from_ruby(argv[0]);
+    for (int i = 1; i < argc; ++i) {
+      result = mx::broadcast_shapes(result, shape_from_ruby(argv[i]));
     }
-    return array_wrap(mx::repeat(a, repeats_v, NUM2INT(axis)));
+
+    VALUE out = rb_ary_new_capa(static_cast<long>(result.size()));
+    for (auto dim : result) {
+      rb_ary_push(out, INT2NUM(dim));
+    }
+    return out;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_tile(VALUE, VALUE array, VALUE reps) {
+static VALUE core_add(VALUE, VALUE a, VALUE b) {
   try {
-    auto a = array_unwrap(array);
-    std::vector<int> reps_v;
-    if (RB_INTEGER_TYPE_P(reps)) {
-      reps_v = {NUM2INT(reps)};
-    } else {
-      reps_v = int_vector_from_ruby(reps);
-    }
-    return array_wrap(mx::tile(a, reps_v));
+    BinaryOperands operands = binary_operands(a, b);
+    const mx::array& lhs = operands.lhs;
+    const mx::array& rhs = operands.rhs;
+    return array_wrap(call_with_gvl_policy(GvlWork::Graph, [&]() { return mx::add(lhs, rhs); }));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_meshgrid(int argc, VALUE* argv, VALUE) {
+static VALUE core_subtract(VALUE, VALUE a, VALUE b) {
   try {
-    VALUE arrays;
-    VALUE sparse;
-    VALUE indexing;
-    rb_scan_args(argc, argv, "12", &arrays, &sparse, &indexing);
-
-    auto values = array_vector_from_ruby(arrays);
-    const bool sparse_v = NIL_P(sparse) ? false : RTEST(sparse);
-    const std::string indexing_v = NIL_P(indexing) ? "xy" : StringValueCStr(indexing);
-
-    return ruby_array_of_arrays(mx::meshgrid(values, sparse_v, indexing_v));
+    BinaryOperands operands = binary_operands(a, b);
+    const mx::array& lhs = operands.lhs;
+    const mx::array& rhs = operands.rhs;
+    return array_wrap(call_with_gvl_policy(GvlWork::Graph, [&]() { return mx::subtract(lhs, rhs); }));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_roll(int argc, VALUE* argv, VALUE) {
+static VALUE core_multiply(VALUE, VALUE a, VALUE b) {
   try {
-    VALUE array;
-    VALUE shift;
-    VALUE axis;
-    rb_scan_args(argc, argv, "21", &array, &shift, &axis);
-
-    auto a = array_unwrap(array);
-    if (RB_INTEGER_TYPE_P(shift)) {
-      const int shift_v = NUM2INT(shift);
-      if (NIL_P(axis)) {
-        return array_wrap(mx::roll(a, shift_v));
-      }
-      if (RB_INTEGER_TYPE_P(axis)) {
-        return array_wrap(mx::roll(a, shift_v, NUM2INT(axis)));
-      }
-      return array_wrap(mx::roll(a, shift_v, int_vector_from_ruby(axis)));
-    }
-
-    auto shifts_i = int_vector_from_ruby(shift);
-    mx::Shape shifts;
-    shifts.reserve(shifts_i.size());
-    for (int value : shifts_i) {
-      shifts.push_back(static_cast<mx::ShapeElem>(value));
-    }
-
-    if (NIL_P(axis)) {
-      return array_wrap(mx::roll(a, shifts));
-    }
-    if (RB_INTEGER_TYPE_P(axis)) {
-      return array_wrap(mx::roll(a, shifts, NUM2INT(axis)));
-    }
-    return array_wrap(mx::roll(a, shifts, int_vector_from_ruby(axis)));
+    BinaryOperands operands = binary_operands(a, b);
+    const mx::array& lhs = operands.lhs;
+    const mx::array& rhs = operands.rhs;
+    return array_wrap(call_with_gvl_policy(GvlWork::Graph, [&]() { return mx::multiply(lhs, rhs); }));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_stop_gradient(VALUE, VALUE array) {
+static VALUE core_divide(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::stop_gradient(array_unwrap(array)));
+    BinaryOperands operands = binary_operands(a, b);
+    const mx::array& lhs = operands.lhs;
+    const mx::array& rhs = operands.rhs;
+    return array_wrap(call_with_gvl_policy(GvlWork::Graph, [&]() { return mx::divide(lhs, rhs); }));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_conjugate(VALUE, VALUE array) {
+static VALUE core_power(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::conjugate(array_unwrap(array)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::power(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_real(VALUE, VALUE array) {
+static VALUE core_remainder(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::real(array_unwrap(array)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::remainder(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_imag(VALUE, VALUE array) {
+static VALUE core_divmod(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::imag(array_unwrap(array)));
+    BinaryOperands operands = binary_operands(a, b);
+    auto result = mx::divmod(operands.lhs, operands.rhs);
+    VALUE out = rb_ary_new_capa(2);
+    if (result.size() != 2) {
+      rb_raise(rb_eRuntimeError, "divmod returned unexpected number of outputs");
+    }
+    rb_ary_push(out, array_wrap(result[0]));
+    rb_ary_push(out, array_wrap(result[1]));
+    return out;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_contiguous(int argc, VALUE* argv, VALUE) {
+static VALUE core_slice(int argc, VALUE* argv, VALUE) {
   try {
     VALUE array;
-    VALUE allow_col_major;
-    rb_scan_args(argc, argv, "11", &array, &allow_col_major);
-    const bool allow_col_major_v = NIL_P(allow_col_major) ? false : RTEST(allow_col_major);
-    return array_wrap(mx::contiguous(array_unwrap(array), allow_col_major_v));
+    VALUE start;
+    VALUE stop;
+    VALUE strides;
+    rb_scan_args(argc, argv, "31", &array, &start, &stop, &strides);
+
+    auto a = array_unwrap(array);
+    auto start_shape = shape_from_ruby(start);
+    auto stop_shape = shape_from_ruby(stop);
+
+    if (NIL_P(strides)) {
+      return array_wrap(mx::slice(a, start_shape, stop_shape));
+    }
+    auto stride_shape = shape_from_ruby(strides);
+    return array_wrap(mx::slice(a, start_shape, stop_shape, stride_shape));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_view(VALUE, VALUE array, VALUE dtype) {
+static VALUE core_slice_update(int argc, VALUE* argv, VALUE) {
   try {
-    auto target_dtype = optional_dtype_from_value(dtype);
-    if (!target_dtype.has_value()) {
-      rb_raise(rb_eArgError, "view requires a dtype");
+    VALUE src;
+    VALUE update;
+    VALUE start;
+    VALUE stop;
+    VALUE strides;
+    rb_scan_args(argc, argv, "41", &src, &update, &start, &stop, &strides);
+
+    auto src_a = array_unwrap(src);
+    auto update_a = array_unwrap(update);
+    auto start_shape = shape_from_ruby(start);
+    auto stop_shape = shape_from_ruby(stop);
+    if (NIL_P(strides)) {
+      return array_wrap(mx::slice_update(src_a, update_a, start_shape, stop_shape));
     }
-    return array_wrap(mx::view(array_unwrap(array), target_dtype.value()));
+    auto stride_shape = shape_from_ruby(strides);
+    return array_wrap(mx::slice_update(src_a, update_a, start_shape, stop_shape, stride_shape));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_matmul(VALUE, VALUE a, VALUE b) {
+static VALUE core_take(int argc, VALUE* argv, VALUE) {
   try {
-    mx::array lhs = array_unwrap(a);
-    mx::array rhs = array_unwrap(b);
-    return array_wrap(call_mx_array_without_gvl([&]() { return mx::matmul(lhs, rhs); }));
+    VALUE array;
+    VALUE indices;
+    VALUE axis;
+    rb_scan_args(argc, argv, "21", &array, &indices, &axis);
+    auto a = array_unwrap(array);
+
+    if (RB_INTEGER_TYPE_P(indices)) {
+      const int idx = NUM2INT(indices);
+      if (NIL_P(axis)) {
+        return array_wrap(mx::take(a, idx));
+      }
+      return array_wrap(mx::take(a, idx, NUM2INT(axis)));
+    }
+
+    auto idx_array = RB_TYPE_P(indices, T_ARRAY)
+        ? array_from_ruby(indices, std::make_optional(mx::int32))
+        : array_from_ruby(indices, std::nullopt);
+    if (NIL_P(axis)) {
+      return array_wrap(mx::take(a, idx_array));
+    }
+    return array_wrap(mx::take(a, idx_array, NUM2INT(axis)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_addmm(int argc, VALUE* argv, VALUE) {
+static VALUE core_take_along_axis(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE c;
-    VALUE a;
-    VALUE b;
-    VALUE alpha;
-    VALUE beta;
-    rb_scan_args(argc, argv, "32", &c, &a, &b, &alpha, &beta);
+    VALUE array;
+    VALUE indices;
+    VALUE axis;
+    rb_scan_args(argc, argv, "21", &array, &indices, &axis);
 
-    const float alpha_v = NIL_P(alpha) ? 1.0f : static_cast<float>(NUM2DBL(alpha));
-    const float beta_v = NIL_P(beta) ? 1.0f : static_cast<float>(NUM2DBL(beta));
-    return array_wrap(mx::addmm(
-        array_from_ruby(c, std::nullopt),
-        array_from_ruby(a, std::nullopt),
-        array_from_ruby(b, std::nullopt),
-        alpha_v,
-        beta_v));
+    auto a = array_unwrap(array);
+    auto idx = RB_TYPE_P(indices, T_ARRAY)
+        ? array_from_ruby(indices, std::make_optional(mx::int32))
+        : array_from_ruby(indices, std::nullopt);
+
+    if (NIL_P(axis)) {
+      auto flat = mx::reshape(a, mx::Shape{-1});
+      return array_wrap(mx::take_along_axis(flat, idx, 0));
+    }
+    return array_wrap(mx::take_along_axis(a, idx, NUM2INT(axis)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_block_masked_mm(int argc, VALUE* argv, VALUE) {
+static VALUE core_put_along_axis(int argc, VALUE* argv, VALUE) {
   try {
-    if (argc < 2 || argc > 6) {
-      rb_raise(rb_eArgError, "block_masked_mm expects 2 to 6 arguments");
-    }
-
-    const auto a = array_from_ruby(argv[0], std::nullopt);
-    const auto b = array_from_ruby(argv[1], std::nullopt);
-    const int block_size =
-        (argc >= 3 && !NIL_P(argv[2])) ? NUM2INT(argv[2]) : 64;
+    VALUE array;
+    VALUE indices;
+    VALUE values;
+    VALUE axis;
+    rb_scan_args(argc, argv, "31", &array, &indices, &values, &axis);
 
-    std::optional<mx::array> mask_out = std::nullopt;
-    std::optional<mx::array> mask_lhs = std::nullopt;
-    std::optional<mx::array> mask_rhs = std::nullopt;
+    auto a = array_unwrap(array);
+    auto idx = RB_TYPE_P(indices, T_ARRAY)
+        ? array_from_ruby(indices, std::make_optional(mx::int32))
+        : array_from_ruby(indices, std::nullopt);
+    auto vals = array_from_ruby(values, std::nullopt);
 
-    if (argc >= 4 && !NIL_P(argv[3])) {
-      mask_out = array_from_ruby(argv[3], std::nullopt);
-    }
-    if (argc >= 5 && !NIL_P(argv[4])) {
-      mask_lhs = array_from_ruby(argv[4], std::nullopt);
-    }
-    if (argc >= 6 && !NIL_P(argv[5])) {
-      mask_rhs = array_from_ruby(argv[5], std::nullopt);
+    if (NIL_P(axis)) {
+      auto flat = mx::reshape(a, mx::Shape{-1});
+      auto updated = mx::put_along_axis(flat, idx, vals, 0);
+      return array_wrap(mx::reshape(updated, a.shape()));
     }
-
-    return array_wrap(mx::block_masked_mm(
-        a,
-        b,
-        block_size,
-        mask_out,
-        mask_lhs,
-        mask_rhs));
+    return array_wrap(mx::put_along_axis(a, idx, vals, NUM2INT(axis)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_gather_mm(int argc, VALUE* argv, VALUE) {
+static VALUE core_pad(int argc, VALUE* argv, VALUE) {
   try {
-    if (argc < 2 || argc > 5) {
-      rb_raise(rb_eArgError, "gather_mm expects 2 to 5 arguments");
+    VALUE array;
+    VALUE pad_width;
+    VALUE mode;
+    VALUE constant_values;
+    rb_scan_args(argc, argv, "22", &array, &pad_width, &mode, &constant_values);
+
+    auto a = array_unwrap(array);
+    auto pad_value = NIL_P(constant_values)
+        ? mx::array(0)
+        : array_from_ruby(constant_values, std::nullopt);
+    const std::string mode_v = NIL_P(mode) ? "constant" : StringValueCStr(mode);
+
+    if (RB_INTEGER_TYPE_P(pad_width)) {
+      return array_wrap(mx::pad(a, NUM2INT(pad_width), pad_value, mode_v));
     }
 
-    const auto a = array_from_ruby(argv[0], std::nullopt);
-    const auto b = array_from_ruby(argv[1], std::nullopt);
-    std::optional<mx::array> lhs_indices = std::nullopt;
-    std::optional<mx::array> rhs_indices = std::nullopt;
+    if (!RB_TYPE_P(pad_width, T_ARRAY)) {
+      rb_raise(
+          rb_eTypeError,
+          "pad_width must be an Integer, [before, after], or [[before, after], ...]");
+    }
 
-    if (argc >= 3 && !NIL_P(argv[2])) {
-      lhs_indices = array_from_ruby(argv[2], std::nullopt);
+    const long len = RARRAY_LEN(pad_width);
+    if (len == 0) {
+      rb_raise(rb_eArgError, "pad_width must not be empty");
     }
-    if (argc >= 4 && !NIL_P(argv[3])) {
-      rhs_indices = array_from_ruby(argv[3], std::nullopt);
+
+    VALUE first = rb_ary_entry(pad_width, 0);
+    if (RB_INTEGER_TYPE_P(first)) {
+      if (len == 1) {
+        return array_wrap(mx::pad(a, NUM2INT(first), pad_value, mode_v));
+      }
+      if (len != 2 || !RB_INTEGER_TYPE_P(rb_ary_entry(pad_width, 1))) {
+        rb_raise(rb_eTypeError, "pad_width array must be [before, after]");
+      }
+      std::pair<int, int> pair{NUM2INT(first), NUM2INT(rb_ary_entry(pad_width, 1))};
+      return array_wrap(mx::pad(a, pair, pad_value, mode_v));
     }
 
-    const bool sorted_indices = (argc >= 5) ? RTEST(argv[4]) : false;
-    return array_wrap(mx::gather_mm(a, b, lhs_indices, rhs_indices, sorted_indices));
+    std::vector<std::pair<int, int>> widths;
+    widths.reserve(static_cast<size_t>(len));
+    for (long i = 0; i < len; ++i) {
+      VALUE entry = rb_ary_entry(pad_width, i);
+      if (!RB_TYPE_P(entry, T_ARRAY) || RARRAY_LEN(entry) != 2) {
+        rb_raise(
+            rb_eTypeError,
+            "pad_width nested form must be [[before, after], ...]");
+      }
+      VALUE lo = rb_ary_entry(entry, 0);
+      VALUE hi = rb_ary_entry(entry, 1);
+      if (!RB_INTEGER_TYPE_P(lo) || !RB_INTEGER_TYPE_P(hi)) {
+        rb_raise(rb_eTypeError, "pad_width entries must be integers");
+      }
+      widths.push_back({NUM2INT(lo), NUM2INT(hi)});
+    }
+    if (widths.size() == 1) {
+      return array_wrap(mx::pad(a, widths[0], pad_value, mode_v));
+    }
+    return array_wrap(mx::pad(a, widths, pad_value, mode_v));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_segmented_mm(VALUE, VALUE a, VALUE b, VALUE segments) {
+static VALUE core_unflatten(VALUE, VALUE array, VALUE axis, VALUE shape) {
   try {
-    return array_wrap(mx::segmented_mm(
-        array_from_ruby(a, std::nullopt),
-        array_from_ruby(b, std::nullopt),
-        array_from_ruby(segments, std::nullopt)));
+    return array_wrap(mx::unflatten(array_unwrap(array), NUM2INT(axis), shape_from_ruby(shape)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_hadamard_transform(int argc, VALUE* argv, VALUE) {
+static VALUE core_as_strided(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE a;
-    VALUE scale;
-    rb_scan_args(argc, argv, "11", &a, &scale);
-    std::optional<float> scale_v = NIL_P(scale)
-        ? std::nullopt
-        : std::make_optional(static_cast<float>(NUM2DBL(scale)));
-    return array_wrap(mx::hadamard_transform(array_from_ruby(a, std::nullopt), scale_v));
+    VALUE array;
+    VALUE shape;
+    VALUE strides;
+    VALUE offset;
+    rb_scan_args(argc, argv, "31", &array, &shape, &strides, &offset);
+    const size_t offset_v = NIL_P(offset) ? 0 : static_cast<size_t>(NUM2ULL(offset));
+    return array_wrap(mx::as_strided(
+        array_unwrap(array),
+        shape_from_ruby(shape),
+        strides_from_ruby(strides),
+        offset_v));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_convolve(int argc, VALUE* argv, VALUE) {
+static VALUE core_concatenate(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE a;
-    VALUE v;
-    VALUE mode;
-    rb_scan_args(argc, argv, "21", &a, &v, &mode);
-
-    const std::string mode_v = NIL_P(mode) ? "full" : StringValueCStr(mode);
-    auto lhs = array_from_ruby(a, std::nullopt);
-    auto rhs = array_from_ruby(v, std::nullopt);
-    if (lhs.ndim() != 1 || rhs.ndim() != 1) {
-      rb_raise(rb_eArgError, "convolve inputs must be 1D");
-    }
-    if (lhs.size() == 0 || rhs.size() == 0) {
-      rb_raise(rb_eArgError, "convolve inputs cannot be empty");
+    VALUE arrays;
+    VALUE axis;
+    rb_scan_args(argc, argv, "11", &arrays, &axis);
+    auto values = array_vector_from_ruby(arrays);
+    if (NIL_P(axis)) {
+      return array_wrap(mx::concatenate(std::move(values)));
     }
+    return array_wrap(mx::concatenate(std::move(values), NUM2INT(axis)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
 
-    mx::array in = lhs.size() < rhs.size() ? rhs : lhs;
-    mx::array wt = lhs.size() < rhs.size() ? lhs : rhs;
+static VALUE core_concat(int argc, VALUE* argv, VALUE self) {
+  return core_concatenate(argc, argv, self);
+}
 
-    const int wt_size = static_cast<int>(wt.shape(0));
-    wt = mx::slice(wt, {wt_size - 1}, {-wt_size - 1}, {-1});
-    in = mx::reshape(in, {1, -1, 1});
-    wt = mx::reshape(wt, {1, -1, 1});
+static VALUE core_stack(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE arrays;
+    VALUE axis;
+    rb_scan_args(argc, argv, "11", &arrays, &axis);
+    auto values = array_vector_from_ruby(arrays);
+    if (NIL_P(axis)) {
+      return array_wrap(mx::stack(values));
+    }
+    return array_wrap(mx::stack(values, NUM2INT(axis)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
 
-    int padding = 0;
-    if (mode_v == "full") {
-      padding = static_cast<int>(wt.size()) - 1;
-    } else if (mode_v == "valid") {
-      padding = 0;
-    } else if (mode_v == "same") {
-      if ((wt.size() % 2) != 0) {
-        padding = static_cast<int>(wt.size() / 2);
-      } else {
-        const int pad_l = static_cast<int>(wt.size() / 2);
-        const int pad_r = std::max(0, pad_l - 1);
-        in = mx::pad(
-            in,
-            std::vector<std::pair<int, int>>{{0, 0}, {pad_l, pad_r}, {0, 0}},
-            mx::array(0),
-            "constant");
+static VALUE core_split(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE array;
+    VALUE split_spec;
+    VALUE axis;
+    rb_scan_args(argc, argv, "21", &array, &split_spec, &axis);
+
+    auto a = array_unwrap(array);
+    if (RB_INTEGER_TYPE_P(split_spec)) {
+      const int parts = NUM2INT(split_spec);
+      if (NIL_P(axis)) {
+        return ruby_array_of_arrays(mx::split(a, parts));
       }
-    } else {
-      rb_raise(rb_eArgError, "convolve mode must be one of: full, valid, same");
+      return ruby_array_of_arrays(mx::split(a, parts, NUM2INT(axis)));
     }
 
-    auto out = mx::conv1d(in, wt, 1, padding, 1, 1);
-    return array_wrap(mx::reshape(out, {-1}));
+    auto indices = shape_from_ruby(split_spec);
+    if (NIL_P(axis)) {
+      return ruby_array_of_arrays(mx::split(a, indices));
+    }
+    return ruby_array_of_arrays(mx::split(a, indices, NUM2INT(axis)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_conv1d(int argc, VALUE* argv, VALUE) {
+static VALUE core_repeat(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE input;
-    VALUE weight;
-    VALUE stride;
-    VALUE padding;
-    VALUE dilation;
-    VALUE groups;
-    rb_scan_args(argc, argv, "24", &input, &weight, &stride, &padding, &dilation, &groups);
-
-    const int stride_v = NIL_P(stride) ? 1 : NUM2INT(stride);
-    const int padding_v = NIL_P(padding) ? 0 : NUM2INT(padding);
-    const int dilation_v = NIL_P(dilation) ? 1 : NUM2INT(dilation);
-    const int groups_v = NIL_P(groups) ? 1 : NUM2INT(groups);
+    VALUE array;
+    VALUE repeats;
+    VALUE axis;
+    rb_scan_args(argc, argv, "21", &array, &repeats, &axis);
 
-    return array_wrap(mx::conv1d(
-        array_from_ruby(input, std::nullopt),
-        array_from_ruby(weight, std::nullopt),
-        stride_v,
-        padding_v,
-        dilation_v,
-        groups_v));
+    auto a = array_unwrap(array);
+    const int repeats_v = NUM2INT(repeats);
+    if (NIL_P(axis)) {
+      return array_wrap(mx::repeat(a, repeats_v));
+    }
+    return array_wrap(mx::repeat(a, repeats_v, NUM2INT(axis)));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_conv2d(int argc, VALUE* argv, VALUE) {
+static VALUE core_tile(VALUE, VALUE array, VALUE reps) {
+  try {
+    auto a = array_unwrap(array);
+    std::vector<int> reps_v;
+    if (RB_INTEGER_TYPE_P(reps)) {
+      reps_v = {NUM2INT(reps)};
+    } else {
+      reps_v = int_vector_from_ruby(reps);
+    }
+    return array_wrap(mx::tile(a, reps_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_meshgrid(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE arrays;
+    VALUE sparse;
+    VALUE indexing;
+    rb_scan_args(argc, argv, "12", &arrays, &sparse, &indexing);
+
+    auto values = array_vector_from_ruby(arrays);
+    const bool sparse_v = NIL_P(sparse) ? false : RTEST(sparse);
+    const std::string indexing_v = NIL_P(indexing) ? "xy" : StringValueCStr(indexing);
+
+    return ruby_array_of_arrays(mx::meshgrid(values, sparse_v, indexing_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_roll(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE array;
+    VALUE shift;
+    VALUE axis;
+    rb_scan_args(argc, argv, "21", &array, &shift, &axis);
+
+    auto a = array_unwrap(array);
+    if (RB_INTEGER_TYPE_P(shift)) {
+      const int shift_v = NUM2INT(shift);
+      if (NIL_P(axis)) {
+        return array_wrap(mx::roll(a, shift_v));
+      }
+      if (RB_INTEGER_TYPE_P(axis)) {
+        return array_wrap(mx::roll(a, shift_v, NUM2INT(axis)));
+      }
+      return array_wrap(mx::roll(a, shift_v, int_vector_from_ruby(axis)));
+    }
+
+    auto shifts_i = int_vector_from_ruby(shift);
+    mx::Shape shifts;
+    shifts.reserve(shifts_i.size());
+    for (int value : shifts_i) {
+      shifts.push_back(static_cast<mx::ShapeElem>(value));
+    }
+
+    if (NIL_P(axis)) {
+      return array_wrap(mx::roll(a, shifts));
+    }
+    if (RB_INTEGER_TYPE_P(axis)) {
+      return array_wrap(mx::roll(a, shifts, NUM2INT(axis)));
+    }
+    return array_wrap(mx::roll(a, shifts, int_vector_from_ruby(axis)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_stop_gradient(VALUE, VALUE array) {
+  try {
+    return array_wrap(mx::stop_gradient(array_unwrap(array)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_conjugate(VALUE, VALUE array) {
+  try {
+    return array_wrap(mx::conjugate(array_unwrap(array)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_real(VALUE, VALUE array) {
+  try {
+    return array_wrap(mx::real(array_unwrap(array)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_imag(VALUE, VALUE array) {
+  try {
+    return array_wrap(mx::imag(array_unwrap(array)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_contiguous(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE array;
+    VALUE allow_col_major;
+    rb_scan_args(argc, argv, "11", &array, &allow_col_major);
+    const bool allow_col_major_v = NIL_P(allow_col_major) ? false : RTEST(allow_col_major);
+    return array_wrap(mx::contiguous(array_unwrap(array), allow_col_major_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_view(VALUE, VALUE array, VALUE dtype) {
+  try {
+    auto target_dtype = optional_dtype_from_value(dtype);
+    if (!target_dtype.has_value()) {
+      rb_raise(rb_eArgError, "view requires a dtype");
+    }
+    return array_wrap(mx::view(array_unwrap(array), target_dtype.value()));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_matmul(VALUE, VALUE a, VALUE b) {
+  try {
+    mx::array lhs = array_unwrap(a);
+    mx::array rhs = array_unwrap(b);
+    return array_wrap(call_with_gvl_policy(GvlWork::Graph, [&]() { return mx::matmul(lhs, rhs); }));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_addmm(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE c;
+    VALUE a;
+    VALUE b;
+    VALUE alpha;
+    VALUE beta;
+    rb_scan_args(argc, argv, "32", &c, &a, &b, &alpha, &beta);
+
+    const float alpha_v = NIL_P(alpha) ? 1.0f : static_cast<float>(NUM2DBL(alpha));
+    const float beta_v = NIL_P(beta) ? 1.0f : static_cast<float>(NUM2DBL(beta));
+    return array_wrap(mx::addmm(
+        array_from_ruby(c, std::nullopt),
+        array_from_ruby(a, std::nullopt),
+        array_from_ruby(b, std::nullopt),
+        alpha_v,
+        beta_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_block_masked_mm(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 2 || argc > 6) {
+      rb_raise(rb_eArgError, "block_masked_mm expects 2 to 6 arguments");
+    }
+
+    const auto a = array_from_ruby(argv[0], std::nullopt);
+    const auto b = array_from_ruby(argv[1], std::nullopt);
+    const int block_size =
+        (argc >= 3 && !NIL_P(argv[2])) ? NUM2INT(argv[2]) : 64;
+
+    std::optional<mx::array> mask_out = std::nullopt;
+    std::optional<mx::array> mask_lhs = std::nullopt;
+    std::optional<mx::array> mask_rhs = std::nullopt;
+
+    if (argc >= 4 && !NIL_P(argv[3])) {
+      mask_out = array_from_ruby(argv[3], std::nullopt);
+    }
+    if (argc >= 5 && !NIL_P(argv[4])) {
+      mask_lhs = array_from_ruby(argv[4], std::nullopt);
+    }
+    if (argc >= 6 && !NIL_P(argv[5])) {
+      mask_rhs = array_from_ruby(argv[5], std::nullopt);
+    }
+
+    return array_wrap(mx::block_masked_mm(
+        a,
+        b,
+        block_size,
+        mask_out,
+        mask_lhs,
+        mask_rhs));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_gather_mm(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 2 || argc > 5) {
+      rb_raise(rb_eArgError, "gather_mm expects 2 to 5 arguments");
+    }
+
+    const auto a = array_from_ruby(argv[0], std::nullopt);
+    const auto b = array_from_ruby(argv[1], std::nullopt);
+    std::optional<mx::array> lhs_indices = std::nullopt;
+    std::optional<mx::array> rhs_indices = std::nullopt;
+
+    if (argc >= 3 && !NIL_P(argv[2])) {
+      lhs_indices = array_from_ruby(argv[2], std::nullopt);
+    }
+    if (argc >= 4 && !NIL_P(argv[3])) {
+      rhs_indices = array_from_ruby(argv[3], std::nullopt);
+    }
+
+    const bool sorted_indices = (argc >= 5) ? RTEST(argv[4]) : false;
+    return array_wrap(mx::gather_mm(a, b, lhs_indices, rhs_indices, sorted_indices));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_segmented_mm(VALUE, VALUE a, VALUE b, VALUE segments) {
+  try {
+    return array_wrap(mx::segmented_mm(
+        array_from_ruby(a, std::nullopt),
+        array_from_ruby(b, std::nullopt),
+        array_from_ruby(segments, std::nullopt)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_hadamard_transform(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE a;
+    VALUE scale;
+    rb_scan_args(argc, argv, "11", &a, &scale);
+    std::optional<float> scale_v = NIL_P(scale)
+        ? std::nullopt
+        : std::make_optional(static_cast<float>(NUM2DBL(scale)));
+    return array_wrap(mx::hadamard_transform(array_from_ruby(a, std::nullopt), scale_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_convolve(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE a;
+    VALUE v;
+    VALUE mode;
+    rb_scan_args(argc, argv, "21", &a, &v, &mode);
+
+    const std::string mode_v = NIL_P(mode) ? "full" : StringValueCStr(mode);
+    auto lhs = array_from_ruby(a, std::nullopt);
+    auto rhs = array_from_ruby(v, std::nullopt);
+    if (lhs.ndim() != 1 || rhs.ndim() != 1) {
+      rb_raise(rb_eArgError, "convolve inputs must be 1D");
+    }
+    if (lhs.size() == 0 || rhs.size() == 0) {
+      rb_raise(rb_eArgError, "convolve inputs cannot be empty");
+    }
+
+    mx::array in = lhs.size() < rhs.size() ? rhs : lhs;
+    mx::array wt = lhs.size() < rhs.size() ? lhs : rhs;
+
+    const int wt_size = static_cast<int>(wt.shape(0));
+    wt = mx::slice(wt, {wt_size - 1}, {-wt_size - 1}, {-1});
+    in = mx::reshape(in, {1, -1, 1});
+    wt = mx::reshape(wt, {1, -1, 1});
+
+    int padding = 0;
+    if (mode_v == "full") {
+      padding = static_cast<int>(wt.size()) - 1;
+    } else if (mode_v == "valid") {
+      padding = 0;
+    } else if (mode_v == "same") {
+      if ((wt.size() % 2) != 0) {
+        padding = static_cast<int>(wt.size() / 2);
+      } else {
+        const int pad_l = static_cast<int>(wt.size() / 2);
+        const int pad_r = std::max(0, pad_l - 1);
+        in = mx::pad(
+            in,
+            std::vector<std::pair<int, int>>{{0, 0}, {pad_l, pad_r}, {0, 0}},
+            mx::array(0),
+            "constant");
+      }
+    } else {
+      rb_raise(rb_eArgError, "convolve mode must be one of: full, valid, same");
+    }
+
+    auto out = mx::conv1d(in, wt, 1, padding, 1, 1);
+    return array_wrap(mx::reshape(out, {-1}));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_conv1d(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE input;
+    VALUE weight;
+    VALUE stride;
+    VALUE padding;
+    VALUE dilation;
+    VALUE groups;
+    rb_scan_args(argc, argv, "24", &input, &weight, &stride, &padding, &dilation, &groups);
+
+    const int stride_v = NIL_P(stride) ? 1 : NUM2INT(stride);
+    const int padding_v = NIL_P(padding) ? 0 : NUM2INT(padding);
+    const int dilation_v = NIL_P(dilation) ? 1 : NUM2INT(dilation);
+    const int groups_v = NIL_P(groups) ? 1 : NUM2INT(groups);
+
+    return array_wrap(mx::conv1d(
+        array_from_ruby(input, std::nullopt),
+        array_from_ruby(weight, std::nullopt),
+        stride_v,
+        padding_v,
+        dilation_v,
+        groups_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_conv2d(int argc, VALUE* argv, VALUE) {
   try {
     VALUE input;
     VALUE weight;
@@ -3344,56 +5217,223 @@ static VALUE core_conv_transpose3d(int argc, VALUE* argv, VALUE) {
 
 static VALUE core_conv_general(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE input;
-    VALUE weight;
-    VALUE stride;
-    VALUE padding;
-    VALUE kernel_dilation;
-    VALUE input_dilation;
-    VALUE groups;
-    VALUE flip;
-    rb_scan_args(
-        argc,
-        argv,
-        "26",
-        &input,
-        &weight,
-        &stride,
-        &padding,
-        &kernel_dilation,
-        &input_dilation,
-        &groups,
-        &flip);
+    VALUE input;
+    VALUE weight;
+    VALUE stride;
+    VALUE padding;
+    VALUE kernel_dilation;
+    VALUE input_dilation;
+    VALUE groups;
+    VALUE flip;
+    rb_scan_args(
+        argc,
+        argv,
+        "26",
+        &input,
+        &weight,
+        &stride,
+        &padding,
+        &kernel_dilation,
+        &input_dilation,
+        &groups,
+        &flip);
+
+    auto stride_v = int_vector_from_ruby_or_scalar(stride, {1}, "stride");
+    auto [padding_lo_v, padding_hi_v] = conv_general_padding_from_ruby(padding);
+    auto kernel_dilation_v =
+        int_vector_from_ruby_or_scalar(kernel_dilation, {1}, "kernel_dilation");
+    auto input_dilation_v =
+        int_vector_from_ruby_or_scalar(input_dilation, {1}, "input_dilation");
+    const int groups_v = NIL_P(groups) ? 1 : NUM2INT(groups);
+    const bool flip_v = NIL_P(flip) ? false : RTEST(flip);
+
+    return array_wrap(mx::conv_general(
+        array_from_ruby(input, std::nullopt),
+        array_from_ruby(weight, std::nullopt),
+        std::move(stride_v),
+        std::move(padding_lo_v),
+        std::move(padding_hi_v),
+        std::move(kernel_dilation_v),
+        std::move(input_dilation_v),
+        groups_v,
+        flip_v));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_quantized_matmul(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 3 || argc > 8) {
+      rb_raise(rb_eArgError, "quantized_matmul expects 3 to 8 arguments");
+    }
+
+    const auto x = array_from_ruby(argv[0], std::nullopt);
+    const auto w = array_from_ruby(argv[1], std::nullopt);
+    const auto scales = array_from_ruby(argv[2], std::nullopt);
+
+    std::optional<mx::array> biases = std::nullopt;
+    bool transpose = true;
+    std::optional<int> group_size = std::nullopt;
+    std::optional<int> bits = std::nullopt;
+    std::string mode = "affine";
+
+    if (argc >= 4 && !NIL_P(argv[3])) {
+      biases = array_from_ruby(argv[3], std::nullopt);
+    }
+    if (argc >= 5 && !NIL_P(argv[4])) {
+      transpose = RTEST(argv[4]);
+    }
+    if (argc >= 6 && !NIL_P(argv[5])) {
+      group_size = NUM2INT(argv[5]);
+    }
+    if (argc >= 7 && !NIL_P(argv[6])) {
+      bits = NUM2INT(argv[6]);
+    }
+    if (argc >= 8 && !NIL_P(argv[7])) {
+      mode = StringValueCStr(argv[7]);
+    }
+
+    return array_wrap(mx::quantized_matmul(
+        x,
+        w,
+        scales,
+        biases,
+        transpose,
+        group_size,
+        bits,
+        mode));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_quantize(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 1 || argc > 4) {
+      rb_raise(rb_eArgError, "quantize expects 1 to 4 arguments");
+    }
+
+    const auto w = array_from_ruby(argv[0], std::nullopt);
+    std::optional<int> group_size = std::nullopt;
+    std::optional<int> bits = std::nullopt;
+    std::string mode = "affine";
+
+    if (argc >= 2 && !NIL_P(argv[1])) {
+      group_size = NUM2INT(argv[1]);
+    }
+    if (argc >= 3 && !NIL_P(argv[2])) {
+      bits = NUM2INT(argv[2]);
+    }
+    if (argc >= 4 && !NIL_P(argv[3])) {
+      mode = StringValueCStr(argv[3]);
+    }
+
+    return ruby_array_of_arrays(mx::quantize(w, group_size, bits, mode));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_dequantize(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 2 || argc > 7) {
+      rb_raise(rb_eArgError, "dequantize expects 2 to 7 arguments");
+    }
+
+    const auto w = array_from_ruby(argv[0], std::nullopt);
+    const auto scales = array_from_ruby(argv[1], std::nullopt);
+    std::optional<mx::array> biases = std::nullopt;
+    std::optional<int> group_size = std::nullopt;
+    std::optional<int> bits = std::nullopt;
+    std::string mode = "affine";
+    std::optional<mx::Dtype> dtype = std::nullopt;
+
+    if (argc >= 3 && !NIL_P(argv[2])) {
+      biases = array_from_ruby(argv[2], std::nullopt);
+    }
+    if (argc >= 4 && !NIL_P(argv[3])) {
+      group_size = NUM2INT(argv[3]);
+    }
+    if (argc >= 5 && !NIL_P(argv[4])) {
+      bits = NUM2INT(argv[4]);
+    }
+    if (argc >= 6 && !NIL_P(argv[5])) {
+      mode = StringValueCStr(argv[5]);
+    }
+    if (argc >= 7) {
+      dtype = optional_dtype_from_value(argv[6]);
+    }
+
+    return array_wrap(mx::dequantize(w, scales, biases, group_size, bits, mode, dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_from_fp8(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE x;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "11", &x, &dtype);
+    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::bfloat16);
+    return array_wrap(mx::from_fp8(array_from_ruby(x, std::nullopt), target_dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_to_fp8(VALUE, VALUE x) {
+  try {
+    return array_wrap(mx::to_fp8(array_from_ruby(x, std::nullopt)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_qqmm(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 2 || argc > 6) {
+      rb_raise(rb_eArgError, "qqmm expects 2 to 6 arguments");
+    }
 
-    auto stride_v = int_vector_from_ruby_or_scalar(stride, {1}, "stride");
-    auto [padding_lo_v, padding_hi_v] = conv_general_padding_from_ruby(padding);
-    auto kernel_dilation_v =
-        int_vector_from_ruby_or_scalar(kernel_dilation, {1}, "kernel_dilation");
-    auto input_dilation_v =
-        int_vector_from_ruby_or_scalar(input_dilation, {1}, "input_dilation");
-    const int groups_v = NIL_P(groups) ? 1 : NUM2INT(groups);
-    const bool flip_v = NIL_P(flip) ? false : RTEST(flip);
+    const auto x = array_from_ruby(argv[0], std::nullopt);
+    const auto w = array_from_ruby(argv[1], std::nullopt);
+    std::optional<mx::array> scales = std::nullopt;
+    std::optional<int> group_size = std::nullopt;
+    std::optional<int> bits = std::nullopt;
+    std::string mode = "nvfp4";
 
-    return array_wrap(mx::conv_general(
-        array_from_ruby(input, std::nullopt),
-        array_from_ruby(weight, std::nullopt),
-        std::move(stride_v),
-        std::move(padding_lo_v),
-        std::move(padding_hi_v),
-        std::move(kernel_dilation_v),
-        std::move(input_dilation_v),
-        groups_v,
-        flip_v));
+    if (argc >= 3 && !NIL_P(argv[2])) {
+      scales = array_from_ruby(argv[2], std::nullopt);
+    }
+    if (argc >= 4 && !NIL_P(argv[3])) {
+      group_size = NUM2INT(argv[3]);
+    }
+    if (argc >= 5 && !NIL_P(argv[4])) {
+      bits = NUM2INT(argv[4]);
+    }
+    if (argc >= 6 && !NIL_P(argv[5])) {
+      mode = StringValueCStr(argv[5]);
+    }
+
+    return array_wrap(mx::qqmm(x, w, scales, group_size, bits, mode));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_quantized_matmul(int argc, VALUE* argv, VALUE) {
+static VALUE core_gather_qmm(int argc, VALUE* argv, VALUE) {
   try {
-    if (argc < 3 || argc > 8) {
-      rb_raise(rb_eArgError, "quantized_matmul expects 3 to 8 arguments");
+    if (argc < 3 || argc > 11) {
+      rb_raise(rb_eArgError, "gather_qmm expects 3 to 11 arguments");
     }
 
     const auto x = array_from_ruby(argv[0], std::nullopt);
@@ -3401,234 +5441,1563 @@ static VALUE core_quantized_matmul(int argc, VALUE* argv, VALUE) {
     const auto scales = array_from_ruby(argv[2], std::nullopt);
 
     std::optional<mx::array> biases = std::nullopt;
+    std::optional<mx::array> lhs_indices = std::nullopt;
+    std::optional<mx::array> rhs_indices = std::nullopt;
     bool transpose = true;
     std::optional<int> group_size = std::nullopt;
     std::optional<int> bits = std::nullopt;
     std::string mode = "affine";
+    bool sorted_indices = false;
 
     if (argc >= 4 && !NIL_P(argv[3])) {
       biases = array_from_ruby(argv[3], std::nullopt);
     }
     if (argc >= 5 && !NIL_P(argv[4])) {
-      transpose = RTEST(argv[4]);
+      lhs_indices = array_from_ruby(argv[4], std::nullopt);
     }
     if (argc >= 6 && !NIL_P(argv[5])) {
-      group_size = NUM2INT(argv[5]);
+      rhs_indices = array_from_ruby(argv[5], std::nullopt);
     }
     if (argc >= 7 && !NIL_P(argv[6])) {
-      bits = NUM2INT(argv[6]);
+      transpose = RTEST(argv[6]);
     }
     if (argc >= 8 && !NIL_P(argv[7])) {
-      mode = StringValueCStr(argv[7]);
+      group_size = NUM2INT(argv[7]);
+    }
+    if (argc >= 9 && !NIL_P(argv[8])) {
+      bits = NUM2INT(argv[8]);
+    }
+    if (argc >= 10 && !NIL_P(argv[9])) {
+      mode = StringValueCStr(argv[9]);
+    }
+    if (argc >= 11 && !NIL_P(argv[10])) {
+      sorted_indices = RTEST(argv[10]);
     }
 
-    return array_wrap(mx::quantized_matmul(
+    return array_wrap(mx::gather_qmm(
         x,
         w,
         scales,
         biases,
+        lhs_indices,
+        rhs_indices,
         transpose,
         group_size,
         bits,
-        mode));
+        mode,
+        sorted_indices));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_quantize(int argc, VALUE* argv, VALUE) {
+static VALUE core_depends(VALUE, VALUE inputs, VALUE dependencies) {
   try {
-    if (argc < 1 || argc > 4) {
-      rb_raise(rb_eArgError, "quantize expects 1 to 4 arguments");
+    bool return_scalar = false;
+    auto input_arrays = array_sequence_from_ruby(inputs, &return_scalar);
+    auto dep_arrays = array_sequence_from_ruby(dependencies, nullptr);
+    auto out = mx::depends(input_arrays, dep_arrays);
+    if (return_scalar) {
+      return array_wrap(out.at(0));
     }
+    return ruby_array_of_arrays(out);
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
 
-    const auto w = array_from_ruby(argv[0], std::nullopt);
-    std::optional<int> group_size = std::nullopt;
-    std::optional<int> bits = std::nullopt;
-    std::string mode = "affine";
+// .npz support: a zip archive of .npy members. Members are stored or raw
+// deflate (when built against zlib) and are streamed straight between the
+// file and MLX buffers, so no member is staged on disk or held twice.
+static std::string npy_descr(const mx::Dtype& dtype) {
+  switch (dtype.val()) {
+    case mx::Dtype::Val::bool_:
+      return "|b1";
+    case mx::Dtype::Val::uint8:
+      return "|u1";
+    case mx::Dtype::Val::uint16:
+      return "<u2";
+    case mx::Dtype::Val::uint32:
+      return "<u4";
+    case mx::Dtype::Val::uint64:
+      return "<u8";
+    case mx::Dtype::Val::int8:
+      return "|i1";
+    case mx::Dtype::Val::int16:
+      return "<i2";
+    case mx::Dtype::Val::int32:
+      return "<i4";
+    case mx::Dtype::Val::int64:
+      return "<i8";
+    case mx::Dtype::Val::float16:
+      return "<f2";
+    case mx::Dtype::Val::float32:
+      return "<f4";
+    case mx::Dtype::Val::float64:
+      return "<f8";
+    case mx::Dtype::Val::bfloat16:
+      return "<V2";
+    case mx::Dtype::Val::complex64:
+      return "<c8";
+    default:
+      throw std::invalid_argument("[savez] unsupported dtype");
+  }
+}
+
+static mx::Dtype npy_dtype_from_descr(const std::string& descr, bool& swap) {
+  if (descr.size() < 3) {
+    throw std::runtime_error("[load] invalid npy dtype descriptor " + descr);
+  }
+  const char order = descr[0];
+  const std::string code = descr.substr(1);
+  std::optional<mx::Dtype> dtype;
+  if (code == "b1") {
+    dtype = mx::bool_;
+  } else if (code == "u1") {
+    dtype = mx::uint8;
+  } else if (code == "u2") {
+    dtype = mx::uint16;
+  } else if (code == "u4") {
+    dtype = mx::uint32;
+  } else if (code == "u8") {
+    dtype = mx::uint64;
+  } else if (code == "i1") {
+    dtype = mx::int8;
+  } else if (code == "i2") {
+    dtype = mx::int16;
+  } else if (code == "i4") {
+    dtype = mx::int32;
+  } else if (code == "i8") {
+    dtype = mx::int64;
+  } else if (code == "f2") {
+    dtype = mx::float16;
+  } else if (code == "f4") {
+    dtype = mx::float32;
+  } else if (code == "f8") {
+    dtype = mx::float64;
+  } else if (code == "V2") {
+    dtype = mx::bfloat16;
+  } else if (code == "c8") {
+    dtype = mx::complex64;
+  }
+  if (!dtype) {
+    throw std::runtime_error("[load] unsupported npy dtype " + descr);
+  }
+  swap = order == '>' && dtype->size() > 1;
+  return *dtype;
+}
+
+static std::string npy_header(const mx::array& array) {
+  std::ostringstream dict;
+  dict << "{'descr': '" << npy_descr(array.dtype()) << "', 'fortran_order': False, 'shape': (";
+  for (size_t i = 0; i < array.shape().size(); ++i) {
+    dict << array.shape()[i] << (array.ndim() == 1 ? "," : (i + 1 < array.ndim() ? ", " : ""));
+  }
+  dict << "), }";
+  std::string body = dict.str();
+
+  const bool v2 = body.size() + 12 > 65535;
+  const size_t prefix = v2 ? 12 : 10;
+  const size_t padded = (prefix + body.size() + 1 + 63) / 64 * 64;
+  body.append(padded - prefix - body.size() - 1, ' ');
+  body.push_back('\n');
+
+  std::string header("\x93NUMPY", 6);
+  header.push_back(static_cast<char>(v2 ? 2 : 1));
+  header.push_back('\0');
+  const size_t len = body.size();
+  for (size_t i = 0; i < (v2 ? 4u : 2u); ++i) {
+    header.push_back(static_cast<char>((len >> (8 * i)) & 0xff));
+  }
+  return header + body;
+}
+
+struct NpyHeader {
+  mx::Dtype dtype = mx::float32;
+  mx::Shape shape;
+  bool fortran_order = false;
+  bool swap = false;
+};
 
-    if (argc >= 2 && !NIL_P(argv[1])) {
-      group_size = NUM2INT(argv[1]);
+static NpyHeader npy_parse_header(const std::string& dict) {
+  auto value_after = [&](const char* key) {
+    auto pos = dict.find(key);
+    if (pos == std::string::npos) {
+      throw std::runtime_error(std::string("[load] npy header missing ") + key);
+    }
+    pos = dict.find(':', pos);
+    return dict.find_first_not_of(' ', pos + 1);
+  };
+
+  NpyHeader header;
+  auto descr_pos = value_after("'descr'");
+  const char quote = dict.at(descr_pos);
+  auto descr_end = dict.find(quote, descr_pos + 1);
+  header.dtype = npy_dtype_from_descr(dict.substr(descr_pos + 1, descr_end - descr_pos - 1), header.swap);
+  header.fortran_order = dict.compare(value_after("'fortran_order'"), 4, "True") == 0;
+
+  auto shape_pos = value_after("'shape'");
+  auto shape_end = dict.find(')', shape_pos);
+  if (dict.at(shape_pos) != '(' || shape_end == std::string::npos) {
+    throw std::runtime_error("[load] invalid npy shape");
+  }
+  std::string dims = dict.substr(shape_pos + 1, shape_end - shape_pos - 1);
+  size_t start = 0;
+  while (start < dims.size()) {
+    auto comma = dims.find(',', start);
+    std::string token = dims.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+    token.erase(0, token.find_first_not_of(' '));
+    if (!token.empty()) {
+      header.shape.push_back(static_cast<mx::ShapeElem>(std::stoll(token)));
+    }
+    if (comma == std::string::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+  return header;
+}
+
+static uint32_t zip_crc32(uint32_t crc, const void* data, size_t size) {
+#ifdef HAVE_LIBZ
+  const auto* bytes = static_cast<const Bytef*>(data);
+  while (size > 0) {
+    const uInt chunk = static_cast<uInt>(std::min<size_t>(size, 1u << 30));
+    crc = static_cast<uint32_t>(::crc32(crc, bytes, chunk));
+    bytes += chunk;
+    size -= chunk;
+  }
+  return crc;
+#else
+  static const auto table = [] {
+    std::array<uint32_t, 256> out{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      out[i] = c;
+    }
+    return out;
+  }();
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+#endif
+}
+
+constexpr uint64_t kZip32Max = 0xFFFFFFFFULL;
+constexpr uint16_t kZipStored = 0;
+constexpr uint16_t kZipDeflated = 8;
+
+static void zip_put(std::string& out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+static uint64_t zip_get(const unsigned char* data, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+struct ZipEntry {
+  std::string name;
+  uint16_t method = kZipStored;
+  uint32_t crc = 0;
+  uint64_t compressed = 0;
+  uint64_t uncompressed = 0;
+  uint64_t offset = 0;
+};
+
+class NpzWriter {
+ public:
+  NpzWriter(const std::string& path, bool compressed)
+      : out_(path, std::ios::binary | std::ios::trunc), compressed_(compressed) {
+    if (!out_) {
+      throw std::runtime_error("[savez] failed to open " + path);
+    }
+#ifndef HAVE_LIBZ
+    if (compressed_) {
+      throw std::runtime_error("[savez_compressed] mlx was built without zlib");
+    }
+#endif
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+    localtime_r(&now, &local);
+    dos_time_ = static_cast<uint16_t>((local.tm_hour << 11) | (local.tm_min << 5) | (local.tm_sec / 2));
+    dos_date_ = static_cast<uint16_t>(
+        ((std::max(local.tm_year, 80) - 80) << 9) | ((local.tm_mon + 1) << 5) | local.tm_mday);
+  }
+
+  void add(const std::string& name, const mx::array& array) {
+    const std::string header = npy_header(array);
+    const char* data = array.data<char>();
+    const size_t nbytes = array.nbytes();
+
+    ZipEntry entry;
+    entry.name = name + ".npy";
+    entry.method = compressed_ ? kZipDeflated : kZipStored;
+    entry.uncompressed = header.size() + nbytes;
+    entry.offset = static_cast<uint64_t>(out_.tellp());
+    const bool zip64 = entry.uncompressed > kZip32Max - (1u << 16);
+
+    std::string local;
+    zip_put(local, 0x04034b50, 4);
+    zip_put(local, zip64 ? 45 : 20, 2);
+    zip_put(local, 0, 2);
+    zip_put(local, entry.method, 2);
+    zip_put(local, dos_time_, 2);
+    zip_put(local, dos_date_, 2);
+    zip_put(local, 0, 4);
+    zip_put(local, zip64 ? kZip32Max : 0, 4);
+    zip_put(local, zip64 ? kZip32Max : 0, 4);
+    zip_put(local, entry.name.size(), 2);
+    zip_put(local, zip64 ? 20 : 0, 2);
+    local += entry.name;
+    if (zip64) {
+      zip_put(local, 0x0001, 2);
+      zip_put(local, 16, 2);
+      zip_put(local, 0, 8);
+      zip_put(local, 0, 8);
+    }
+    write(local.data(), local.size());
+
+    entry.crc = zip_crc32(zip_crc32(0, header.data(), header.size()), data, nbytes);
+    if (compressed_) {
+      entry.compressed = deflate_member({{header.data(), header.size()}, {data, nbytes}});
+    } else {
+      write(header.data(), header.size());
+      write(data, nbytes);
+      entry.compressed = entry.uncompressed;
+    }
+
+    const auto end = out_.tellp();
+    std::string sizes;
+    zip_put(sizes, entry.crc, 4);
+    if (zip64) {
+      out_.seekp(static_cast<std::streamoff>(entry.offset + 14));
+      write(sizes.data(), sizes.size());
+      sizes.clear();
+      zip_put(sizes, entry.uncompressed, 8);
+      zip_put(sizes, entry.compressed, 8);
+      out_.seekp(static_cast<std::streamoff>(entry.offset + 30 + entry.name.size() + 4));
+    } else {
+      zip_put(sizes, entry.compressed, 4);
+      zip_put(sizes, entry.uncompressed, 4);
+      out_.seekp(static_cast<std::streamoff>(entry.offset + 14));
+    }
+    write(sizes.data(), sizes.size());
+    out_.seekp(end);
+    entries_.push_back(std::move(entry));
+  }
+
+  void finish() {
+    const uint64_t directory_offset = static_cast<uint64_t>(out_.tellp());
+    std::string directory;
+    for (const auto& entry : entries_) {
+      const bool zip64 = entry.compressed >= kZip32Max || entry.uncompressed >= kZip32Max ||
+          entry.offset >= kZip32Max;
+      zip_put(directory, 0x02014b50, 4);
+      zip_put(directory, zip64 ? 45 : 20, 2);
+      zip_put(directory, zip64 ? 45 : 20, 2);
+      zip_put(directory, 0, 2);
+      zip_put(directory, entry.method, 2);
+      zip_put(directory, dos_time_, 2);
+      zip_put(directory, dos_date_, 2);
+      zip_put(directory, entry.crc, 4);
+      zip_put(directory, zip64 ? kZip32Max : entry.compressed, 4);
+      zip_put(directory, zip64 ? kZip32Max : entry.uncompressed, 4);
+      zip_put(directory, entry.name.size(), 2);
+      zip_put(directory, zip64 ? 28 : 0, 2);
+      zip_put(directory, 0, 2);
+      zip_put(directory, 0, 2);
+      zip_put(directory, 0, 2);
+      zip_put(directory, 0, 4);
+      zip_put(directory, zip64 ? kZip32Max : entry.offset, 4);
+      directory += entry.name;
+      if (zip64) {
+        zip_put(directory, 0x0001, 2);
+        zip_put(directory, 24, 2);
+        zip_put(directory, entry.uncompressed, 8);
+        zip_put(directory, entry.compressed, 8);
+        zip_put(directory, entry.offset, 8);
+      }
+    }
+
+    const uint64_t count = entries_.size();
+    const uint64_t size = directory.size();
+    const bool zip64 = count >= 0xFFFF || size >= kZip32Max || directory_offset >= kZip32Max;
+    if (zip64) {
+      const uint64_t record_offset = directory_offset + size;
+      zip_put(directory, 0x06064b50, 4);
+      zip_put(directory, 44, 8);
+      zip_put(directory, 45, 2);
+      zip_put(directory, 45, 2);
+      zip_put(directory, 0, 4);
+      zip_put(directory, 0, 4);
+      zip_put(directory, count, 8);
+      zip_put(directory, count, 8);
+      zip_put(directory, size, 8);
+      zip_put(directory, directory_offset, 8);
+      zip_put(directory, 0x07064b50, 4);
+      zip_put(directory, 0, 4);
+      zip_put(directory, record_offset, 8);
+      zip_put(directory, 1, 4);
+    }
+    zip_put(directory, 0x06054b50, 4);
+    zip_put(directory, 0, 2);
+    zip_put(directory, 0, 2);
+    zip_put(directory, zip64 ? 0xFFFF : count, 2);
+    zip_put(directory, zip64 ? 0xFFFF : count, 2);
+    zip_put(directory, zip64 ? kZip32Max : size, 4);
+    zip_put(directory, zip64 ? kZip32Max : directory_offset, 4);
+    zip_put(directory, 0, 2);
+    write(directory.data(), directory.size());
+    out_.flush();
+    if (!out_) {
+      throw std::runtime_error("[savez] failed to write archive");
+    }
+  }
+
+ private:
+  void write(const char* data, size_t size) {
+    out_.write(data, static_cast<std::streamsize>(size));
+    if (!out_) {
+      throw std::runtime_error("[savez] failed to write archive");
+    }
+  }
+
+  uint64_t deflate_member(std::initializer_list<std::pair<const char*, size_t>> parts) {
+#ifdef HAVE_LIBZ
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw std::runtime_error("[savez_compressed] failed to initialize deflate");
+    }
+    std::vector<char> buffer(1 << 18);
+    uint64_t written = 0;
+    auto drain = [&](int flush) {
+      int status = Z_OK;
+      do {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+        stream.avail_out = static_cast<uInt>(buffer.size());
+        status = ::deflate(&stream, flush);
+        const size_t produced = buffer.size() - stream.avail_out;
+        write(buffer.data(), produced);
+        written += produced;
+      } while (stream.avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+    };
+    try {
+      for (const auto& [data, size] : parts) {
+        size_t remaining = size;
+        const char* cursor = data;
+        while (remaining > 0) {
+          const uInt chunk = static_cast<uInt>(std::min<size_t>(remaining, 1u << 30));
+          stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(cursor));
+          stream.avail_in = chunk;
+          drain(Z_NO_FLUSH);
+          cursor += chunk;
+          remaining -= chunk;
+        }
+      }
+      drain(Z_FINISH);
+    } catch (...) {
+      deflateEnd(&stream);
+      throw;
+    }
+    deflateEnd(&stream);
+    return written;
+#else
+    (void)parts;
+    throw std::runtime_error("[savez_compressed] mlx was built without zlib");
+#endif
+  }
+
+  std::ofstream out_;
+  bool compressed_;
+  uint16_t dos_time_ = 0;
+  uint16_t dos_date_ = 0;
+  std::vector<ZipEntry> entries_;
+};
+
+// Sequential reader over one zip member's uncompressed bytes.
+class ZipMemberReader {
+ public:
+  ZipMemberReader(std::ifstream& in, const ZipEntry& entry) : in_(in), entry_(entry) {
+    unsigned char local[30];
+    in_.seekg(static_cast<std::streamoff>(entry.offset));
+    in_.read(reinterpret_cast<char*>(local), sizeof(local));
+    if (!in_ || zip_get(local, 4) != 0x04034b50) {
+      throw std::runtime_error("[load] corrupt npz member " + entry.name);
+    }
+    in_.seekg(static_cast<std::streamoff>(entry.offset + 30 + zip_get(local + 26, 2) + zip_get(local + 28, 2)));
+    remaining_in_ = entry.compressed;
+    if (entry.method == kZipDeflated) {
+#ifdef HAVE_LIBZ
+      if (inflateInit2(&stream_, -MAX_WBITS) != Z_OK) {
+        throw std::runtime_error("[load] failed to initialize inflate");
+      }
+      inflating_ = true;
+      input_.resize(1 << 18);
+#else
+      throw std::runtime_error("[load] compressed npz requires mlx built with zlib");
+#endif
+    } else if (entry.method != kZipStored) {
+      throw std::runtime_error("[load] unsupported compression method in npz member " + entry.name);
+    }
+  }
+
+  ~ZipMemberReader() {
+#ifdef HAVE_LIBZ
+    if (inflating_) {
+      inflateEnd(&stream_);
+    }
+#endif
+  }
+
+  void read(void* dst, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    if (entry_.method == kZipStored) {
+      if (size > remaining_in_) {
+        throw std::runtime_error("[load] truncated npz member " + entry_.name);
+      }
+      in_.read(static_cast<char*>(dst), static_cast<std::streamsize>(size));
+      if (!in_) {
+        throw std::runtime_error("[load] failed to read npz member " + entry_.name);
+      }
+      remaining_in_ -= size;
+    } else {
+#ifdef HAVE_LIBZ
+      auto* out = static_cast<Bytef*>(dst);
+      size_t left = size;
+      while (left > 0) {
+        if (stream_.avail_in == 0 && remaining_in_ > 0) {
+          const size_t chunk = std::min<uint64_t>(remaining_in_, input_.size());
+          in_.read(input_.data(), static_cast<std::streamsize>(chunk));
+          if (!in_) {
+            throw std::runtime_error("[load] failed to read npz member " + entry_.name);
+          }
+          remaining_in_ -= chunk;
+          stream_.next_in = reinterpret_cast<Bytef*>(input_.data());
+          stream_.avail_in = static_cast<uInt>(chunk);
+        }
+        const uInt want = static_cast<uInt>(std::min<size_t>(left, 1u << 30));
+        stream_.next_out = out;
+        stream_.avail_out = want;
+        const int status = ::inflate(&stream_, Z_NO_FLUSH);
+        const size_t produced = want - stream_.avail_out;
+        if (status != Z_OK && status != Z_STREAM_END) {
+          throw std::runtime_error("[load] corrupt compressed npz member " + entry_.name);
+        }
+        if (produced == 0 && (status == Z_STREAM_END || remaining_in_ == 0)) {
+          throw std::runtime_error("[load] truncated npz member " + entry_.name);
+        }
+        out += produced;
+        left -= produced;
+      }
+#endif
+    }
+    crc_ = zip_crc32(crc_, dst, size);
+    produced_ += size;
+  }
+
+  void verify() const {
+    if (produced_ != entry_.uncompressed || crc_ != entry_.crc) {
+      throw std::runtime_error("[load] checksum mismatch in npz member " + entry_.name);
+    }
+  }
+
+ private:
+  std::ifstream& in_;
+  const ZipEntry& entry_;
+  uint64_t remaining_in_ = 0;
+  uint64_t produced_ = 0;
+  uint32_t crc_ = 0;
+  bool inflating_ = false;
+  std::vector<char> input_;
+#ifdef HAVE_LIBZ
+  z_stream stream_{};
+#endif
+};
+
+static std::vector<ZipEntry> zip_read_directory(std::ifstream& in, const std::string& path) {
+  in.seekg(0, std::ios::end);
+  const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+  const uint64_t tail_size = std::min<uint64_t>(file_size, 22 + 0xFFFF);
+  std::vector<unsigned char> tail(tail_size);
+  in.seekg(static_cast<std::streamoff>(file_size - tail_size));
+  in.read(reinterpret_cast<char*>(tail.data()), static_cast<std::streamsize>(tail_size));
+  if (!in || tail_size < 22) {
+    throw std::runtime_error("[load] not a zip archive: " + path);
+  }
+  size_t eocd = std::string::npos;
+  for (size_t i = tail_size - 22 + 1; i-- > 0;) {
+    if (zip_get(tail.data() + i, 4) == 0x06054b50) {
+      eocd = i;
+      break;
+    }
+  }
+  if (eocd == std::string::npos) {
+    throw std::runtime_error("[load] not a zip archive: " + path);
+  }
+
+  uint64_t count = zip_get(tail.data() + eocd + 10, 2);
+  uint64_t directory_size = zip_get(tail.data() + eocd + 12, 4);
+  uint64_t directory_offset = zip_get(tail.data() + eocd + 16, 4);
+  if ((count == 0xFFFF || directory_size == kZip32Max || directory_offset == kZip32Max) && eocd >= 20 &&
+      zip_get(tail.data() + eocd - 20, 4) == 0x07064b50) {
+    unsigned char record[56];
+    in.seekg(static_cast<std::streamoff>(zip_get(tail.data() + eocd - 20 + 8, 8)));
+    in.read(reinterpret_cast<char*>(record), sizeof(record));
+    if (!in || zip_get(record, 4) != 0x06064b50) {
+      throw std::runtime_error("[load] corrupt zip64 directory in " + path);
+    }
+    count = zip_get(record + 32, 8);
+    directory_size = zip_get(record + 40, 8);
+    directory_offset = zip_get(record + 48, 8);
+  }
+
+  std::vector<unsigned char> directory(directory_size);
+  in.seekg(static_cast<std::streamoff>(directory_offset));
+  in.read(reinterpret_cast<char*>(directory.data()), static_cast<std::streamsize>(directory_size));
+  if (!in) {
+    throw std::runtime_error("[load] corrupt zip directory in " + path);
+  }
+
+  std::vector<ZipEntry> entries;
+  entries.reserve(count);
+  size_t pos = 0;
+  for (uint64_t i = 0; i < count; ++i) {
+    if (pos + 46 > directory.size() || zip_get(directory.data() + pos, 4) != 0x02014b50) {
+      throw std::runtime_error("[load] corrupt zip directory in " + path);
+    }
+    const unsigned char* record = directory.data() + pos;
+    if (zip_get(record + 8, 2) & 1) {
+      throw std::runtime_error("[load] encrypted npz members are not supported");
+    }
+    ZipEntry entry;
+    entry.method = static_cast<uint16_t>(zip_get(record + 10, 2));
+    entry.crc = static_cast<uint32_t>(zip_get(record + 16, 4));
+    entry.compressed = zip_get(record + 20, 4);
+    entry.uncompressed = zip_get(record + 24, 4);
+    const size_t name_len = zip_get(record + 28, 2);
+    const size_t extra_len = zip_get(record + 30, 2);
+    const size_t comment_len = zip_get(record + 32, 2);
+    entry.offset = zip_get(record + 42, 4);
+    if (pos + 46 + name_len + extra_len + comment_len > directory.size()) {
+      throw std::runtime_error("[load] corrupt zip directory in " + path);
+    }
+    entry.name.assign(reinterpret_cast<const char*>(record + 46), name_len);
+
+    const unsigned char* extra = record + 46 + name_len;
+    for (size_t e = 0; e + 4 <= extra_len;) {
+      const uint64_t id = zip_get(extra + e, 2);
+      const size_t len = zip_get(extra + e + 2, 2);
+      if (id == 0x0001) {
+        const unsigned char* field = extra + e + 4;
+        if (entry.uncompressed == kZip32Max) {
+          entry.uncompressed = zip_get(field, 8);
+          field += 8;
+        }
+        if (entry.compressed == kZip32Max) {
+          entry.compressed = zip_get(field, 8);
+          field += 8;
+        }
+        if (entry.offset == kZip32Max) {
+          entry.offset = zip_get(field, 8);
+        }
+      }
+      e += 4 + len;
+    }
+    pos += 46 + name_len + extra_len + comment_len;
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+static mx::array npz_read_member(std::ifstream& in, const ZipEntry& entry) {
+  ZipMemberReader reader(in, entry);
+  unsigned char prefix[12];
+  reader.read(prefix, 10);
+  if (std::memcmp(prefix, "\x93NUMPY", 6) != 0) {
+    throw std::runtime_error("[load] npz member is not an npy file: " + entry.name);
+  }
+  size_t header_len = zip_get(prefix + 8, 2);
+  if (prefix[6] >= 2) {
+    reader.read(prefix + 10, 2);
+    header_len = zip_get(prefix + 8, 4);
+  }
+  std::string dict(header_len, '\0');
+  reader.read(dict.data(), header_len);
+  NpyHeader header = npy_parse_header(dict);
+
+  mx::Shape shape = header.shape;
+  if (header.fortran_order) {
+    std::reverse(shape.begin(), shape.end());
+  }
+  auto out = array_from_host_fill(shape, header.dtype, [&](void* dst, size_t nbytes) {
+    reader.read(dst, nbytes);
+    if (header.swap) {
+      const size_t width = header.dtype == mx::complex64 ? 4 : header.dtype.size();
+      auto* bytes = static_cast<char*>(dst);
+      for (size_t i = 0; i < nbytes; i += width) {
+        std::reverse(bytes + i, bytes + i + width);
+      }
+    }
+  });
+  reader.verify();
+  return header.fortran_order ? mx::transpose(out) : out;
+}
+
+static std::vector<std::pair<std::string, mx::array>> npz_load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("[load] failed to open " + path);
+  }
+  std::vector<std::pair<std::string, mx::array>> out;
+  for (const auto& entry : zip_read_directory(in, path)) {
+    if (!entry.name.empty() && entry.name.back() == '/') {
+      continue;
+    }
+    std::string key = entry.name;
+    if (key.size() > 4 && key.compare(key.size() - 4, 4, ".npy") == 0) {
+      key.resize(key.size() - 4);
+    }
+    out.emplace_back(std::move(key), npz_read_member(in, entry));
+  }
+  return out;
+}
+
+static void npz_save(const std::string& path, std::vector<std::pair<std::string, mx::array>>& arrays, bool compressed) {
+  std::vector<mx::array> pending;
+  for (auto& [name, array] : arrays) {
+    pending.push_back(array);
+  }
+  mx::eval(pending);
+  for (auto& [name, array] : arrays) {
+    if (!array.flags().row_contiguous) {
+      array = mx::contiguous(array);
+      array.eval();
+    }
+  }
+
+  NpzWriter writer(path, compressed);
+  for (const auto& [name, array] : arrays) {
+    writer.add(name, array);
+  }
+  writer.finish();
+}
+
+struct NpzArgs {
+  std::vector<std::pair<std::string, mx::array>> arrays;
+  std::unordered_set<std::string> names;
+};
+
+static int npz_kwargs_iter(VALUE key, VALUE value, VALUE arg) {
+  auto* args = reinterpret_cast<NpzArgs*>(arg);
+  std::string name = string_from_ruby(key);
+  args->names.insert(name);
+  args->arrays.emplace_back(std::move(name), array_from_ruby(value, std::nullopt));
+  return ST_CONTINUE;
+}
+
+static VALUE savez_impl(int argc, VALUE* argv, bool compressed) {
+  try {
+    VALUE file;
+    VALUE positional;
+    VALUE kwargs;
+    rb_scan_args(argc, argv, "1*:", &file, &positional, &kwargs);
+
+    std::string path = string_from_ruby(file);
+    if (path.size() < 4 || path.compare(path.size() - 4, 4, ".npz") != 0) {
+      path += ".npz";
+    }
+
+    NpzArgs args;
+    if (!NIL_P(kwargs)) {
+      rb_hash_foreach(kwargs, npz_kwargs_iter, reinterpret_cast<VALUE>(&args));
+    }
+    for (long i = 0; i < RARRAY_LEN(positional); ++i) {
+      const std::string name = "arr_" + std::to_string(i);
+      if (args.names.count(name) > 0) {
+        rb_raise(rb_eArgError, "Cannot use un-named variables and keyword %s", name.c_str());
+      }
+      args.arrays.emplace_back(name, array_from_ruby(RARRAY_AREF(positional, i), std::nullopt));
+    }
+
+    call_with_gvl_policy(GvlWork::IO, [&]() { npz_save(path, args.arrays, compressed); });
+    return Qnil;
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+// Read-only mmap view of a .safetensors file. The header is parsed up
+// front; arrays are created over the mapping only when a tensor is looked
+// up, so a process pages in just the weights it touches.
+struct SafetensorsMapping {
+  void* base = nullptr;
+  size_t size = 0;
+
+  ~SafetensorsMapping() {
+    if (base != nullptr && base != MAP_FAILED) {
+      munmap(base, size);
+    }
+  }
+};
+
+struct SafetensorsTensor {
+  std::string name;
+  mx::Dtype dtype = mx::float32;
+  mx::Shape shape;
+  size_t begin = 0;
+  size_t end = 0;
+};
+
+struct SafetensorsFileWrapper {
+  std::shared_ptr<SafetensorsMapping> mapping;
+  std::vector<SafetensorsTensor> tensors;
+  std::unordered_map<std::string, size_t> index;
+  std::vector<std::pair<std::string, std::string>> metadata;
+};
+
+// Just enough JSON for safetensors headers: objects, arrays, strings and
+// non-negative integers.
+class SafetensorsHeaderParser {
+ public:
+  explicit SafetensorsHeaderParser(std::string_view text) : text_(text) {}
+
+  template <typename OnMember>
+  void object(OnMember&& on_member) {
+    expect('{');
+    if (peek() == '}') {
+      ++pos_;
+      return;
+    }
+    while (true) {
+      std::string key = string();
+      expect(':');
+      on_member(key);
+      const char next = peek();
+      ++pos_;
+      if (next == '}') {
+        return;
+      }
+      if (next != ',') {
+        fail();
+      }
+    }
+  }
+
+  template <typename OnItem>
+  void array(OnItem&& on_item) {
+    expect('[');
+    if (peek() == ']') {
+      ++pos_;
+      return;
     }
-    if (argc >= 3 && !NIL_P(argv[2])) {
-      bits = NUM2INT(argv[2]);
+    while (true) {
+      on_item();
+      const char next = peek();
+      ++pos_;
+      if (next == ']') {
+        return;
+      }
+      if (next != ',') {
+        fail();
+      }
     }
-    if (argc >= 4 && !NIL_P(argv[3])) {
-      mode = StringValueCStr(argv[3]);
+  }
+
+  std::string string() {
+    expect('"');
+    std::string out;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c != '\\') {
+        out.push_back(c);
+        continue;
+      }
+      if (pos_ >= text_.size()) {
+        fail();
+      }
+      c = text_[pos_++];
+      switch (c) {
+        case 'b':
+          out.push_back('\b');
+          break;
+        case 'f':
+          out.push_back('\f');
+          break;
+        case 'n':
+          out.push_back('\n');
+          break;
+        case 'r':
+          out.push_back('\r');
+          break;
+        case 't':
+          out.push_back('\t');
+          break;
+        case 'u':
+          append_utf8(out, codepoint());
+          break;
+        default:
+          out.push_back(c);
+      }
     }
+    expect('"');
+    return out;
+  }
 
-    return ruby_array_of_arrays(mx::quantize(w, group_size, bits, mode));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+  uint64_t integer() {
+    peek();
+    const size_t start = pos_;
+    uint64_t value = 0;
+    while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+      value = value * 10 + static_cast<uint64_t>(text_[pos_++] - '0');
+    }
+    if (pos_ == start) {
+      fail();
+    }
+    return value;
   }
-}
 
-static VALUE core_dequantize(int argc, VALUE* argv, VALUE) {
-  try {
-    if (argc < 2 || argc > 7) {
-      rb_raise(rb_eArgError, "dequantize expects 2 to 7 arguments");
+  void skip() {
+    const char c = peek();
+    if (c == '{') {
+      object([&](const std::string&) { skip(); });
+    } else if (c == '[') {
+      array([&]() { skip(); });
+    } else if (c == '"') {
+      string();
+    } else {
+      while (pos_ < text_.size() && std::strchr(",}] \t\r\n", text_[pos_]) == nullptr) {
+        ++pos_;
+      }
     }
+  }
 
-    const auto w = array_from_ruby(argv[0], std::nullopt);
-    const auto scales = array_from_ruby(argv[1], std::nullopt);
-    std::optional<mx::array> biases = std::nullopt;
-    std::optional<int> group_size = std::nullopt;
-    std::optional<int> bits = std::nullopt;
-    std::string mode = "affine";
-    std::optional<mx::Dtype> dtype = std::nullopt;
+ private:
+  char peek() {
+    while (pos_ < text_.size() && std::strchr(" \t\r\n", text_[pos_]) != nullptr) {
+      ++pos_;
+    }
+    if (pos_ >= text_.size()) {
+      fail();
+    }
+    return text_[pos_];
+  }
 
-    if (argc >= 3 && !NIL_P(argv[2])) {
-      biases = array_from_ruby(argv[2], std::nullopt);
+  void expect(char c) {
+    if (peek() != c) {
+      fail();
     }
-    if (argc >= 4 && !NIL_P(argv[3])) {
-      group_size = NUM2INT(argv[3]);
+    ++pos_;
+  }
+
+  uint32_t hex4() {
+    if (pos_ + 4 > text_.size()) {
+      fail();
     }
-    if (argc >= 5 && !NIL_P(argv[4])) {
-      bits = NUM2INT(argv[4]);
+    uint32_t value = static_cast<uint32_t>(std::stoul(std::string(text_.substr(pos_, 4)), nullptr, 16));
+    pos_ += 4;
+    return value;
+  }
+
+  uint32_t codepoint() {
+    uint32_t value = hex4();
+    if (value >= 0xD800 && value < 0xDC00 && text_.substr(pos_, 2) == "\\u") {
+      pos_ += 2;
+      value = 0x10000 + ((value - 0xD800) << 10) + (hex4() - 0xDC00);
     }
-    if (argc >= 6 && !NIL_P(argv[5])) {
-      mode = StringValueCStr(argv[5]);
+    return value;
+  }
+
+  static void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+      out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+      out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+      out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+      out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
     }
-    if (argc >= 7) {
-      dtype = optional_dtype_from_value(argv[6]);
+  }
+
+  [[noreturn]] void fail() const {
+    throw std::runtime_error("[load] invalid safetensors header at byte " + std::to_string(pos_));
+  }
+
+  std::string_view text_;
+  size_t pos_ = 0;
+};
+
+static mx::Dtype safetensors_dtype(const std::string& name) {
+  static const std::unordered_map<std::string, mx::Dtype> dtypes = {
+      {"BOOL", mx::bool_},
+      {"U8", mx::uint8},
+      {"I8", mx::int8},
+      {"U16", mx::uint16},
+      {"I16", mx::int16},
+      {"U32", mx::uint32},
+      {"I32", mx::int32},
+      {"U64", mx::uint64},
+      {"I64", mx::int64},
+      {"F16", mx::float16},
+      {"BF16", mx::bfloat16},
+      {"F32", mx::float32},
+      {"F64", mx::float64},
+      {"C64", mx::complex64},
+  };
+  auto it = dtypes.find(name);
+  if (it == dtypes.end()) {
+    throw std::runtime_error("[load] unsupported safetensors dtype " + name);
+  }
+  return it->second;
+}
+
+static void safetensors_open(SafetensorsFileWrapper& file, const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("[load] failed to open " + path);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("[load] failed to stat " + path);
+  }
+  auto mapping = std::make_shared<SafetensorsMapping>();
+  mapping->size = static_cast<size_t>(st.st_size);
+  if (mapping->size > 0) {
+    // Writable private mapping: MLX may donate a wrapped input buffer to an
+    // op's output, and those writes must land in copy-on-write pages rather
+    // than fault on read-only ones. The file itself is never modified.
+    mapping->base = ::mmap(nullptr, mapping->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if (mapping->size < 8 || mapping->base == MAP_FAILED) {
+    throw std::runtime_error("[load] failed to map safetensors file " + path);
+  }
+
+  const auto* bytes = static_cast<const unsigned char*>(mapping->base);
+  uint64_t header_len = 0;
+  for (int i = 7; i >= 0; --i) {
+    header_len = (header_len << 8) | bytes[i];
+  }
+  if (header_len > mapping->size - 8) {
+    throw std::runtime_error("[load] truncated safetensors header in " + path);
+  }
+  const size_t data_start = 8 + static_cast<size_t>(header_len);
+  const size_t data_size = mapping->size - data_start;
+
+  SafetensorsHeaderParser parser(std::string_view(reinterpret_cast<const char*>(bytes + 8), header_len));
+  parser.object([&](const std::string& name) {
+    if (name == "__metadata__") {
+      parser.object([&](const std::string& key) { file.metadata.emplace_back(key, parser.string()); });
+      return;
+    }
+    SafetensorsTensor tensor;
+    tensor.name = name;
+    std::vector<uint64_t> offsets;
+    parser.object([&](const std::string& field) {
+      if (field == "dtype") {
+        tensor.dtype = safetensors_dtype(parser.string());
+      } else if (field == "shape") {
+        parser.array([&]() { tensor.shape.push_back(static_cast<mx::ShapeElem>(parser.integer())); });
+      } else if (field == "data_offsets") {
+        parser.array([&]() { offsets.push_back(parser.integer()); });
+      } else {
+        parser.skip();
+      }
+    });
+    if (offsets.size() != 2 || offsets[0] > offsets[1] || offsets[1] > data_size ||
+        offsets[1] - offsets[0] != checked_byte_count(tensor.shape, tensor.dtype)) {
+      throw std::runtime_error("[load] invalid data_offsets for tensor " + name);
     }
+    tensor.begin = data_start + static_cast<size_t>(offsets[0]);
+    tensor.end = data_start + static_cast<size_t>(offsets[1]);
+    file.index.emplace(tensor.name, file.tensors.size());
+    file.tensors.push_back(std::move(tensor));
+  });
+  file.mapping = std::move(mapping);
+}
 
-    return array_wrap(mx::dequantize(w, scales, biases, group_size, bits, mode, dtype));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+// Wraps the mapped bytes without a copy when they are suitably aligned;
+// the array keeps the mapping alive. Backends whose allocator cannot adopt
+// an arbitrary host pointer (Metal needs page-aligned buffers, which tensor
+// offsets inside a file rarely are) copy the bytes when the array is
+// created, so laziness only holds where the pointer can be wrapped.
+static mx::array safetensors_array(const SafetensorsFileWrapper& file, const SafetensorsTensor& tensor) {
+  char* data = static_cast<char*>(file.mapping->base) + tensor.begin;
+  const size_t nbytes = tensor.end - tensor.begin;
+  if (nbytes == 0) {
+    return mx::zeros(tensor.shape, tensor.dtype);
   }
+  if (reinterpret_cast<uintptr_t>(data) % tensor.dtype.size() != 0) {
+    return array_from_host_fill(tensor.shape, tensor.dtype, [&](void* dst, size_t size) {
+      std::memcpy(dst, data, size);
+    });
+  }
+  auto mapping = file.mapping;
+  return mx::array(data, tensor.shape, tensor.dtype, [mapping](void*) {});
 }
 
-static VALUE core_from_fp8(int argc, VALUE* argv, VALUE) {
+static void safetensors_file_free(void* ptr) {
+  delete static_cast<SafetensorsFileWrapper*>(ptr);
+}
+
+static size_t safetensors_file_memsize(const void* ptr) {
+  const auto* wrapper = static_cast<const SafetensorsFileWrapper*>(ptr);
+  return sizeof(SafetensorsFileWrapper) + wrapper->tensors.capacity() * sizeof(SafetensorsTensor);
+}
+
+static const rb_data_type_t safetensors_file_data_type = {
+    "MLX::Core::SafetensorsFile",
+    {nullptr, safetensors_file_free, safetensors_file_memsize, nullptr, nullptr},
+    nullptr,
+    nullptr,
+    RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+static VALUE safetensors_file_alloc(VALUE klass) {
+  auto* wrapper = new SafetensorsFileWrapper();
+  return TypedData_Wrap_Struct(klass, &safetensors_file_data_type, wrapper);
+}
+
+static SafetensorsFileWrapper* safetensors_file_unwrap(VALUE object) {
+  SafetensorsFileWrapper* wrapper = nullptr;
+  TypedData_Get_Struct(object, SafetensorsFileWrapper, &safetensors_file_data_type, wrapper);
+  return wrapper;
+}
+
+static VALUE safetensors_file_initialize(VALUE self, VALUE path) {
   try {
-    VALUE x;
-    VALUE dtype;
-    rb_scan_args(argc, argv, "11", &x, &dtype);
-    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::bfloat16);
-    return array_wrap(mx::from_fp8(array_from_ruby(x, std::nullopt), target_dtype));
+    auto* wrapper = safetensors_file_unwrap(self);
+    const std::string path_v = string_from_ruby(path);
+    call_with_gvl_policy(GvlWork::IO, [&]() { safetensors_open(*wrapper, path_v); });
+    return self;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_to_fp8(VALUE, VALUE x) {
+static VALUE safetensors_file_keys(VALUE self) {
+  const auto* wrapper = safetensors_file_unwrap(self);
+  VALUE out = rb_ary_new_capa(static_cast<long>(wrapper->tensors.size()));
+  for (const auto& tensor : wrapper->tensors) {
+    rb_ary_push(out, rb_utf8_str_new(tensor.name.c_str(), static_cast<long>(tensor.name.size())));
+  }
+  return out;
+}
+
+static VALUE safetensors_file_key_p(VALUE self, VALUE key) {
+  const auto* wrapper = safetensors_file_unwrap(self);
+  return wrapper->index.count(string_from_ruby(key)) > 0 ? Qtrue : Qfalse;
+}
+
+static VALUE safetensors_file_aref(VALUE self, VALUE key) {
   try {
-    return array_wrap(mx::to_fp8(array_from_ruby(x, std::nullopt)));
+    const auto* wrapper = safetensors_file_unwrap(self);
+    auto it = wrapper->index.find(string_from_ruby(key));
+    if (it == wrapper->index.end()) {
+      return Qnil;
+    }
+    return array_wrap(safetensors_array(*wrapper, wrapper->tensors[it->second]));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_qqmm(int argc, VALUE* argv, VALUE) {
-  try {
-    if (argc < 2 || argc > 6) {
-      rb_raise(rb_eArgError, "qqmm expects 2 to 6 arguments");
-    }
+static VALUE safetensors_file_size(VALUE self) {
+  return SIZET2NUM(safetensors_file_unwrap(self)->tensors.size());
+}
 
-    const auto x = array_from_ruby(argv[0], std::nullopt);
-    const auto w = array_from_ruby(argv[1], std::nullopt);
-    std::optional<mx::array> scales = std::nullopt;
-    std::optional<int> group_size = std::nullopt;
-    std::optional<int> bits = std::nullopt;
-    std::string mode = "nvfp4";
+static VALUE safetensors_file_nbytes(VALUE self) {
+  size_t total = 0;
+  for (const auto& tensor : safetensors_file_unwrap(self)->tensors) {
+    total += tensor.end - tensor.begin;
+  }
+  return SIZET2NUM(total);
+}
 
-    if (argc >= 3 && !NIL_P(argv[2])) {
-      scales = array_from_ruby(argv[2], std::nullopt);
-    }
-    if (argc >= 4 && !NIL_P(argv[3])) {
-      group_size = NUM2INT(argv[3]);
-    }
-    if (argc >= 5 && !NIL_P(argv[4])) {
-      bits = NUM2INT(argv[4]);
+static VALUE safetensors_file_metadata(VALUE self) {
+  VALUE out = rb_hash_new();
+  for (const auto& [key, value] : safetensors_file_unwrap(self)->metadata) {
+    rb_hash_aset(
+        out,
+        rb_utf8_str_new(key.c_str(), static_cast<long>(key.size())),
+        rb_utf8_str_new(value.c_str(), static_cast<long>(value.size())));
+  }
+  return out;
+}
+
+// Returns a view over the same mapping restricted to `names`, in order.
+static VALUE safetensors_file_slice(VALUE self, VALUE names) {
+  Check_Type(names, T_ARRAY);
+  const auto* wrapper = safetensors_file_unwrap(self);
+  VALUE out = safetensors_file_alloc(rb_obj_class(self));
+  auto* sliced = safetensors_file_unwrap(out);
+  sliced->mapping = wrapper->mapping;
+  sliced->metadata = wrapper->metadata;
+  for (long i = 0; i < RARRAY_LEN(names); ++i) {
+    VALUE name = RARRAY_AREF(names, i);
+    auto it = wrapper->index.find(string_from_ruby(name));
+    if (it == wrapper->index.end()) {
+      rb_raise(rb_eKeyError, "tensor not found: %" PRIsVALUE, name);
     }
-    if (argc >= 6 && !NIL_P(argv[5])) {
-      mode = StringValueCStr(argv[5]);
+    if (sliced->index.emplace(it->first, sliced->tensors.size()).second) {
+      sliced->tensors.push_back(wrapper->tensors[it->second]);
     }
-
-    return array_wrap(mx::qqmm(x, w, scales, group_size, bits, mode));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
   }
+  return out;
 }
 
-static VALUE core_gather_qmm(int argc, VALUE* argv, VALUE) {
-  try {
-    if (argc < 3 || argc > 11) {
-      rb_raise(rb_eArgError, "gather_qmm expects 3 to 11 arguments");
+// Runs fn(i) for i in [0, count) on up to `threads` native threads and
+// rethrows the first failure once every worker has finished.
+template <typename Fn>
+static void parallel_for_each_index(size_t count, size_t threads, Fn&& fn) {
+  threads = std::max<size_t>(1, std::min(threads, count));
+  std::atomic<size_t> next{0};
+  std::exception_ptr failure;
+  std::mutex failure_mutex;
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        if (!failure) {
+          failure = std::current_exception();
+        }
+      }
     }
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
 
-    const auto x = array_from_ruby(argv[0], std::nullopt);
-    const auto w = array_from_ruby(argv[1], std::nullopt);
-    const auto scales = array_from_ruby(argv[2], std::nullopt);
+static size_t shard_thread_count(VALUE num_threads) {
+  if (!NIL_P(num_threads)) {
+    return std::max<long>(1, NUM2LONG(num_threads));
+  }
+  return std::max<unsigned>(1, std::thread::hardware_concurrency());
+}
 
-    std::optional<mx::array> biases = std::nullopt;
-    std::optional<mx::array> lhs_indices = std::nullopt;
-    std::optional<mx::array> rhs_indices = std::nullopt;
-    bool transpose = true;
-    std::optional<int> group_size = std::nullopt;
-    std::optional<int> bits = std::nullopt;
-    std::string mode = "affine";
-    bool sorted_indices = false;
+static std::string shape_to_string(const mx::Shape& shape) {
+  std::ostringstream out;
+  out << "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    out << (i == 0 ? "" : ", ") << shape[i];
+  }
+  out << "]";
+  return out.str();
+}
 
-    if (argc >= 4 && !NIL_P(argv[3])) {
-      biases = array_from_ruby(argv[3], std::nullopt);
-    }
-    if (argc >= 5 && !NIL_P(argv[4])) {
-      lhs_indices = array_from_ruby(argv[4], std::nullopt);
-    }
-    if (argc >= 6 && !NIL_P(argv[5])) {
-      rhs_indices = array_from_ruby(argv[5], std::nullopt);
+static std::string joined_names(std::vector<std::string> names) {
+  std::sort(names.begin(), names.end());
+  std::string out;
+  for (size_t i = 0; i < names.size(); ++i) {
+    out += (i == 0 ? "" : ",\n") + names[i];
+  }
+  return out;
+}
+
+// Checks shard headers against the model's parameter shapes before any
+// tensor data is read. Returns an error message, or "" when valid.
+static std::string shard_validation_error(
+    const std::vector<SafetensorsFileWrapper>& files,
+    const std::optional<std::unordered_map<std::string, mx::Shape>>& expected) {
+  std::unordered_map<std::string, const SafetensorsTensor*> seen;
+  for (const auto& file : files) {
+    for (const auto& tensor : file.tensors) {
+      if (!seen.emplace(tensor.name, &tensor).second) {
+        return "Parameter " + tensor.name + " appears in more than one shard.";
+      }
     }
-    if (argc >= 7 && !NIL_P(argv[6])) {
-      transpose = RTEST(argv[6]);
+  }
+  if (!expected) {
+    return "";
+  }
+
+  std::vector<std::string> extras;
+  for (const auto& [name, tensor] : seen) {
+    if (expected->count(name) == 0) {
+      extras.push_back(name);
     }
-    if (argc >= 8 && !NIL_P(argv[7])) {
-      group_size = NUM2INT(argv[7]);
+  }
+  if (!extras.empty()) {
+    const std::string count = std::to_string(extras.size());
+    return "Received " + count + " parameters not in model: \n" + joined_names(std::move(extras)) + ".";
+  }
+  std::vector<std::string> missing;
+  for (const auto& [name, shape] : *expected) {
+    if (seen.count(name) == 0) {
+      missing.push_back(name);
     }
-    if (argc >= 9 && !NIL_P(argv[8])) {
-      bits = NUM2INT(argv[8]);
+  }
+  if (!missing.empty()) {
+    const std::string count = std::to_string(missing.size());
+    return "Missing " + count + " parameters: \n" + joined_names(std::move(missing)) + ".";
+  }
+  for (const auto& [name, shape] : *expected) {
+    const auto& received = seen.at(name)->shape;
+    if (received != shape) {
+      return "Expected shape " + shape_to_string(shape) + " but received shape " + shape_to_string(received) +
+          " for parameter " + name;
     }
-    if (argc >= 10 && !NIL_P(argv[9])) {
-      mode = StringValueCStr(argv[9]);
+  }
+  return "";
+}
+
+static int expected_shapes_iter(VALUE key, VALUE value, VALUE arg) {
+  auto* shapes = reinterpret_cast<std::unordered_map<std::string, mx::Shape>*>(arg);
+  shapes->insert_or_assign(
+      string_from_ruby(key), rb_obj_is_kind_of(value, cArray) ? array_unwrap(value).shape() : shape_from_ruby(value));
+  return ST_CONTINUE;
+}
+
+// Loads every tensor of the given safetensors shards into MLX buffers.
+// Headers are parsed and tensors copied on a native thread pool with the
+// GVL released; `expected` (name => shape or array) is validated against
+// the headers first so a mismatched checkpoint fails before any data I/O.
+static VALUE core_load_safetensors_shards(VALUE, VALUE paths, VALUE expected, VALUE num_threads) {
+  try {
+    Check_Type(paths, T_ARRAY);
+    std::vector<std::string> paths_v;
+    for (long i = 0; i < RARRAY_LEN(paths); ++i) {
+      paths_v.push_back(string_from_ruby(RARRAY_AREF(paths, i)));
+    }
+    std::optional<std::unordered_map<std::string, mx::Shape>> expected_v;
+    if (!NIL_P(expected)) {
+      Check_Type(expected, T_HASH);
+      expected_v.emplace();
+      rb_hash_foreach(expected, expected_shapes_iter, reinterpret_cast<VALUE>(&*expected_v));
+    }
+    const size_t threads = shard_thread_count(num_threads);
+
+    std::vector<std::pair<std::string, mx::array>> loaded;
+    std::string invalid;
+    {
+      std::vector<SafetensorsFileWrapper> files(paths_v.size());
+      call_with_gvl_policy(GvlWork::IO, [&]() {
+        parallel_for_each_index(files.size(), threads, [&](size_t i) { safetensors_open(files[i], paths_v[i]); });
+      });
+      invalid = shard_validation_error(files, expected_v);
+      if (invalid.empty()) {
+        std::vector<std::pair<size_t, size_t>> tasks;
+        for (size_t f = 0; f < files.size(); ++f) {
+          for (size_t t = 0; t < files[f].tensors.size(); ++t) {
+            tasks.emplace_back(f, t);
+          }
+        }
+        std::vector<std::optional<mx::array>> arrays(tasks.size());
+        call_with_gvl_policy(GvlWork::IO, [&]() {
+          for (const auto& file : files) {
+            madvise(file.mapping->base, file.mapping->size, MADV_WILLNEED);
+          }
+          parallel_for_each_index(tasks.size(), threads, [&](size_t i) {
+            const auto& tensor = files[tasks[i].first].tensors[tasks[i].second];
+            const char* data = static_cast<const char*>(files[tasks[i].first].mapping->base) + tensor.begin;
+            arrays[i] = array_from_host_fill(tensor.shape, tensor.dtype, [&](void* dst, size_t size) {
+              std::memcpy(dst, data, size);
+            });
+          });
+        });
+        loaded.reserve(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i) {
+          loaded.emplace_back(files[tasks[i].first].tensors[tasks[i].second].name, std::move(*arrays[i]));
+        }
+      }
     }
-    if (argc >= 11 && !NIL_P(argv[10])) {
-      sorted_indices = RTEST(argv[10]);
+    if (!invalid.empty()) {
+      VALUE message = rb_utf8_str_new(invalid.data(), static_cast<long>(invalid.size()));
+      std::string().swap(invalid);
+      rb_exc_raise(rb_exc_new_str(rb_eArgError, message));
     }
 
-    return array_wrap(mx::gather_qmm(
-        x,
-        w,
-        scales,
-        biases,
-        lhs_indices,
-        rhs_indices,
-        transpose,
-        group_size,
-        bits,
-        mode,
-        sorted_indices));
+    VALUE out = rb_hash_new();
+    for (const auto& [name, array] : loaded) {
+      rb_hash_aset(out, rb_utf8_str_new(name.c_str(), static_cast<long>(name.size())), array_wrap(array));
+    }
+    return out;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_depends(VALUE, VALUE inputs, VALUE dependencies) {
-  try {
-    bool return_scalar = false;
-    auto input_arrays = array_sequence_from_ruby(inputs, &return_scalar);
-    auto dep_arrays = array_sequence_from_ruby(dependencies, nullptr);
-    auto out = mx::depends(input_arrays, dep_arrays);
-    if (return_scalar) {
-      return array_wrap(out.at(0));
+static std::string safetensors_dtype_name(const mx::Dtype& dtype) {
+  switch (dtype.val()) {
+    case mx::Dtype::Val::bool_:
+      return "BOOL";
+    case mx::Dtype::Val::uint8:
+      return "U8";
+    case mx::Dtype::Val::uint16:
+      return "U16";
+    case mx::Dtype::Val::uint32:
+      return "U32";
+    case mx::Dtype::Val::uint64:
+      return "U64";
+    case mx::Dtype::Val::int8:
+      return "I8";
+    case mx::Dtype::Val::int16:
+      return "I16";
+    case mx::Dtype::Val::int32:
+      return "I32";
+    case mx::Dtype::Val::int64:
+      return "I64";
+    case mx::Dtype::Val::float16:
+      return "F16";
+    case mx::Dtype::Val::bfloat16:
+      return "BF16";
+    case mx::Dtype::Val::float32:
+      return "F32";
+    case mx::Dtype::Val::float64:
+      return "F64";
+    case mx::Dtype::Val::complex64:
+      return "C64";
+    default:
+      throw std::invalid_argument("[save] unsupported safetensors dtype");
+  }
+}
+
+static std::string json_quote(const std::string& value) {
+  std::string out = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+      out += escaped;
+    } else {
+      out.push_back(c);
+    }
+  }
+  out.push_back('"');
+  return out;
+}
+
+struct SafetensorsShardWrite {
+  std::string path;
+  std::vector<std::pair<std::string, mx::array>> arrays;
+  std::vector<std::pair<std::string, std::string>> metadata;
+};
+
+// Arrays must already be evaluated and row contiguous.
+static void safetensors_write(const SafetensorsShardWrite& shard) {
+  std::string header = "{";
+  if (!shard.metadata.empty()) {
+    header += "\"__metadata__\":{";
+    for (size_t i = 0; i < shard.metadata.size(); ++i) {
+      header += (i == 0 ? "" : ",") + json_quote(shard.metadata[i].first) + ":" + json_quote(shard.metadata[i].second);
+    }
+    header += "}";
+  }
+  size_t offset = 0;
+  for (const auto& [name, array] : shard.arrays) {
+    header += (header.size() > 1 ? "," : "") + json_quote(name) + ":{\"dtype\":\"" +
+        safetensors_dtype_name(array.dtype()) + "\",\"shape\":" + shape_to_string(array.shape()) +
+        ",\"data_offsets\":[" + std::to_string(offset) + "," + std::to_string(offset + array.nbytes()) + "]}";
+    offset += array.nbytes();
+  }
+  header += "}";
+  header.append((8 - header.size() % 8) % 8, ' ');
+
+  std::ofstream out(shard.path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("[save] failed to open " + shard.path);
+  }
+  std::string prefix;
+  zip_put(prefix, header.size(), 8);
+  out.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+  out.write(header.data(), static_cast<std::streamsize>(header.size()));
+  for (const auto& [name, array] : shard.arrays) {
+    out.write(array.data<char>(), static_cast<std::streamsize>(array.nbytes()));
+  }
+  out.flush();
+  if (!out) {
+    throw std::runtime_error("[save] failed to write " + shard.path);
+  }
+}
+
+static int shard_arrays_iter(VALUE key, VALUE value, VALUE arg) {
+  auto* shard = reinterpret_cast<SafetensorsShardWrite*>(arg);
+  shard->arrays.emplace_back(string_from_ruby(key), array_from_ruby(value, std::nullopt));
+  return ST_CONTINUE;
+}
+
+// Writes `shards` ([path, {name => array}, metadata] triples) as
+// safetensors files in parallel with the GVL released.
+static VALUE core_save_safetensors_shards(VALUE, VALUE shards, VALUE num_threads) {
+  try {
+    Check_Type(shards, T_ARRAY);
+    std::vector<SafetensorsShardWrite> writes(static_cast<size_t>(RARRAY_LEN(shards)));
+    for (long i = 0; i < RARRAY_LEN(shards); ++i) {
+      VALUE shard = RARRAY_AREF(shards, i);
+      Check_Type(shard, T_ARRAY);
+      auto& write = writes[static_cast<size_t>(i)];
+      write.path = string_from_ruby(rb_ary_entry(shard, 0));
+      VALUE arrays = rb_ary_entry(shard, 1);
+      Check_Type(arrays, T_HASH);
+      rb_hash_foreach(arrays, shard_arrays_iter, reinterpret_cast<VALUE>(&write));
+      for (auto& [key, value] : string_map_from_ruby_hash(rb_ary_entry(shard, 2))) {
+        write.metadata.emplace_back(key, value);
+      }
+      std::sort(write.metadata.begin(), write.metadata.end());
     }
-    return ruby_array_of_arrays(out);
+    const size_t threads = shard_thread_count(num_threads);
+
+    call_with_gvl_policy(GvlWork::IO, [&]() {
+      std::vector<mx::array> pending;
+      for (const auto& write : writes) {
+        for (const auto& [name, array] : write.arrays) {
+          pending.push_back(array);
+        }
+      }
+      mx::eval(pending);
+      for (auto& write : writes) {
+        for (auto& [name, array] : write.arrays) {
+          if (!array.flags().row_contiguous) {
+            array = mx::contiguous(array);
+            array.eval();
+          }
+        }
+      }
+      parallel_for_each_index(writes.size(), threads, [&](size_t i) { safetensors_write(writes[i]); });
+    });
+    return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -3640,24 +7009,7 @@ static VALUE core_save(VALUE, VALUE file, VALUE array) {
     const std::string file_v = string_from_ruby(file);
     mx::array array_v = array_unwrap(array);
 
-    struct CoreSavePayload {
-      const std::string* file;
-      const mx::array* array;
-      std::exception_ptr error;
-    };
-    auto core_save_without_gvl = [](void* arg) -> void* {
-      auto* payload = reinterpret_cast<CoreSavePayload*>(arg);
-      try {
-        mx::save(*payload->file, *payload->array);
-      } catch (...) {
-        payload->error = std::current_exception();
-      }
-      return nullptr;
-    };
-
-    CoreSavePayload payload{&file_v, &array_v, nullptr};
-    rb_thread_call_without_gvl(core_save_without_gvl, &payload, RUBY_UBF_IO, nullptr);
-    rethrow_captured_exception(payload.error);
+    call_with_gvl_policy(GvlWork::IO, [&]() { mx::save(file_v, array_v); });
     return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -3689,31 +7041,23 @@ static VALUE core_load(int argc, VALUE* argv, VALUE) {
         rb_raise(rb_eArgError, "metadata not supported for format npy");
       }
 
-      struct CoreLoadNpyPayload {
-        const std::string* file;
-        mx::array output;
-        std::exception_ptr error;
-      };
-      auto core_load_npy_without_gvl = [](void* arg) -> void* {
-        auto* payload = reinterpret_cast<CoreLoadNpyPayload*>(arg);
-        try {
-          payload->output = mx::load(*payload->file);
-        } catch (...) {
-          payload->error = std::current_exception();
-        }
-        return nullptr;
-      };
-
-      CoreLoadNpyPayload payload{&file_v, mx::array(0.0f), nullptr};
-      rb_thread_call_without_gvl(core_load_npy_without_gvl, &payload, RUBY_UBF_IO, nullptr);
-      rethrow_captured_exception(payload.error);
-      return array_wrap(payload.output);
+      return array_wrap(call_with_gvl_policy(GvlWork::IO, [&]() { return mx::load(file_v); }));
     }
     if (format_v == "npz") {
-      rb_raise(rb_eNotImpError, "npz load is not yet supported in the Ruby binding");
+      if (return_metadata_v) {
+        rb_raise(rb_eArgError, "metadata not supported for format npz");
+      }
+
+      auto arrays = call_with_gvl_policy(GvlWork::IO, [&]() { return npz_load(file_v); });
+      VALUE out = rb_hash_new();
+      for (const auto& [key, value] : arrays) {
+        rb_hash_aset(out, rb_utf8_str_new(key.c_str(), static_cast<long>(key.size())), array_wrap(value));
+      }
+      return out;
     }
     if (format_v == "safetensors") {
-      auto [arrays, metadata] = mx::load_safetensors(file_v);
+      auto [arrays, metadata] =
+          call_with_gvl_policy(GvlWork::IO, [&]() { return mx::load_safetensors(file_v); });
       VALUE ruby_arrays = ruby_hash_of_arrays(arrays);
       if (!return_metadata_v) {
         return ruby_arrays;
@@ -3724,7 +7068,8 @@ static VALUE core_load(int argc, VALUE* argv, VALUE) {
       return out;
     }
     if (format_v == "gguf") {
-      auto [arrays, metadata] = mx::load_gguf(file_v);
+      auto [arrays, metadata] =
+          call_with_gvl_policy(GvlWork::IO, [&]() { return mx::load_gguf(file_v); });
       VALUE ruby_arrays = ruby_hash_of_arrays(arrays);
       if (!return_metadata_v) {
         return ruby_arrays;
@@ -3750,10 +7095,11 @@ static VALUE core_save_safetensors(int argc, VALUE* argv, VALUE) {
     VALUE metadata;
     rb_scan_args(argc, argv, "21", &file, &arrays, &metadata);
 
-    mx::save_safetensors(
-        string_from_ruby(file),
-        array_map_from_ruby_hash(arrays),
-        string_map_from_ruby_hash(metadata));
+    const std::string file_v = string_from_ruby(file);
+    const auto arrays_v = array_map_from_ruby_hash(arrays);
+    const auto metadata_v = string_map_from_ruby_hash(metadata);
+    call_with_gvl_policy(
+        GvlWork::IO, [&]() { mx::save_safetensors(file_v, arrays_v, metadata_v); });
     return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -3768,10 +7114,10 @@ static VALUE core_save_gguf(int argc, VALUE* argv, VALUE) {
     VALUE metadata;
     rb_scan_args(argc, argv, "21", &file, &arrays, &metadata);
 
-    mx::save_gguf(
-        string_from_ruby(file),
-        array_map_from_ruby_hash(arrays),
-        gguf_meta_map_from_ruby_hash(metadata));
+    const std::string file_v = string_from_ruby(file);
+    const auto arrays_v = array_map_from_ruby_hash(arrays);
+    const auto metadata_v = gguf_meta_map_from_ruby_hash(metadata);
+    call_with_gvl_policy(GvlWork::IO, [&]() { mx::save_gguf(file_v, arrays_v, metadata_v); });
     return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -3779,16 +7125,333 @@ static VALUE core_save_gguf(int argc, VALUE* argv, VALUE) {
   }
 }
 
-static VALUE core_savez(int, VALUE*, VALUE) {
-  rb_raise(rb_eNotImpError, "savez is not yet supported in the Ruby binding");
-  return Qnil;
+static VALUE core_savez(int argc, VALUE* argv, VALUE) {
+  return savez_impl(argc, argv, false);
 }
 
-static VALUE core_savez_compressed(int, VALUE*, VALUE) {
-  rb_raise(
-      rb_eNotImpError,
-      "savez_compressed is not yet supported in the Ruby binding");
-  return Qnil;
+static VALUE core_savez_compressed(int argc, VALUE* argv, VALUE) {
+  return savez_impl(argc, argv, true);
+}
+
+// Marshal support for MLX::Core::Array. The payload is "MLXA", a version
+// byte, the npy dtype descriptor ("<f4"), a u32 rank and u64 dimensions,
+// followed by the row-major little-endian element bytes, so dumping and
+// loading are single memcpys instead of one Ruby object per element.
+static constexpr char kArrayDumpMagic[4] = {'M', 'L', 'X', 'A'};
+static constexpr uint8_t kArrayDumpVersion = 1;
+static constexpr size_t kArrayDumpHeaderBytes = 12;
+
+static VALUE array_marshal_dump(VALUE self, VALUE) {
+  try {
+    mx::array host = array_wrapper_get(self)->array;
+    call_with_gvl_policy(GvlWork::Eval, [&]() {
+      host.eval();
+      if (!host.flags().row_contiguous) {
+        host = mx::contiguous(host);
+        host.eval();
+      }
+    });
+
+    std::string header(kArrayDumpMagic, sizeof(kArrayDumpMagic));
+    header.push_back(static_cast<char>(kArrayDumpVersion));
+    header += npy_descr(host.dtype());
+    zip_put(header, host.ndim(), 4);
+    for (const auto dim : host.shape()) {
+      zip_put(header, static_cast<uint64_t>(dim), 8);
+    }
+
+    VALUE out = rb_str_buf_new(static_cast<long>(header.size() + host.nbytes()));
+    rb_str_cat(out, header.data(), static_cast<long>(header.size()));
+    if (host.nbytes() > 0) {
+      rb_str_cat(out, host.data<char>(), static_cast<long>(host.nbytes()));
+    }
+    return out;
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE array_marshal_load(VALUE, VALUE data) {
+  try {
+    StringValue(data);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(RSTRING_PTR(data));
+    const size_t length = static_cast<size_t>(RSTRING_LEN(data));
+    if (length < kArrayDumpHeaderBytes || std::memcmp(bytes, kArrayDumpMagic, sizeof(kArrayDumpMagic)) != 0) {
+      throw std::invalid_argument("[Array._load] data is not a serialized MLX array");
+    }
+    if (bytes[4] != kArrayDumpVersion) {
+      throw std::invalid_argument(
+          "[Array._load] unsupported serialization version " + std::to_string(static_cast<int>(bytes[4])));
+    }
+    // _dump only writes the little-endian descriptors of npy_descr, so
+    // anything else (including big-endian forms) is rejected here.
+    const std::string descr(reinterpret_cast<const char*>(bytes + 5), 3);
+    std::optional<mx::Dtype> found;
+    for (const mx::Dtype& candidate :
+         {mx::bool_, mx::uint8, mx::uint16, mx::uint32, mx::uint64, mx::int8, mx::int16, mx::int32, mx::int64,
+          mx::float16, mx::float32, mx::float64, mx::bfloat16, mx::complex64}) {
+      if (npy_descr(candidate) == descr) {
+        found = candidate;
+        break;
+      }
+    }
+    if (!found) {
+      throw std::invalid_argument("[Array._load] unknown dtype descriptor " + descr);
+    }
+    const mx::Dtype dtype = *found;
+    const uint64_t ndim = zip_get(bytes + 8, 4);
+    if (ndim > (length - kArrayDumpHeaderBytes) / 8) {
+      throw std::invalid_argument("[Array._load] truncated shape");
+    }
+    mx::Shape shape;
+    shape.reserve(static_cast<size_t>(ndim));
+    for (uint64_t i = 0; i < ndim; ++i) {
+      const uint64_t dim = zip_get(bytes + kArrayDumpHeaderBytes + 8 * i, 8);
+      if (dim > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::invalid_argument("[Array._load] dimension out of range");
+      }
+      shape.push_back(static_cast<int32_t>(dim));
+    }
+    const size_t offset = kArrayDumpHeaderBytes + 8 * static_cast<size_t>(ndim);
+    if (length - offset != checked_byte_count(shape, dtype)) {
+      throw std::invalid_argument("[Array._load] payload size does not match shape and dtype");
+    }
+    return array_wrap(array_from_host_fill(shape, dtype, [&](void* dst, size_t nbytes) {
+      std::memcpy(dst, bytes + offset, nbytes);
+    }));
+  } catch (const std::invalid_argument& error) {
+    rb_raise(rb_eArgError, "%s", error.what());
+    return Qnil;
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+// Batches one field across samples. Every sample must share the rank and
+// trailing dimensions; the leading dimension may vary, in which case rows
+// are right-padded with `pad` into a single buffer and the original
+// lengths are reported alongside the batch.
+struct CollateField {
+  std::vector<mx::array> values;
+  mx::Dtype dtype = mx::bool_;
+  int max_length = 0;
+};
+
+static CollateField collate_field(std::vector<mx::array> values, VALUE label, int multiple) {
+  CollateField field;
+  const mx::array& first = values.front();
+  // Empty samples (e.g. `[]`, which has no elements to infer from) do not
+  // take part in dtype promotion unless every sample is empty.
+  std::optional<mx::Dtype> dtype;
+  for (size_t i = 0; i < values.size(); ++i) {
+    const mx::array& value = values[i];
+    if (value.size() > 0) {
+      dtype = dtype ? mx::promote_types(*dtype, value.dtype()) : value.dtype();
+    }
+    const bool same_trailing = value.ndim() == first.ndim() &&
+        std::equal(value.shape().begin() + std::min<size_t>(1, value.ndim()), value.shape().end(),
+                   first.shape().begin() + std::min<size_t>(1, first.ndim()));
+    if (!same_trailing) {
+      throw std::invalid_argument(
+          "[collate] field " + string_from_ruby(label) + " of sample " + std::to_string(i) + " has shape " +
+          shape_to_string(value.shape()) + ", expected trailing dimensions matching " +
+          shape_to_string(first.shape()));
+    }
+    if (value.ndim() > 0) {
+      field.max_length = std::max(field.max_length, value.shape(0));
+    }
+  }
+  field.dtype = dtype.value_or(first.dtype());
+  if (first.ndim() > 0 && multiple > 1 && field.max_length % multiple != 0) {
+    field.max_length += multiple - field.max_length % multiple;
+  }
+  for (auto& value : values) {
+    value = mx::astype(value, field.dtype);
+  }
+  field.values = std::move(values);
+  return field;
+}
+
+static mx::array collate_fill(const CollateField& field, const mx::array& pad) {
+  const mx::array& first = field.values.front();
+  mx::Shape shape{static_cast<int>(field.values.size())};
+  if (first.ndim() > 0) {
+    shape.push_back(field.max_length);
+    shape.insert(shape.end(), first.shape().begin() + 1, first.shape().end());
+  }
+  const size_t item_bytes = static_cast<size_t>(field.dtype.size());
+  size_t row_bytes = item_bytes;
+  for (size_t axis = 2; axis < shape.size(); ++axis) {
+    row_bytes *= static_cast<size_t>(shape[axis]);
+  }
+  const size_t sample_bytes = first.ndim() > 0 ? row_bytes * static_cast<size_t>(field.max_length) : item_bytes;
+  return array_from_host_fill(shape, field.dtype, [&](void* dst, size_t) {
+    auto* out = static_cast<char*>(dst);
+    for (const auto& value : field.values) {
+      const size_t used = value.nbytes();
+      if (used > 0) {
+        std::memcpy(out, value.data<char>(), used);
+      }
+      for (size_t offset = used; offset < sample_bytes; offset += item_bytes) {
+        std::memcpy(out + offset, pad.data<char>(), item_bytes);
+      }
+      out += sample_bytes;
+    }
+  });
+}
+
+static mx::array collate_lengths(const CollateField& field) {
+  std::vector<int32_t> lengths;
+  lengths.reserve(field.values.size());
+  for (const auto& value : field.values) {
+    lengths.push_back(static_cast<int32_t>(value.shape(0)));
+  }
+  return mx::array(lengths.begin(), {static_cast<int>(lengths.size())}, mx::int32);
+}
+
+// Appends to a copy of the key's own String so its encoding carries over.
+static VALUE collate_lengths_key(VALUE key) {
+  const bool symbol = SYMBOL_P(key);
+  VALUE name = symbol ? rb_sym2str(key) : (RB_TYPE_P(key, T_STRING) ? key : rb_obj_as_string(key));
+  name = rb_str_cat_cstr(rb_str_dup(name), "_lengths");
+  return symbol ? rb_str_intern(name) : name;
+}
+
+// A flat Ruby Array of numbers is one sequence, not a tuple of scalars.
+static bool collate_numeric_sequence(VALUE sample) {
+  if (!RB_TYPE_P(sample, T_ARRAY)) {
+    return false;
+  }
+  for (long i = 0; i < RARRAY_LEN(sample); ++i) {
+    if (!is_numeric_scalar(RARRAY_AREF(sample, i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Stacks a batch of samples into MLX arrays in one pass: all fields are
+// converted and evaluated together, then each is copied (with right
+// padding for variable-length fields) into a single contiguous buffer.
+// Every field with a leading axis also reports its per-sample lengths as
+// int32: Hash samples collate per key and add `<key>_lengths`; Ruby Array
+// samples of mixed values are tuples that collate per position, followed by
+// the lengths in field order; anything else (including flat numeric Arrays)
+// is a single field, returned as `[batch, lengths]` unless it is scalar.
+static VALUE core_collate_samples(VALUE, VALUE samples, VALUE pad_value, VALUE pad_to_multiple_of) {
+  try {
+    Check_Type(samples, T_ARRAY);
+    const long count = RARRAY_LEN(samples);
+    if (count == 0) {
+      throw std::invalid_argument("[collate] samples must not be empty");
+    }
+    const int multiple = NIL_P(pad_to_multiple_of) ? 1 : NUM2INT(pad_to_multiple_of);
+    if (multiple <= 0) {
+      throw std::invalid_argument("[collate] pad_to_multiple_of must be positive");
+    }
+
+    const VALUE head = RARRAY_AREF(samples, 0);
+    const bool hashes = RB_TYPE_P(head, T_HASH);
+    bool tuples = false;
+    if (RB_TYPE_P(head, T_ARRAY)) {
+      for (long i = 0; i < count && !tuples; ++i) {
+        tuples = !collate_numeric_sequence(RARRAY_AREF(samples, i));
+      }
+    }
+    VALUE keys = hashes ? rb_funcall(head, cached_intern_id("keys"), 0) : Qnil;
+    const long width = hashes ? RARRAY_LEN(keys) : (tuples ? RARRAY_LEN(head) : 1);
+
+    std::vector<CollateField> fields;
+    fields.reserve(static_cast<size_t>(width));
+    for (long f = 0; f < width; ++f) {
+      const VALUE label = hashes ? RARRAY_AREF(keys, f) : LONG2NUM(f);
+      std::vector<mx::array> values;
+      values.reserve(static_cast<size_t>(count));
+      for (long i = 0; i < count; ++i) {
+        const VALUE sample = RARRAY_AREF(samples, i);
+        VALUE value = sample;
+        if (hashes) {
+          if (!RB_TYPE_P(sample, T_HASH) || RHASH_SIZE(sample) != static_cast<size_t>(width)) {
+            throw std::invalid_argument(
+                "[collate] sample " + std::to_string(i) + " does not have the same keys as sample 0");
+          }
+          value = rb_hash_lookup2(sample, label, Qundef);
+          if (value == Qundef) {
+            throw std::invalid_argument(
+                "[collate] sample " + std::to_string(i) + " is missing key " + string_from_ruby(label));
+          }
+        } else if (tuples) {
+          if (!RB_TYPE_P(sample, T_ARRAY) || RARRAY_LEN(sample) != width) {
+            throw std::invalid_argument(
+                "[collate] sample " + std::to_string(i) + " does not have " + std::to_string(width) + " fields");
+          }
+          value = RARRAY_AREF(sample, f);
+        }
+        values.push_back(
+            RB_TYPE_P(value, T_ARRAY) ? array_from_ruby_list(value) : array_from_ruby(value, std::nullopt));
+      }
+      fields.push_back(collate_field(std::move(values), label, multiple));
+    }
+
+    std::vector<mx::array> pads;
+    std::vector<mx::array> pending;
+    pads.reserve(fields.size());
+    for (const auto& field : fields) {
+      pads.push_back(mx::astype(array_from_ruby(pad_value, std::nullopt), field.dtype));
+      pending.push_back(pads.back());
+      pending.insert(pending.end(), field.values.begin(), field.values.end());
+    }
+    call_with_gvl_policy(GvlWork::Eval, [&]() {
+      mx::eval(pending);
+      std::vector<mx::array> strided;
+      for (auto& field : fields) {
+        for (auto& value : field.values) {
+          if (!value.flags().row_contiguous) {
+            value = mx::contiguous(value);
+            strided.push_back(value);
+          }
+        }
+      }
+      if (!strided.empty()) {
+        mx::eval(strided);
+      }
+    });
+
+    VALUE out = hashes ? rb_hash_new() : rb_ary_new_capa(2 * width);
+    VALUE lengths = rb_ary_new_capa(width);
+    for (size_t f = 0; f < fields.size(); ++f) {
+      const CollateField& field = fields[f];
+      VALUE batched = array_wrap(collate_fill(field, pads[f]));
+      const bool sequence = field.values.front().ndim() > 0;
+      if (!hashes) {
+        rb_ary_push(out, batched);
+        if (sequence) {
+          rb_ary_push(lengths, array_wrap(collate_lengths(field)));
+        }
+        continue;
+      }
+      const VALUE key = RARRAY_AREF(keys, static_cast<long>(f));
+      rb_hash_aset(out, key, batched);
+      if (sequence) {
+        rb_hash_aset(out, collate_lengths_key(key), array_wrap(collate_lengths(field)));
+      }
+    }
+    if (hashes) {
+      return out;
+    }
+    if (!tuples && RARRAY_LEN(lengths) == 0) {
+      return RARRAY_AREF(out, 0);
+    }
+    return rb_ary_concat(out, lengths);
+  } catch (const std::invalid_argument& error) {
+    rb_raise(rb_eArgError, "%s", error.what());
+    return Qnil;
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
 }
 
 static VALUE core_inner(VALUE, VALUE a, VALUE b) {
@@ -5610,7 +9273,8 @@ static VALUE core_log(VALUE, VALUE array) {
 
 static VALUE core_logaddexp(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::logaddexp(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::logaddexp(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -5744,7 +9408,8 @@ static VALUE core_arctanh(VALUE, VALUE array) {
 
 static VALUE core_arctan2(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::arctan2(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::arctan2(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -5919,7 +9584,8 @@ static VALUE core_rsqrt(VALUE, VALUE array) {
 
 static VALUE core_floor_divide(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::floor_divide(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::floor_divide(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -5928,7 +9594,8 @@ static VALUE core_floor_divide(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_left_shift(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::left_shift(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::left_shift(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -5937,7 +9604,8 @@ static VALUE core_left_shift(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_right_shift(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::right_shift(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::right_shift(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6014,7 +9682,8 @@ static VALUE core_nan_to_num(int argc, VALUE* argv, VALUE) {
 
 static VALUE core_minimum(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::minimum(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::minimum(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6023,7 +9692,8 @@ static VALUE core_minimum(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_maximum(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::maximum(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::maximum(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6083,7 +9753,8 @@ static VALUE core_logical_not(VALUE, VALUE a) {
 
 static VALUE core_logical_and(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::logical_and(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::logical_and(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6092,7 +9763,8 @@ static VALUE core_logical_and(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_logical_or(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::logical_or(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::logical_or(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6101,7 +9773,8 @@ static VALUE core_logical_or(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_bitwise_and(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::bitwise_and(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::bitwise_and(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6110,7 +9783,8 @@ static VALUE core_bitwise_and(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_bitwise_or(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::bitwise_or(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::bitwise_or(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6119,7 +9793,8 @@ static VALUE core_bitwise_or(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_bitwise_xor(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::bitwise_xor(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::bitwise_xor(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6158,7 +9833,8 @@ static VALUE core_allclose(int argc, VALUE* argv, VALUE) {
 
 static VALUE core_equal(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::equal(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::equal(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6167,7 +9843,8 @@ static VALUE core_equal(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_not_equal(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::not_equal(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::not_equal(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6176,7 +9853,8 @@ static VALUE core_not_equal(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_greater(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::greater(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::greater(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6185,7 +9863,8 @@ static VALUE core_greater(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_greater_equal(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::greater_equal(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::greater_equal(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6194,7 +9873,8 @@ static VALUE core_greater_equal(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_less(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::less(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::less(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6203,7 +9883,8 @@ static VALUE core_less(VALUE, VALUE a, VALUE b) {
 
 static VALUE core_less_equal(VALUE, VALUE a, VALUE b) {
   try {
-    return array_wrap(mx::less_equal(array_from_ruby(a, std::nullopt), array_from_ruby(b, std::nullopt)));
+    BinaryOperands operands = binary_operands(a, b);
+    return array_wrap(mx::less_equal(operands.lhs, operands.rhs));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
@@ -6277,260 +9958,949 @@ static VALUE core_arange(int argc, VALUE* argv, VALUE) {
     double step = 1.0;
     mx::Dtype dtype = mx::float32;
 
-    if (argc == 1) {
-      stop = NUM2DBL(argv[0]);
-    } else if (argc == 2) {
+    if (argc == 1) {
+      stop = NUM2DBL(argv[0]);
+    } else if (argc == 2) {
+      if (value_looks_like_dtype(argv[1])) {
+        stop = NUM2DBL(argv[0]);
+        dtype = optional_dtype_from_value(argv[1]).value_or(mx::float32);
+      } else {
+        start = NUM2DBL(argv[0]);
+        stop = NUM2DBL(argv[1]);
+      }
+    } else if (argc == 3) {
+      if (value_looks_like_dtype(argv[2])) {
+        start = NUM2DBL(argv[0]);
+        stop = NUM2DBL(argv[1]);
+        dtype = optional_dtype_from_value(argv[2]).value_or(mx::float32);
+      } else {
+        start = NUM2DBL(argv[0]);
+        stop = NUM2DBL(argv[1]);
+        step = NUM2DBL(argv[2]);
+      }
+    } else {
+      start = NUM2DBL(argv[0]);
+      stop = NUM2DBL(argv[1]);
+      step = NUM2DBL(argv[2]);
+      dtype = optional_dtype_from_value(argv[3]).value_or(mx::float32);
+    }
+
+    return array_wrap(mx::arange(start, stop, step, dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_linspace(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 2 || argc > 4) {
+      rb_raise(rb_eArgError, "linspace expects 2 to 4 arguments");
+    }
+
+    const double start = NUM2DBL(argv[0]);
+    const double stop = NUM2DBL(argv[1]);
+    int num = 50;
+    mx::Dtype dtype = mx::float32;
+
+    if (argc == 3) {
+      if (value_looks_like_dtype(argv[2])) {
+        dtype = optional_dtype_from_value(argv[2]).value_or(mx::float32);
+      } else {
+        num = NUM2INT(argv[2]);
+      }
+    } else if (argc == 4) {
+      num = NUM2INT(argv[2]);
+      dtype = optional_dtype_from_value(argv[3]).value_or(mx::float32);
+    }
+
+    return array_wrap(mx::linspace(start, stop, num, dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_zeros(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE shape;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "11", &shape, &dtype);
+    auto target_shape = shape_from_ruby(shape);
+    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
+    return array_wrap(mx::zeros(target_shape, target_dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_ones(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE shape;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "11", &shape, &dtype);
+    auto target_shape = shape_from_ruby(shape);
+    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
+    return array_wrap(mx::ones(target_shape, target_dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_full(int argc, VALUE* argv, VALUE) {
+  try {
+    VALUE shape;
+    VALUE value;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "21", &shape, &value, &dtype);
+
+    auto target_shape = shape_from_ruby(shape);
+    auto target_dtype = optional_dtype_from_value(dtype);
+    if (target_dtype.has_value()) {
+      return array_wrap(mx::full(
+          std::move(target_shape),
+          array_from_ruby(value, target_dtype),
+          target_dtype.value()));
+    }
+    return array_wrap(mx::full(std::move(target_shape), array_from_ruby(value, std::nullopt)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_zeros_like(VALUE, VALUE array) {
+  try {
+    return array_wrap(mx::zeros_like(array_unwrap(array)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_ones_like(VALUE, VALUE array) {
+  try {
+    return array_wrap(mx::ones_like(array_unwrap(array)));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_eye(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 1 || argc > 4) {
+      rb_raise(rb_eArgError, "eye expects 1 to 4 arguments");
+    }
+
+    const int n = NUM2INT(argv[0]);
+    int m = n;
+    int k = 0;
+    mx::Dtype dtype = mx::float32;
+
+    if (argc == 2) {
       if (value_looks_like_dtype(argv[1])) {
-        stop = NUM2DBL(argv[0]);
         dtype = optional_dtype_from_value(argv[1]).value_or(mx::float32);
       } else {
-        start = NUM2DBL(argv[0]);
-        stop = NUM2DBL(argv[1]);
+        m = NUM2INT(argv[1]);
       }
     } else if (argc == 3) {
       if (value_looks_like_dtype(argv[2])) {
-        start = NUM2DBL(argv[0]);
-        stop = NUM2DBL(argv[1]);
+        m = NUM2INT(argv[1]);
         dtype = optional_dtype_from_value(argv[2]).value_or(mx::float32);
       } else {
-        start = NUM2DBL(argv[0]);
-        stop = NUM2DBL(argv[1]);
-        step = NUM2DBL(argv[2]);
+        m = NUM2INT(argv[1]);
+        k = NUM2INT(argv[2]);
       }
-    } else {
-      start = NUM2DBL(argv[0]);
-      stop = NUM2DBL(argv[1]);
-      step = NUM2DBL(argv[2]);
+    } else if (argc == 4) {
+      m = NUM2INT(argv[1]);
+      k = NUM2INT(argv[2]);
       dtype = optional_dtype_from_value(argv[3]).value_or(mx::float32);
     }
 
-    return array_wrap(mx::arange(start, stop, step, dtype));
+    return array_wrap(mx::eye(n, m, k, dtype));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_linspace(int argc, VALUE* argv, VALUE) {
+static VALUE core_identity(int argc, VALUE* argv, VALUE) {
   try {
-    if (argc < 2 || argc > 4) {
-      rb_raise(rb_eArgError, "linspace expects 2 to 4 arguments");
+    VALUE n;
+    VALUE dtype;
+    rb_scan_args(argc, argv, "11", &n, &dtype);
+    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
+    return array_wrap(mx::identity(NUM2INT(n), target_dtype));
+  } catch (const std::exception& error) {
+    raise_std_exception(error);
+    return Qnil;
+  }
+}
+
+static VALUE core_tri(int argc, VALUE* argv, VALUE) {
+  try {
+    if (argc < 1 || argc > 4) {
+      rb_raise(rb_eArgError, "tri expects 1 to 4 arguments");
     }
 
-    const double start = NUM2DBL(argv[0]);
-    const double stop = NUM2DBL(argv[1]);
-    int num = 50;
+    const int n = NUM2INT(argv[0]);
+    int m = n;
+    int k = 0;
     mx::Dtype dtype = mx::float32;
 
-    if (argc == 3) {
+    if (argc == 2) {
+      if (value_looks_like_dtype(argv[1])) {
+        dtype = optional_dtype_from_value(argv[1]).value_or(mx::float32);
+      } else {
+        m = NUM2INT(argv[1]);
+      }
+    } else if (argc == 3) {
       if (value_looks_like_dtype(argv[2])) {
+        m = NUM2INT(argv[1]);
         dtype = optional_dtype_from_value(argv[2]).value_or(mx::float32);
       } else {
-        num = NUM2INT(argv[2]);
+        m = NUM2INT(argv[1]);
+        k = NUM2INT(argv[2]);
       }
     } else if (argc == 4) {
-      num = NUM2INT(argv[2]);
+      m = NUM2INT(argv[1]);
+      k = NUM2INT(argv[2]);
       dtype = optional_dtype_from_value(argv[3]).value_or(mx::float32);
     }
 
-    return array_wrap(mx::linspace(start, stop, num, dtype));
+    return array_wrap(mx::tri(n, m, k, dtype));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_zeros(int argc, VALUE* argv, VALUE) {
+static VALUE core_tril(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE shape;
-    VALUE dtype;
-    rb_scan_args(argc, argv, "11", &shape, &dtype);
-    auto target_shape = shape_from_ruby(shape);
-    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
-    return array_wrap(mx::zeros(target_shape, target_dtype));
+    VALUE array;
+    VALUE k;
+    rb_scan_args(argc, argv, "11", &array, &k);
+    const int k_v = NIL_P(k) ? 0 : NUM2INT(k);
+    return array_wrap(mx::tril(array_unwrap(array), k_v));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_ones(int argc, VALUE* argv, VALUE) {
+static VALUE core_triu(int argc, VALUE* argv, VALUE) {
   try {
-    VALUE shape;
-    VALUE dtype;
-    rb_scan_args(argc, argv, "11", &shape, &dtype);
-    auto target_shape = shape_from_ruby(shape);
-    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
-    return array_wrap(mx::ones(target_shape, target_dtype));
+    VALUE array;
+    VALUE k;
+    rb_scan_args(argc, argv, "11", &array, &k);
+    const int k_v = NIL_P(k) ? 0 : NUM2INT(k);
+    return array_wrap(mx::triu(array_unwrap(array), k_v));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_full(int argc, VALUE* argv, VALUE) {
+static VALUE core_astype(VALUE, VALUE array, VALUE dtype) {
   try {
-    VALUE shape;
-    VALUE value;
-    VALUE dtype;
-    rb_scan_args(argc, argv, "21", &shape, &value, &dtype);
-
-    auto target_shape = shape_from_ruby(shape);
-    auto target_dtype = optional_dtype_from_value(dtype);
-    if (target_dtype.has_value()) {
-      return array_wrap(mx::full(
-          std::move(target_shape),
-          array_from_ruby(value, target_dtype),
-          target_dtype.value()));
-    }
-    return array_wrap(mx::full(std::move(target_shape), array_from_ruby(value, std::nullopt)));
+    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
+    return array_wrap(mx::astype(array_unwrap(array), target_dtype));
   } catch (const std::exception& error) {
     raise_std_exception(error);
     return Qnil;
   }
 }
 
-static VALUE core_zeros_like(VALUE, VALUE array) {
-  try {
-    return array_wrap(mx::zeros_like(array_unwrap(array)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+// Pytree structure shared by compile/checkpoint/grad. Nodes are stored in
+// preorder; hash children carry their key and constants their value. The
+// fingerprint is computed while flattening so cache lookups hash a single
+// integer, with full structural comparison only on fingerprint matches.
+struct TreeSpecNode {
+  enum class Kind : uint8_t { Leaf, List, Hash, Const };
+  Kind kind;
+  uint32_t children;
+  VALUE key;
+  VALUE value;
+};
+
+struct TreeSpecWrapper {
+  std::vector<TreeSpecNode> nodes;
+  uint64_t fingerprint = 1469598103934665603ULL;
+  size_t leaves = 0;
+};
+
+static void tree_spec_mark(void* ptr) {
+  auto* wrapper = static_cast<TreeSpecWrapper*>(ptr);
+  for (const auto& node : wrapper->nodes) {
+    rb_gc_mark(node.key);
+    rb_gc_mark(node.value);
+  }
+}
+
+static void tree_spec_free(void* ptr) {
+  delete static_cast<TreeSpecWrapper*>(ptr);
+}
+
+static size_t tree_spec_memsize(const void* ptr) {
+  const auto* wrapper = static_cast<const TreeSpecWrapper*>(ptr);
+  return sizeof(TreeSpecWrapper) + wrapper->nodes.capacity() * sizeof(TreeSpecNode);
+}
+
+static const rb_data_type_t tree_spec_data_type = {
+    "MLX::Core::TreeSpec",
+    {tree_spec_mark, tree_spec_free, tree_spec_memsize, nullptr, nullptr},
+    nullptr,
+    nullptr,
+    RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+static TreeSpecWrapper* tree_spec_unwrap(VALUE object) {
+  if (!rb_typeddata_is_kind_of(object, &tree_spec_data_type)) {
+    rb_raise(rb_eTypeError, "invalid tree specification");
+  }
+  TreeSpecWrapper* wrapper = nullptr;
+  TypedData_Get_Struct(object, TreeSpecWrapper, &tree_spec_data_type, wrapper);
+  return wrapper;
+}
+
+static void tree_spec_mix(TreeSpecWrapper* spec, uint64_t value) {
+  spec->fingerprint ^= value + 0x9e3779b97f4a7c15ULL + (spec->fingerprint << 6) + (spec->fingerprint >> 2);
+}
+
+static uint64_t tree_spec_value_hash(VALUE value) {
+  return static_cast<uint64_t>(NUM2LL(rb_hash(value)));
+}
+
+static bool tree_spec_const_p(VALUE value) {
+  return NIL_P(value) || value == Qtrue || value == Qfalse || SYMBOL_P(value) ||
+      RB_TYPE_P(value, T_STRING) || rb_obj_is_kind_of(value, rb_cNumeric);
+}
+
+struct TreeSpecBuild {
+  TreeSpecWrapper* spec;
+  VALUE arrays;
+  bool strict;
+};
+
+static void tree_spec_flatten(TreeSpecBuild& build, VALUE value, VALUE key);
+
+static int tree_spec_flatten_hash_iter(VALUE key, VALUE value, VALUE arg) {
+  auto* build = reinterpret_cast<TreeSpecBuild*>(arg);
+  tree_spec_mix(build->spec, tree_spec_value_hash(key));
+  tree_spec_flatten(*build, value, key);
+  return ST_CONTINUE;
+}
+
+static void tree_spec_flatten(TreeSpecBuild& build, VALUE value, VALUE key) {
+  TreeSpecWrapper* spec = build.spec;
+  if (rb_obj_is_kind_of(value, cArray)) {
+    spec->nodes.push_back({TreeSpecNode::Kind::Leaf, 0, key, Qnil});
+    spec->leaves++;
+    tree_spec_mix(spec, 1);
+    rb_ary_push(build.arrays, value);
+    return;
+  }
+  if (RB_TYPE_P(value, T_ARRAY)) {
+    const long len = RARRAY_LEN(value);
+    spec->nodes.push_back({TreeSpecNode::Kind::List, static_cast<uint32_t>(len), key, Qnil});
+    tree_spec_mix(spec, 2);
+    tree_spec_mix(spec, static_cast<uint64_t>(len));
+    for (long i = 0; i < len; ++i) {
+      tree_spec_flatten(build, RARRAY_AREF(value, i), Qnil);
+    }
+    return;
+  }
+  if (RB_TYPE_P(value, T_HASH)) {
+    const long len = static_cast<long>(RHASH_SIZE(value));
+    spec->nodes.push_back({TreeSpecNode::Kind::Hash, static_cast<uint32_t>(len), key, Qnil});
+    tree_spec_mix(spec, 3);
+    tree_spec_mix(spec, static_cast<uint64_t>(len));
+    rb_hash_foreach(value, tree_spec_flatten_hash_iter, reinterpret_cast<VALUE>(&build));
+    return;
+  }
+  if (build.strict) {
+    rb_raise(rb_eTypeError, "[tree_flatten] The argument should contain only arrays");
+  }
+  if (!tree_spec_const_p(value)) {
+    rb_raise(
+        rb_eTypeError,
+        "[compile] Function arguments and outputs must be trees of arrays or constants (Numeric, String, Symbol, true/false, nil)");
+  }
+  spec->nodes.push_back({TreeSpecNode::Kind::Const, 0, key, value});
+  tree_spec_mix(spec, 4);
+  tree_spec_mix(spec, static_cast<uint64_t>(rb_obj_class(value)));
+  tree_spec_mix(spec, tree_spec_value_hash(value));
+}
+
+// Appends every array leaf of `value` to the Ruby Array `arrays` and returns
+// the TreeSpec needed to rebuild the tree from them.
+static VALUE core_tree_flatten_spec(VALUE, VALUE value, VALUE arrays, VALUE strict) {
+  Check_Type(arrays, T_ARRAY);
+  auto* spec = new TreeSpecWrapper();
+  VALUE out = TypedData_Wrap_Struct(cTreeSpec, &tree_spec_data_type, spec);
+  TreeSpecBuild build{spec, arrays, RTEST(strict)};
+  tree_spec_flatten(build, value, Qnil);
+  return out;
+}
+
+static VALUE tree_spec_inflate(const TreeSpecWrapper* spec, size_t& node, VALUE arrays, long& cursor) {
+  const TreeSpecNode& current = spec->nodes.at(node++);
+  switch (current.kind) {
+    case TreeSpecNode::Kind::Leaf: {
+      if (cursor >= RARRAY_LEN(arrays)) {
+        rb_raise(rb_eIndexError, "index %ld outside of array bounds", cursor);
+      }
+      return RARRAY_AREF(arrays, cursor++);
+    }
+    case TreeSpecNode::Kind::List: {
+      VALUE out = rb_ary_new_capa(static_cast<long>(current.children));
+      for (uint32_t i = 0; i < current.children; ++i) {
+        rb_ary_push(out, tree_spec_inflate(spec, node, arrays, cursor));
+      }
+      return out;
+    }
+    case TreeSpecNode::Kind::Hash: {
+      VALUE out = rb_hash_new();
+      for (uint32_t i = 0; i < current.children; ++i) {
+        VALUE key = spec->nodes.at(node).key;
+        rb_hash_aset(out, key, tree_spec_inflate(spec, node, arrays, cursor));
+      }
+      return out;
+    }
+    case TreeSpecNode::Kind::Const:
+    default:
+      return current.value;
+  }
+}
+
+// Rebuilds the tree described by `spec` from `arrays`, starting at
+// `cursor`. Returns [tree, next_cursor].
+static VALUE core_tree_inflate(VALUE, VALUE spec, VALUE arrays, VALUE cursor) {
+  const TreeSpecWrapper* wrapper = tree_spec_unwrap(spec);
+  Check_Type(arrays, T_ARRAY);
+  if (wrapper->nodes.empty()) {
+    rb_raise(rb_eArgError, "invalid tree specification");
+  }
+  long cursor_v = NUM2LONG(cursor);
+  size_t node = 0;
+  VALUE tree = tree_spec_inflate(wrapper, node, arrays, cursor_v);
+  return rb_assoc_new(tree, LONG2NUM(cursor_v));
+}
+
+static VALUE tree_spec_hash(VALUE self) {
+  return LL2NUM(static_cast<long long>(tree_spec_unwrap(self)->fingerprint));
+}
+
+static VALUE tree_spec_eql(VALUE self, VALUE other) {
+  if (!rb_typeddata_is_kind_of(other, &tree_spec_data_type)) {
+    return Qfalse;
+  }
+  const TreeSpecWrapper* lhs = tree_spec_unwrap(self);
+  const TreeSpecWrapper* rhs = tree_spec_unwrap(other);
+  if (lhs == rhs) {
+    return Qtrue;
+  }
+  if (lhs->fingerprint != rhs->fingerprint || lhs->nodes.size() != rhs->nodes.size()) {
+    return Qfalse;
+  }
+  for (size_t i = 0; i < lhs->nodes.size(); ++i) {
+    const auto& a = lhs->nodes[i];
+    const auto& b = rhs->nodes[i];
+    if (a.kind != b.kind || a.children != b.children) {
+      return Qfalse;
+    }
+    if (!rb_eql(a.key, b.key)) {
+      return Qfalse;
+    }
+    if (a.kind == TreeSpecNode::Kind::Const &&
+        (rb_obj_class(a.value) != rb_obj_class(b.value) || !rb_eql(a.value, b.value))) {
+      return Qfalse;
+    }
+  }
+  return Qtrue;
+}
+
+static VALUE tree_spec_leaf_count(VALUE self) {
+  return SIZET2NUM(tree_spec_unwrap(self)->leaves);
+}
+
+// Shared helpers for MLX::Utils.native_tree_* below.
+static VALUE tree_child_at(VALUE tree, VALUE key) {
+  if (RB_TYPE_P(tree, T_ARRAY) && FIXNUM_P(key)) {
+    return rb_ary_entry(tree, FIX2LONG(key));
+  }
+  if (RB_TYPE_P(tree, T_HASH)) {
+    return rb_hash_aref(tree, key);
+  }
+  return rb_funcall(tree, cached_intern_id("[]"), 1, key);
+}
+
+static bool tree_is_leaf(VALUE is_leaf, VALUE node) {
+  return !NIL_P(is_leaf) && RTEST(rb_funcall(is_leaf, cached_intern_id("call"), 1, node));
+}
+
+struct TreeMapContext {
+  VALUE fn;
+  VALUE rest;
+  VALUE is_leaf;
+};
+
+static VALUE tree_map_node(const TreeMapContext& context, VALUE tree, VALUE rest);
+
+struct TreeMapHashIter {
+  const TreeMapContext* context;
+  VALUE rest;
+  VALUE out;
+};
+
+static VALUE tree_map_rest_children(VALUE rest, VALUE key) {
+  const long count = RARRAY_LEN(rest);
+  VALUE out = rb_ary_new_capa(count);
+  for (long i = 0; i < count; ++i) {
+    rb_ary_push(out, tree_child_at(RARRAY_AREF(rest, i), key));
+  }
+  return out;
+}
+
+static int tree_map_hash_iter(VALUE key, VALUE child, VALUE arg) {
+  auto* iter = reinterpret_cast<TreeMapHashIter*>(arg);
+  VALUE rest = tree_map_rest_children(iter->rest, key);
+  rb_hash_aset(iter->out, key, tree_map_node(*iter->context, child, rest));
+  return ST_CONTINUE;
+}
+
+static VALUE tree_map_apply(const TreeMapContext& context, VALUE tree, VALUE rest) {
+  const long count = RARRAY_LEN(rest);
+  VALUE args = rb_ary_new_capa(count + 1);
+  rb_ary_push(args, tree);
+  rb_ary_concat(args, rest);
+  return rb_funcallv(
+      context.fn, cached_intern_id("call"), static_cast<int>(RARRAY_LEN(args)), RARRAY_CONST_PTR(args));
+}
+
+static VALUE tree_map_node(const TreeMapContext& context, VALUE tree, VALUE rest) {
+  if (tree_is_leaf(context.is_leaf, tree)) {
+    return tree_map_apply(context, tree, rest);
+  }
+  if (RB_TYPE_P(tree, T_ARRAY)) {
+    const long len = RARRAY_LEN(tree);
+    VALUE out = rb_ary_new_capa(len);
+    for (long i = 0; i < len; ++i) {
+      VALUE child_rest = tree_map_rest_children(rest, LONG2FIX(i));
+      rb_ary_push(out, tree_map_node(context, RARRAY_AREF(tree, i), child_rest));
+    }
+    return out;
+  }
+  if (RB_TYPE_P(tree, T_HASH)) {
+    TreeMapHashIter iter{&context, rest, rb_hash_new()};
+    rb_hash_foreach(tree, tree_map_hash_iter, reinterpret_cast<VALUE>(&iter));
+    return iter.out;
+  }
+  return tree_map_apply(context, tree, rest);
+}
+
+static VALUE utils_native_tree_map(VALUE, VALUE fn, VALUE tree, VALUE rest, VALUE is_leaf) {
+  Check_Type(rest, T_ARRAY);
+  TreeMapContext context{fn, rest, is_leaf};
+  return tree_map_node(context, tree, rest);
+}
+
+struct TreeFlattenContext {
+  VALUE destination;
+  VALUE is_leaf;
+};
+
+static void tree_flatten_node(const TreeFlattenContext& context, VALUE node, VALUE current);
+
+static VALUE tree_flatten_child_key(VALUE current, VALUE key) {
+  VALUE key_s = rb_obj_as_string(key);
+  if (RSTRING_LEN(current) == 0) {
+    return rb_str_dup(key_s);
+  }
+  VALUE out = rb_str_dup(current);
+  rb_str_cat(out, ".", 1);
+  return rb_str_append(out, key_s);
+}
+
+struct TreeFlattenHashIter {
+  const TreeFlattenContext* context;
+  VALUE current;
+};
+
+static int tree_flatten_hash_iter(VALUE key, VALUE child, VALUE arg) {
+  auto* iter = reinterpret_cast<TreeFlattenHashIter*>(arg);
+  tree_flatten_node(*iter->context, child, tree_flatten_child_key(iter->current, key));
+  return ST_CONTINUE;
+}
+
+static void tree_flatten_node(const TreeFlattenContext& context, VALUE node, VALUE current) {
+  if (!tree_is_leaf(context.is_leaf, node)) {
+    if (RB_TYPE_P(node, T_ARRAY)) {
+      const long len = RARRAY_LEN(node);
+      for (long i = 0; i < len; ++i) {
+        tree_flatten_node(context, RARRAY_AREF(node, i), tree_flatten_child_key(current, LONG2FIX(i)));
+      }
+      return;
+    }
+    if (RB_TYPE_P(node, T_HASH)) {
+      TreeFlattenHashIter iter{&context, current};
+      rb_hash_foreach(node, tree_flatten_hash_iter, reinterpret_cast<VALUE>(&iter));
+      return;
+    }
+  }
+  if (RB_TYPE_P(context.destination, T_HASH)) {
+    rb_hash_aset(context.destination, current, node);
+  } else {
+    rb_ary_push(context.destination, rb_assoc_new(current, node));
+  }
+}
+
+static VALUE utils_native_tree_flatten(VALUE, VALUE tree, VALUE prefix, VALUE is_leaf, VALUE destination) {
+  if (!RB_TYPE_P(destination, T_ARRAY) && !RB_TYPE_P(destination, T_HASH)) {
+    rb_raise(rb_eArgError, "destination must be an Array, Hash, or nil");
+  }
+  VALUE current = rb_str_dup(rb_obj_as_string(prefix));
+  if (RSTRING_LEN(current) > 0 && RSTRING_PTR(current)[0] == '.') {
+    current = rb_str_substr(current, 1, RSTRING_LEN(current) - 1);
+  }
+  TreeFlattenContext context{destination, is_leaf};
+  tree_flatten_node(context, tree, current);
+  return destination;
+}
+
+static bool tree_key_numeric_p(VALUE key) {
+  const long len = RSTRING_LEN(key);
+  if (len == 0) {
+    return false;
+  }
+  const char* ptr = RSTRING_PTR(key);
+  for (long i = 0; i < len; ++i) {
+    if (ptr[i] < '0' || ptr[i] > '9') {
+      return false;
+    }
   }
+  return true;
 }
 
-static VALUE core_ones_like(VALUE, VALUE array) {
-  try {
-    return array_wrap(mx::ones_like(array_unwrap(array)));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+static VALUE tree_unflatten_items(VALUE items);
+
+static int tree_unflatten_numeric_iter(VALUE key, VALUE, VALUE arg) {
+  if (!tree_key_numeric_p(key)) {
+    *reinterpret_cast<bool*>(arg) = false;
+    return ST_STOP;
   }
+  return ST_CONTINUE;
 }
 
-static VALUE core_eye(int argc, VALUE* argv, VALUE) {
-  try {
-    if (argc < 1 || argc > 4) {
-      rb_raise(rb_eArgError, "eye expects 1 to 4 arguments");
-    }
+static int tree_unflatten_index_iter(VALUE key, VALUE, VALUE indices) {
+  rb_ary_push(indices, rb_str_to_inum(key, 10, FALSE));
+  return ST_CONTINUE;
+}
 
-    const int n = NUM2INT(argv[0]);
-    int m = n;
-    int k = 0;
-    mx::Dtype dtype = mx::float32;
+static int tree_unflatten_hash_iter(VALUE key, VALUE pairs, VALUE out) {
+  rb_hash_aset(out, key, tree_unflatten_items(pairs));
+  return ST_CONTINUE;
+}
 
-    if (argc == 2) {
-      if (value_looks_like_dtype(argv[1])) {
-        dtype = optional_dtype_from_value(argv[1]).value_or(mx::float32);
-      } else {
-        m = NUM2INT(argv[1]);
-      }
-    } else if (argc == 3) {
-      if (value_looks_like_dtype(argv[2])) {
-        m = NUM2INT(argv[1]);
-        dtype = optional_dtype_from_value(argv[2]).value_or(mx::float32);
-      } else {
-        m = NUM2INT(argv[1]);
-        k = NUM2INT(argv[2]);
+static VALUE tree_unflatten_items(VALUE items) {
+  const long len = RARRAY_LEN(items);
+  if (len == 1) {
+    VALUE only = RARRAY_AREF(items, 0);
+    if (RSTRING_LEN(rb_obj_as_string(rb_ary_entry(only, 0))) == 0) {
+      return rb_ary_entry(only, 1);
+    }
+  }
+
+  // Group by first key segment, preserving first-seen order.
+  VALUE children = rb_hash_new();
+  for (long i = 0; i < len; ++i) {
+    VALUE item = RARRAY_AREF(items, i);
+    VALUE key = rb_obj_as_string(rb_ary_entry(item, 0));
+    const char* ptr = RSTRING_PTR(key);
+    const long key_len = RSTRING_LEN(key);
+    const char* dot = static_cast<const char*>(memchr(ptr, '.', static_cast<size_t>(key_len)));
+    VALUE head = dot == nullptr ? key : rb_str_new(ptr, dot - ptr);
+    VALUE rest = dot == nullptr ? rb_str_new(nullptr, 0) : rb_str_new(dot + 1, key_len - (dot - ptr) - 1);
+    VALUE group = rb_hash_lookup2(children, head, Qundef);
+    if (group == Qundef) {
+      group = rb_ary_new();
+      rb_hash_aset(children, head, group);
+    }
+    rb_ary_push(group, rb_assoc_new(rest, rb_ary_entry(item, 1)));
+  }
+
+  bool numeric = true;
+  rb_hash_foreach(children, tree_unflatten_numeric_iter, reinterpret_cast<VALUE>(&numeric));
+  if (numeric) {
+    VALUE indices = rb_ary_new_capa(static_cast<long>(RHASH_SIZE(children)));
+    rb_hash_foreach(children, tree_unflatten_index_iter, indices);
+    rb_ary_sort_bang(indices);
+    VALUE out = rb_ary_new();
+    const long count = RARRAY_LEN(indices);
+    for (long i = 0; i < count; ++i) {
+      VALUE index = RARRAY_AREF(indices, i);
+      VALUE pairs = rb_hash_lookup2(children, rb_obj_as_string(index), Qundef);
+      if (pairs == Qundef) {
+        pairs = rb_ary_new();
       }
-    } else if (argc == 4) {
-      m = NUM2INT(argv[1]);
-      k = NUM2INT(argv[2]);
-      dtype = optional_dtype_from_value(argv[3]).value_or(mx::float32);
+      rb_ary_store(out, NUM2LONG(index), tree_unflatten_items(pairs));
     }
+    return out;
+  }
 
-    return array_wrap(mx::eye(n, m, k, dtype));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+  VALUE out = rb_hash_new();
+  rb_hash_foreach(children, tree_unflatten_hash_iter, out);
+  return out;
+}
+
+static VALUE utils_native_tree_unflatten(VALUE, VALUE tree) {
+  VALUE items = Qnil;
+  if (RB_TYPE_P(tree, T_HASH)) {
+    items = rb_funcall(tree, cached_intern_id("to_a"), 0);
+  } else if (RB_TYPE_P(tree, T_ARRAY)) {
+    items = tree;
+  } else {
+    rb_raise(rb_eArgError, "tree must be an Array of pairs or Hash");
+  }
+  return tree_unflatten_items(items);
+}
+
+// Bounded cache behind MLX::Core.compile. Entries are keyed by the input
+// TreeSpec plus each input's dtype and shape (rank only when shapeless),
+// which is what upstream compile specializes on, and are evicted in LRU
+// order once the process-wide limit is reached. The limit counts entries
+// across every compiled function: each use stamps the entry with a global
+// tick, and eviction drops the stalest tail entry among all live caches.
+struct CompileCacheEntry {
+  VALUE spec;
+  std::vector<int64_t> signature;
+  uint64_t hash;
+  VALUE value;
+  uint64_t last_used;
+};
+
+struct CompileCacheWrapper {
+  // Most recently used first.
+  std::list<CompileCacheEntry> entries;
+  std::unordered_multimap<uint64_t, std::list<CompileCacheEntry>::iterator> index;
+  bool shapeless = false;
+};
+
+struct CompileCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t traces = 0;
+  uint64_t evictions = 0;
+  uint64_t trace_ns = 0;
+  uint64_t entries = 0;
+  long limit = 64;
+};
+
+static CompileCacheStats compile_cache_stats;
+static uint64_t compile_cache_tick = 0;
+static std::unordered_set<CompileCacheWrapper*> compile_caches;
+
+static void compile_cache_mark(void* ptr) {
+  auto* wrapper = static_cast<CompileCacheWrapper*>(ptr);
+  for (const auto& entry : wrapper->entries) {
+    rb_gc_mark(entry.spec);
+    rb_gc_mark(entry.value);
   }
 }
 
-static VALUE core_identity(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE n;
-    VALUE dtype;
-    rb_scan_args(argc, argv, "11", &n, &dtype);
-    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
-    return array_wrap(mx::identity(NUM2INT(n), target_dtype));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+static void compile_cache_free(void* ptr) {
+  auto* wrapper = static_cast<CompileCacheWrapper*>(ptr);
+  compile_cache_stats.entries -= wrapper->entries.size();
+  compile_caches.erase(wrapper);
+  delete wrapper;
+}
+
+static size_t compile_cache_memsize(const void* ptr) {
+  const auto* wrapper = static_cast<const CompileCacheWrapper*>(ptr);
+  size_t size = sizeof(CompileCacheWrapper);
+  for (const auto& entry : wrapper->entries) {
+    size += sizeof(CompileCacheEntry) + entry.signature.capacity() * sizeof(int64_t);
   }
+  return size;
 }
 
-static VALUE core_tri(int argc, VALUE* argv, VALUE) {
-  try {
-    if (argc < 1 || argc > 4) {
-      rb_raise(rb_eArgError, "tri expects 1 to 4 arguments");
+static const rb_data_type_t compile_cache_data_type = {
+    "MLX::Core::CompileCache",
+    {compile_cache_mark, compile_cache_free, compile_cache_memsize, nullptr, nullptr},
+    nullptr,
+    nullptr,
+    RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+static VALUE compile_cache_alloc(VALUE klass) {
+  auto* wrapper = new CompileCacheWrapper();
+  VALUE object = TypedData_Wrap_Struct(klass, &compile_cache_data_type, wrapper);
+  compile_caches.insert(wrapper);
+  return object;
+}
+
+static CompileCacheWrapper* compile_cache_unwrap(VALUE object) {
+  CompileCacheWrapper* wrapper = nullptr;
+  TypedData_Get_Struct(object, CompileCacheWrapper, &compile_cache_data_type, wrapper);
+  return wrapper;
+}
+
+static VALUE compile_cache_initialize(int argc, VALUE* argv, VALUE self) {
+  VALUE shapeless;
+  rb_scan_args(argc, argv, "01", &shapeless);
+  compile_cache_unwrap(self)->shapeless = RTEST(shapeless);
+  return self;
+}
+
+static void compile_cache_evict() {
+  while (compile_cache_stats.entries > static_cast<uint64_t>(compile_cache_stats.limit)) {
+    CompileCacheWrapper* cache = nullptr;
+    for (auto* candidate : compile_caches) {
+      if (!candidate->entries.empty() &&
+          (cache == nullptr || candidate->entries.back().last_used < cache->entries.back().last_used)) {
+        cache = candidate;
+      }
     }
+    if (cache == nullptr) {
+      return;
+    }
+    auto victim = std::prev(cache->entries.end());
+    auto range = cache->index.equal_range(victim->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == victim) {
+        cache->index.erase(it);
+        break;
+      }
+    }
+    cache->entries.erase(victim);
+    compile_cache_stats.evictions++;
+    compile_cache_stats.entries--;
+  }
+}
 
-    const int n = NUM2INT(argv[0]);
-    int m = n;
-    int k = 0;
-    mx::Dtype dtype = mx::float32;
+// Returns the entry cached for (spec, arrays), yielding to build it on a
+// miss. A block that raises leaves the cache unchanged.
+static VALUE compile_cache_fetch(VALUE self, VALUE spec, VALUE arrays) {
+  auto* cache = compile_cache_unwrap(self);
+  const TreeSpecWrapper* spec_wrapper = tree_spec_unwrap(spec);
+  Check_Type(arrays, T_ARRAY);
 
-    if (argc == 2) {
-      if (value_looks_like_dtype(argv[1])) {
-        dtype = optional_dtype_from_value(argv[1]).value_or(mx::float32);
-      } else {
-        m = NUM2INT(argv[1]);
+  int state = 0;
+  VALUE value = Qnil;
+  {
+    std::vector<int64_t> signature;
+    uint64_t hash = spec_wrapper->fingerprint;
+    const long count = RARRAY_LEN(arrays);
+    signature.reserve(static_cast<size_t>(count) * 4);
+    for (long i = 0; i < count; ++i) {
+      const auto& array = array_unwrap(RARRAY_AREF(arrays, i));
+      signature.push_back(static_cast<int64_t>(array.dtype().val()));
+      signature.push_back(static_cast<int64_t>(array.ndim()));
+      if (!cache->shapeless) {
+        for (auto dim : array.shape()) {
+          signature.push_back(static_cast<int64_t>(dim));
+        }
       }
-    } else if (argc == 3) {
-      if (value_looks_like_dtype(argv[2])) {
-        m = NUM2INT(argv[1]);
-        dtype = optional_dtype_from_value(argv[2]).value_or(mx::float32);
-      } else {
-        m = NUM2INT(argv[1]);
-        k = NUM2INT(argv[2]);
+    }
+    for (auto item : signature) {
+      hash ^= static_cast<uint64_t>(item) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+
+    auto range = cache->index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      auto entry = it->second;
+      if (entry->signature == signature && RTEST(tree_spec_eql(entry->spec, spec))) {
+        cache->entries.splice(cache->entries.begin(), cache->entries, entry);
+        entry->last_used = ++compile_cache_tick;
+        compile_cache_stats.hits++;
+        return entry->value;
       }
-    } else if (argc == 4) {
-      m = NUM2INT(argv[1]);
-      k = NUM2INT(argv[2]);
-      dtype = optional_dtype_from_value(argv[3]).value_or(mx::float32);
     }
 
-    return array_wrap(mx::tri(n, m, k, dtype));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+    compile_cache_stats.misses++;
+    value = rb_protect(rb_yield, Qnil, &state);
+    if (state == 0) {
+      cache->entries.push_front({spec, std::move(signature), hash, value, ++compile_cache_tick});
+      cache->index.emplace(hash, cache->entries.begin());
+      compile_cache_stats.entries++;
+      compile_cache_evict();
+    }
+  }
+  if (state != 0) {
+    rb_jump_tag(state);
   }
+  return value;
 }
 
-static VALUE core_tril(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE k;
-    rb_scan_args(argc, argv, "11", &array, &k);
-    const int k_v = NIL_P(k) ? 0 : NUM2INT(k);
-    return array_wrap(mx::tril(array_unwrap(array), k_v));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+// Runs the block as one trace of a compiled function and records its
+// wall time in the compile stats.
+static VALUE compile_cache_trace(VALUE self) {
+  compile_cache_unwrap(self);
+  const auto start = std::chrono::steady_clock::now();
+  int state = 0;
+  VALUE result = rb_protect(rb_yield, Qnil, &state);
+  compile_cache_stats.traces++;
+  compile_cache_stats.trace_ns += static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+          .count());
+  if (state != 0) {
+    rb_jump_tag(state);
   }
+  return result;
 }
 
-static VALUE core_triu(int argc, VALUE* argv, VALUE) {
-  try {
-    VALUE array;
-    VALUE k;
-    rb_scan_args(argc, argv, "11", &array, &k);
-    const int k_v = NIL_P(k) ? 0 : NUM2INT(k);
-    return array_wrap(mx::triu(array_unwrap(array), k_v));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
-  }
+static VALUE compile_cache_size(VALUE self) {
+  return SIZET2NUM(compile_cache_unwrap(self)->entries.size());
 }
 
-static VALUE core_astype(VALUE, VALUE array, VALUE dtype) {
-  try {
-    auto target_dtype = optional_dtype_from_value(dtype).value_or(mx::float32);
-    return array_wrap(mx::astype(array_unwrap(array), target_dtype));
-  } catch (const std::exception& error) {
-    raise_std_exception(error);
-    return Qnil;
+static VALUE compile_cache_clear(VALUE self) {
+  auto* cache = compile_cache_unwrap(self);
+  compile_cache_stats.entries -= cache->entries.size();
+  cache->index.clear();
+  cache->entries.clear();
+  return self;
+}
+
+static VALUE core_set_compile_cache_limit(VALUE, VALUE limit) {
+  const long value = NUM2LONG(limit);
+  if (value < 1) {
+    rb_raise(rb_eArgError, "compile cache limit must be a positive Integer");
   }
+  const long previous = compile_cache_stats.limit;
+  compile_cache_stats.limit = value;
+  compile_cache_evict();
+  return LONG2NUM(previous);
+}
+
+static VALUE core_compile_cache_limit(VALUE) {
+  return LONG2NUM(compile_cache_stats.limit);
+}
+
+static VALUE core_compile_stats(VALUE) {
+  const auto& stats = compile_cache_stats;
+  VALUE hash = rb_hash_new();
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("hits"), ULL2NUM(stats.hits));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("misses"), ULL2NUM(stats.misses));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("traces"), ULL2NUM(stats.traces));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("evictions"), ULL2NUM(stats.evictions));
+  rb_hash_aset(
+      hash, rb_utf8_str_new_cstr("trace_seconds"), DBL2NUM(static_cast<double>(stats.trace_ns) / 1e9));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("entries"), ULL2NUM(stats.entries));
+  return hash;
+}
+
+// Resets the counters; the live entry count is left as is.
+static VALUE core_reset_compile_stats(VALUE) {
+  auto& stats = compile_cache_stats;
+  stats.hits = 0;
+  stats.misses = 0;
+  stats.traces = 0;
+  stats.evictions = 0;
+  stats.trace_ns = 0;
+  return Qnil;
 }
 
 static VALUE native_loaded_p(VALUE) {
@@ -6593,6 +10963,100 @@ static VALUE core_set_memory_limit(VALUE, VALUE limit) {
   }
 }
 
+static VALUE core_set_gc_memory_fraction(VALUE, VALUE fraction) {
+  const double previous = gc_memory_policy.fraction;
+  double value = 0.0;
+  if (!NIL_P(fraction)) {
+    value = NUM2DBL(fraction);
+    if (!(value > 0.0 && value <= 1.0)) {
+      rb_raise(rb_eArgError, "gc memory fraction must be nil or in (0, 1]");
+    }
+  }
+  gc_memory_policy.fraction = value;
+  gc_memory_policy.next_trigger = 0;
+  return previous > 0.0 ? DBL2NUM(previous) : Qnil;
+}
+
+static VALUE core_gc_memory_fraction(VALUE) {
+  return gc_memory_policy.fraction > 0.0 ? DBL2NUM(gc_memory_policy.fraction) : Qnil;
+}
+
+static constexpr const char* kGvlWorkNames[GvlPolicy::kKinds] = {"graph", "eval", "io"};
+
+static GvlWork gvl_work_from_ruby(VALUE kind) {
+  VALUE name = SYMBOL_P(kind) ? rb_sym2str(kind) : kind;
+  if (RB_TYPE_P(name, T_STRING)) {
+    const std::string name_v = string_from_ruby(name);
+    for (size_t i = 0; i < GvlPolicy::kKinds; ++i) {
+      if (name_v == kGvlWorkNames[i]) {
+        return static_cast<GvlWork>(i);
+      }
+    }
+  }
+  rb_raise(rb_eArgError, "GVL work kind must be :graph, :eval, or :io");
+  return GvlWork::Graph;
+}
+
+static VALUE core_set_gvl_policy(VALUE, VALUE kind, VALUE release) {
+  const auto index = static_cast<size_t>(gvl_work_from_ruby(kind));
+  const bool previous = gvl_policy.release[index];
+  gvl_policy.release[index] = RTEST(release);
+  return previous ? Qtrue : Qfalse;
+}
+
+static VALUE core_gvl_policy(VALUE) {
+  VALUE hash = rb_hash_new();
+  for (size_t i = 0; i < GvlPolicy::kKinds; ++i) {
+    rb_hash_aset(hash, rb_utf8_str_new_cstr(kGvlWorkNames[i]), gvl_policy.release[i] ? Qtrue : Qfalse);
+  }
+  return hash;
+}
+
+static VALUE core_gvl_stats(VALUE) {
+  VALUE hash = rb_hash_new();
+  for (size_t i = 0; i < GvlPolicy::kKinds; ++i) {
+    VALUE entry = rb_hash_new();
+    rb_hash_aset(entry, rb_utf8_str_new_cstr("held_calls"), ULL2NUM(gvl_policy.held_calls[i]));
+    rb_hash_aset(entry, rb_utf8_str_new_cstr("released_calls"), ULL2NUM(gvl_policy.released_calls[i]));
+    rb_hash_aset(
+        entry,
+        rb_utf8_str_new_cstr("released_seconds"),
+        DBL2NUM(static_cast<double>(gvl_policy.released_ns[i]) / 1e9));
+    rb_hash_aset(hash, rb_utf8_str_new_cstr(kGvlWorkNames[i]), entry);
+  }
+  return hash;
+}
+
+static VALUE core_reset_gvl_stats(VALUE) {
+  for (size_t i = 0; i < GvlPolicy::kKinds; ++i) {
+    gvl_policy.held_calls[i] = 0;
+    gvl_policy.released_calls[i] = 0;
+    gvl_policy.released_ns[i] = 0;
+  }
+  return Qnil;
+}
+
+static VALUE core_wrapper_stats(VALUE) {
+  const auto& pool = array_wrapper_pool;
+  VALUE hash = rb_hash_new();
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("created"), ULL2NUM(pool.created));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("freed"), ULL2NUM(pool.freed));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("live"), ULL2NUM(pool.live));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("pool_hits"), ULL2NUM(pool.pool_hits));
+  rb_hash_aset(hash, rb_utf8_str_new_cstr("pooled"), ULL2NUM(pool.blocks.size()));
+  return hash;
+}
+
+// Resets the churn counters, e.g. at the start of a training step. The
+// live count is not a counter and is left as is.
+static VALUE core_reset_wrapper_stats(VALUE) {
+  auto& pool = array_wrapper_pool;
+  pool.created = 0;
+  pool.freed = 0;
+  pool.pool_hits = 0;
+  return Qnil;
+}
+
 static VALUE core_set_cache_limit(VALUE, VALUE limit) {
   try {
     const auto previous = mx::set_cache_limit(static_cast<size_t>(NUM2ULL(limit)));
@@ -6956,31 +11420,12 @@ static VALUE core_synchronize(int argc, VALUE* argv, VALUE) {
     VALUE stream;
     rb_scan_args(argc, argv, "01", &stream);
 
-    struct CoreSynchronizePayload {
-      bool has_stream;
-      mx::Stream stream;
-      std::exception_ptr error;
-    };
-    auto core_synchronize_without_gvl = [](void* arg) -> void* {
-      auto* payload = reinterpret_cast<CoreSynchronizePayload*>(arg);
-      try {
-        if (payload->has_stream) {
-          mx::synchronize(payload->stream);
-        } else {
-          mx::synchronize();
-        }
-      } catch (...) {
-        payload->error = std::current_exception();
-      }
-      return nullptr;
-    };
-
-    CoreSynchronizePayload payload{
-        !NIL_P(stream),
-        NIL_P(stream) ? mx::default_stream(mx::default_device()) : stream_unwrap(stream),
-        nullptr};
-    rb_thread_call_without_gvl(core_synchronize_without_gvl, &payload, RUBY_UBF_IO, nullptr);
-    rethrow_captured_exception(payload.error);
+    if (NIL_P(stream)) {
+      call_with_gvl_policy(GvlWork::Eval, []() { mx::synchronize(); });
+    } else {
+      const mx::Stream stream_v = stream_unwrap(stream);
+      call_with_gvl_policy(GvlWork::Eval, [&]() { mx::synchronize(stream_v); });
+    }
     return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -7004,6 +11449,60 @@ static VALUE core_stream_yield(VALUE) {
   return rb_yield(Qnil);
 }
 
+static void array_scope_keep_tree(VALUE value);
+
+static int array_scope_keep_hash_iter(VALUE, VALUE value, VALUE) {
+  array_scope_keep_tree(value);
+  return ST_CONTINUE;
+}
+
+static void array_scope_keep_tree(VALUE value) {
+  if (rb_obj_is_kind_of(value, cArray)) {
+    ArrayWrapper* wrapper = nullptr;
+    TypedData_Get_Struct(value, ArrayWrapper, &array_data_type, wrapper);
+    array_scope_keep(wrapper);
+  } else if (RB_TYPE_P(value, T_ARRAY)) {
+    const long len = RARRAY_LEN(value);
+    for (long i = 0; i < len; ++i) {
+      array_scope_keep_tree(RARRAY_AREF(value, i));
+    }
+  } else if (RB_TYPE_P(value, T_HASH)) {
+    rb_hash_foreach(value, array_scope_keep_hash_iter, Qnil);
+  }
+}
+
+static VALUE core_scope_yield(VALUE) {
+  VALUE result = rb_yield(Qnil);
+  array_scope_keep_tree(result);
+  return result;
+}
+
+static VALUE core_scope_exit(VALUE arg) {
+  auto* scope = reinterpret_cast<ArrayScope*>(arg);
+  set_current_array_scope(scope->parent);
+  --open_array_scopes;
+  for (ArrayWrapper* wrapper : scope->tracked) {
+    array_wrapper_release(wrapper);
+  }
+  delete scope;
+  return Qnil;
+}
+
+// Releases the mx::array of every wrapper created inside the block unless
+// it is part of the block's return value or was passed to keep.
+static VALUE core_scope(VALUE) {
+  rb_need_block();
+  auto* scope = new ArrayScope{current_array_scope(), {}};
+  ++open_array_scopes;
+  set_current_array_scope(scope);
+  return rb_ensure(core_scope_yield, Qnil, core_scope_exit, reinterpret_cast<VALUE>(scope));
+}
+
+static VALUE core_keep(VALUE, VALUE value) {
+  array_scope_keep_tree(value);
+  return value;
+}
+
 static VALUE core_stream(VALUE, VALUE stream_or_device) {
   try {
     mx::Device target_device = mx::default_device();
@@ -7175,23 +11674,7 @@ static VALUE core_eval(int argc, VALUE* argv, VALUE) {
       collect_arrays_from_tree(argv[i], arrays);
     }
 
-    struct CoreEvalPayload {
-      std::vector<mx::array>* arrays;
-      std::exception_ptr error;
-    };
-    auto core_eval_without_gvl = [](void* arg) -> void* {
-      auto* payload = reinterpret_cast<CoreEvalPayload*>(arg);
-      try {
-        mx::eval(*payload->arrays);
-      } catch (...) {
-        payload->error = std::current_exception();
-      }
-      return nullptr;
-    };
-
-    CoreEvalPayload payload{&arrays, nullptr};
-    rb_thread_call_without_gvl(core_eval_without_gvl, &payload, RUBY_UBF_IO, nullptr);
-    rethrow_captured_exception(payload.error);
+    call_with_gvl_policy(GvlWork::Eval, [&]() { mx::eval(arrays); });
     return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -7207,23 +11690,7 @@ static VALUE core_async_eval(int argc, VALUE* argv, VALUE) {
       collect_arrays_from_tree(argv[i], arrays);
     }
 
-    struct CoreAsyncEvalPayload {
-      std::vector<mx::array>* arrays;
-      std::exception_ptr error;
-    };
-    auto core_async_eval_without_gvl = [](void* arg) -> void* {
-      auto* payload = reinterpret_cast<CoreAsyncEvalPayload*>(arg);
-      try {
-        mx::async_eval(*payload->arrays);
-      } catch (...) {
-        payload->error = std::current_exception();
-      }
-      return nullptr;
-    };
-
-    CoreAsyncEvalPayload payload{&arrays, nullptr};
-    rb_thread_call_without_gvl(core_async_eval_without_gvl, &payload, RUBY_UBF_IO, nullptr);
-    rethrow_captured_exception(payload.error);
+    call_with_gvl_policy(GvlWork::Eval, [&]() { mx::async_eval(arrays); });
     return Qnil;
   } catch (const std::exception& error) {
     raise_std_exception(error);
@@ -7624,6 +12091,16 @@ extern "C" void Init_native(void) {
   rb_define_singleton_method(mCore, "get_cache_memory", RUBY_METHOD_FUNC(core_get_cache_memory), 0);
   rb_define_singleton_method(mCore, "set_memory_limit", RUBY_METHOD_FUNC(core_set_memory_limit), 1);
   rb_define_singleton_method(mCore, "set_cache_limit", RUBY_METHOD_FUNC(core_set_cache_limit), 1);
+  rb_define_singleton_method(
+      mCore, "set_gc_memory_fraction", RUBY_METHOD_FUNC(core_set_gc_memory_fraction), 1);
+  rb_define_singleton_method(mCore, "gc_memory_fraction", RUBY_METHOD_FUNC(core_gc_memory_fraction), 0);
+  rb_define_singleton_method(mCore, "set_gvl_policy", RUBY_METHOD_FUNC(core_set_gvl_policy), 2);
+  rb_define_singleton_method(mCore, "gvl_policy", RUBY_METHOD_FUNC(core_gvl_policy), 0);
+  rb_define_singleton_method(mCore, "gvl_stats", RUBY_METHOD_FUNC(core_gvl_stats), 0);
+  rb_define_singleton_method(mCore, "reset_gvl_stats", RUBY_METHOD_FUNC(core_reset_gvl_stats), 0);
+  rb_define_singleton_method(mCore, "wrapper_stats", RUBY_METHOD_FUNC(core_wrapper_stats), 0);
+  rb_define_singleton_method(
+      mCore, "reset_wrapper_stats", RUBY_METHOD_FUNC(core_reset_wrapper_stats), 0);
   rb_define_singleton_method(mCore, "set_wired_limit", RUBY_METHOD_FUNC(core_set_wired_limit), 1);
   rb_define_singleton_method(mCore, "clear_cache", RUBY_METHOD_FUNC(core_clear_cache), 0);
   rb_define_singleton_method(mCore, "metal_is_available", RUBY_METHOD_FUNC(core_metal_is_available), 0);
@@ -7651,16 +12128,52 @@ extern "C" void Init_native(void) {
   rb_define_method(cArray, "dtype", RUBY_METHOD_FUNC(array_dtype), 0);
   rb_define_method(cArray, "item", RUBY_METHOD_FUNC(array_item), 0);
   rb_define_method(cArray, "to_a", RUBY_METHOD_FUNC(array_to_a), 0);
+  rb_define_method(cArray, "each_row", RUBY_METHOD_FUNC(array_each_row), 0);
+  rb_define_method(cArray, "each_slice", RUBY_METHOD_FUNC(array_each_slice), 1);
   rb_define_method(cArray, "+", RUBY_METHOD_FUNC(array_add), 1);
   rb_define_method(cArray, "-", RUBY_METHOD_FUNC(array_subtract), 1);
   rb_define_method(cArray, "*", RUBY_METHOD_FUNC(array_multiply), 1);
   rb_define_method(cArray, "/", RUBY_METHOD_FUNC(array_divide), 1);
-  rb_define_method(cArray, "[]", RUBY_METHOD_FUNC(array_aref), 1);
+  rb_define_method(cArray, "add", RUBY_METHOD_FUNC(array_add), 1);
+  rb_define_method(cArray, "subtract", RUBY_METHOD_FUNC(array_subtract), 1);
+  rb_define_method(cArray, "multiply", RUBY_METHOD_FUNC(array_multiply), 1);
+  rb_define_method(cArray, "divide", RUBY_METHOD_FUNC(array_divide), 1);
+  rb_define_method(cArray, "__add__", RUBY_METHOD_FUNC(array_add), 1);
+  rb_define_method(cArray, "__sub__", RUBY_METHOD_FUNC(array_subtract), 1);
+  rb_define_method(cArray, "__mul__", RUBY_METHOD_FUNC(array_multiply), 1);
+  rb_define_method(cArray, "__truediv__", RUBY_METHOD_FUNC(array_divide), 1);
+  rb_define_method(cArray, "__div__", RUBY_METHOD_FUNC(array_divide), 1);
+  rb_define_method(cArray, "__matmul__", RUBY_METHOD_FUNC(array_matmul), 1);
+  rb_define_method(cArray, "__imatmul__", RUBY_METHOD_FUNC(array_matmul), 1);
+  rb_define_method(cArray, "__neg__", RUBY_METHOD_FUNC(array_negative), 0);
+  rb_define_method(cArray, "__abs__", RUBY_METHOD_FUNC(array_abs), 0);
+  rb_define_method(cArray, "square", RUBY_METHOD_FUNC(array_square), 0);
+  rb_define_method(cArray, "sqrt", RUBY_METHOD_FUNC(array_sqrt), 0);
+  rb_define_method(cArray, "rsqrt", RUBY_METHOD_FUNC(array_rsqrt), 0);
+  rb_define_method(cArray, "exp", RUBY_METHOD_FUNC(array_exp), 0);
+  rb_define_method(cArray, "log", RUBY_METHOD_FUNC(array_log), 0);
+  rb_define_method(cArray, "abs", RUBY_METHOD_FUNC(array_abs), 0);
+  rb_define_method(cArray, "sum", RUBY_METHOD_FUNC(array_sum), -1);
+  rb_define_method(cArray, "mean", RUBY_METHOD_FUNC(array_mean), -1);
+  rb_define_method(cArray, "max", RUBY_METHOD_FUNC(array_max), -1);
+  rb_define_method(cArray, "min", RUBY_METHOD_FUNC(array_min), -1);
+  rb_define_method(cArray, "reshape", RUBY_METHOD_FUNC(array_reshape), -1);
+  rb_define_method(cArray, "transpose", RUBY_METHOD_FUNC(array_transpose), -1);
+  rb_define_method(cArray, "flatten", RUBY_METHOD_FUNC(array_flatten), -1);
+  rb_define_method(cArray, "astype", RUBY_METHOD_FUNC(array_astype), -1);
+  rb_define_method(cArray, "[]", RUBY_METHOD_FUNC(array_aref), -1);
+  rb_define_method(cArray, "__setitem__", RUBY_METHOD_FUNC(array_setitem), -1);
+  rb_define_method(cArray, "__at_update__", RUBY_METHOD_FUNC(array_at_update), -1);
+  rb_define_method(cArray, "_dump", RUBY_METHOD_FUNC(array_marshal_dump), 1);
+  rb_define_singleton_method(cArray, "_load", RUBY_METHOD_FUNC(array_marshal_load), 1);
   rb_define_method(cArray, "to_s", RUBY_METHOD_FUNC(array_to_s), 0);
   rb_define_method(cArray, "inspect", RUBY_METHOD_FUNC(array_to_s), 0);
+  rb_memory_view_register(cArray, &array_memory_view_entry);
 
   rb_define_singleton_method(mCore, "array", RUBY_METHOD_FUNC(core_array), -1);
   rb_define_singleton_method(mCore, "asarray", RUBY_METHOD_FUNC(core_array), -1);
+  rb_define_singleton_method(mCore, "from_bytes", RUBY_METHOD_FUNC(core_from_bytes), -1);
+  rb_define_singleton_method(mCore, "from_io", RUBY_METHOD_FUNC(core_from_io), -1);
   rb_define_singleton_method(mCore, "broadcast_shapes", RUBY_METHOD_FUNC(core_broadcast_shapes), -1);
   rb_define_singleton_method(mCore, "add", RUBY_METHOD_FUNC(core_add), 2);
   rb_define_singleton_method(mCore, "subtract", RUBY_METHOD_FUNC(core_subtract), 2);
@@ -7715,6 +12228,21 @@ extern "C" void Init_native(void) {
   rb_define_singleton_method(mCore, "depends", RUBY_METHOD_FUNC(core_depends), 2);
   rb_define_singleton_method(mCore, "save", RUBY_METHOD_FUNC(core_save), 2);
   rb_define_singleton_method(mCore, "load", RUBY_METHOD_FUNC(core_load), -1);
+  cSafetensorsFile = rb_define_class_under(mCore, "SafetensorsFile", rb_cObject);
+  rb_define_alloc_func(cSafetensorsFile, safetensors_file_alloc);
+  rb_define_method(cSafetensorsFile, "initialize", RUBY_METHOD_FUNC(safetensors_file_initialize), 1);
+  rb_define_method(cSafetensorsFile, "keys", RUBY_METHOD_FUNC(safetensors_file_keys), 0);
+  rb_define_method(cSafetensorsFile, "key?", RUBY_METHOD_FUNC(safetensors_file_key_p), 1);
+  rb_define_method(cSafetensorsFile, "[]", RUBY_METHOD_FUNC(safetensors_file_aref), 1);
+  rb_define_method(cSafetensorsFile, "size", RUBY_METHOD_FUNC(safetensors_file_size), 0);
+  rb_define_method(cSafetensorsFile, "nbytes", RUBY_METHOD_FUNC(safetensors_file_nbytes), 0);
+  rb_define_method(cSafetensorsFile, "metadata", RUBY_METHOD_FUNC(safetensors_file_metadata), 0);
+  rb_define_method(cSafetensorsFile, "slice", RUBY_METHOD_FUNC(safetensors_file_slice), 1);
+  rb_define_singleton_method(
+      mCore, "load_safetensors_shards", RUBY_METHOD_FUNC(core_load_safetensors_shards), 3);
+  rb_define_singleton_method(mCore, "collate_samples", RUBY_METHOD_FUNC(core_collate_samples), 3);
+  rb_define_singleton_method(
+      mCore, "save_safetensors_shards", RUBY_METHOD_FUNC(core_save_safetensors_shards), 2);
   rb_define_singleton_method(mCore, "save_safetensors", RUBY_METHOD_FUNC(core_save_safetensors), -1);
   rb_define_singleton_method(mCore, "save_gguf", RUBY_METHOD_FUNC(core_save_gguf), -1);
   rb_define_singleton_method(mCore, "savez", RUBY_METHOD_FUNC(core_savez), -1);
@@ -7988,6 +12516,14 @@ extern "C" void Init_native(void) {
   rb_define_method(cFunctionExporter, "[]", RUBY_METHOD_FUNC(function_exporter_call), -1);
   rb_define_method(cFunctionExporter, "close", RUBY_METHOD_FUNC(function_exporter_close), 0);
 
+  cDLPackCapsule = rb_define_class_under(mCore, "DLPackCapsule", rb_cObject);
+  rb_define_alloc_func(cDLPackCapsule, dlpack_capsule_alloc);
+  rb_define_method(cDLPackCapsule, "address", RUBY_METHOD_FUNC(dlpack_capsule_address), 0);
+  rb_define_method(cDLPackCapsule, "consume", RUBY_METHOD_FUNC(dlpack_capsule_consume), 0);
+  rb_define_method(cDLPackCapsule, "consumed?", RUBY_METHOD_FUNC(dlpack_capsule_consumed_p), 0);
+  rb_define_singleton_method(
+      mCore, "from_dlpack_address", RUBY_METHOD_FUNC(core_from_dlpack_address), 1);
+
   cKernel = rb_define_class_under(mCore, "Kernel", rb_cObject);
   rb_define_alloc_func(cKernel, kernel_alloc);
   rb_define_method(cKernel, "call", RUBY_METHOD_FUNC(kernel_call), -1);
@@ -7997,6 +12533,36 @@ extern "C" void Init_native(void) {
   rb_define_singleton_method(mCore, "set_default_stream", RUBY_METHOD_FUNC(core_set_default_stream), 1);
   rb_define_singleton_method(mCore, "new_stream", RUBY_METHOD_FUNC(core_new_stream), 1);
   rb_define_singleton_method(mCore, "stream", RUBY_METHOD_FUNC(core_stream), 1);
+  cTreeSpec = rb_define_class_under(mCore, "TreeSpec", rb_cObject);
+  rb_undef_alloc_func(cTreeSpec);
+  rb_define_method(cTreeSpec, "hash", RUBY_METHOD_FUNC(tree_spec_hash), 0);
+  rb_define_method(cTreeSpec, "eql?", RUBY_METHOD_FUNC(tree_spec_eql), 1);
+  rb_define_method(cTreeSpec, "==", RUBY_METHOD_FUNC(tree_spec_eql), 1);
+  rb_define_method(cTreeSpec, "leaf_count", RUBY_METHOD_FUNC(tree_spec_leaf_count), 0);
+  rb_define_singleton_method(mCore, "tree_flatten_spec", RUBY_METHOD_FUNC(core_tree_flatten_spec), 3);
+  rb_define_singleton_method(mCore, "tree_inflate", RUBY_METHOD_FUNC(core_tree_inflate), 3);
+  cCompileCache = rb_define_class_under(mCore, "CompileCache", rb_cObject);
+  rb_define_alloc_func(cCompileCache, compile_cache_alloc);
+  rb_define_method(cCompileCache, "initialize", RUBY_METHOD_FUNC(compile_cache_initialize), -1);
+  rb_define_method(cCompileCache, "fetch", RUBY_METHOD_FUNC(compile_cache_fetch), 2);
+  rb_define_method(cCompileCache, "trace", RUBY_METHOD_FUNC(compile_cache_trace), 0);
+  rb_define_method(cCompileCache, "size", RUBY_METHOD_FUNC(compile_cache_size), 0);
+  rb_define_method(cCompileCache, "clear", RUBY_METHOD_FUNC(compile_cache_clear), 0);
+  rb_define_singleton_method(
+      mCore, "set_compile_cache_limit", RUBY_METHOD_FUNC(core_set_compile_cache_limit), 1);
+  rb_define_singleton_method(mCore, "compile_cache_limit", RUBY_METHOD_FUNC(core_compile_cache_limit), 0);
+  rb_define_singleton_method(mCore, "compile_stats", RUBY_METHOD_FUNC(core_compile_stats), 0);
+  rb_define_singleton_method(mCore, "reset_compile_stats", RUBY_METHOD_FUNC(core_reset_compile_stats), 0);
+
+  VALUE mUtils = rb_define_module_under(mMLX, "Utils");
+  rb_define_singleton_method(mUtils, "native_tree_map", RUBY_METHOD_FUNC(utils_native_tree_map), 4);
+  rb_define_singleton_method(
+      mUtils, "native_tree_flatten", RUBY_METHOD_FUNC(utils_native_tree_flatten), 4);
+  rb_define_singleton_method(
+      mUtils, "native_tree_unflatten", RUBY_METHOD_FUNC(utils_native_tree_unflatten), 1);
+
+  rb_define_singleton_method(mCore, "scope", RUBY_METHOD_FUNC(core_scope), 0);
+  rb_define_singleton_method(mCore, "keep", RUBY_METHOD_FUNC(core_keep), 1);
   rb_define_singleton_method(mCore, "synchronize", RUBY_METHOD_FUNC(core_synchronize), -1);
   rb_define_singleton_method(mCore, "eval", RUBY_METHOD_FUNC(core_eval), -1);
   rb_define_singleton_method(mCore, "async_eval", RUBY_METHOD_FUNC(core_async_eval), -1);
@@ -1,6 +1,7 @@
 # frozen_string_literal: true
 
-require "open3"
+require "fileutils"
+require "json"
 require "tmpdir"
 
 module MLX
@@ -125,53 +126,58 @@ module MLX
       alias next __next__
     end
 
+    # Accumulating indexed updates, e.g. `x.at[idx].add(1)`. Each operation
+    # is a single native scatter (scatter_add, scatter_prod, scatter_max or
+    # scatter_min), so repeated indices combine instead of overwriting.
     class ArrayAt
       def initialize(array)
         @array = array
         @indices = nil
       end
 
-      def [](indices)
+      def [](*indices)
+        raise ArgumentError, "array.at[] requires at least one index" if indices.empty?
+
         @indices = indices
         self
       end
 
       def add(value)
-        apply(value) { |lhs, rhs| MLX::Core.add(lhs, rhs) }
+        apply(:add, value)
       end
 
       def subtract(value)
-        apply(value) { |lhs, rhs| MLX::Core.subtract(lhs, rhs) }
+        apply(:subtract, value)
       end
 
       def multiply(value)
-        apply(value) { |lhs, rhs| MLX::Core.multiply(lhs, rhs) }
+        apply(:multiply, value)
       end
 
       def divide(value)
-        apply(value) { |lhs, rhs| MLX::Core.divide(lhs, rhs) }
+        apply(:divide, value)
       end
 
       def maximum(value)
-        apply(value) { |lhs, rhs| MLX::Core.maximum(lhs, rhs) }
+        apply(:maximum, value)
       end
 
       def minimum(value)
-        apply(value) { |lhs, rhs| MLX::Core.minimum(lhs, rhs) }
+        apply(:minimum, value)
       end
 
       private
 
-      def apply(value)
+      def apply(op, value)
         raise ArgumentError, "must provide indices to array.at first" if @indices.nil?
 
-        current = @array.__getitem__(@indices)
-        rhs = value.is_a?(MLX::Core::Array) ? value : MLX::Core.array(value, current.dtype)
-        updated = yield(current, rhs)
-        @array.__setitem__(@indices, updated)
+        @array.__at_update__(op, *@indices, value)
       end
     end
 
+    # Wraps a DLManagedTensor (exported lazily by the native extension).
+    # Foreign consumers call #consume to take ownership of the tensor and
+    # must invoke its deleter when done.
     class DLPackCapsule
       attr_reader :array, :dtype, :shape, :device, :stream
 
@@ -197,6 +203,39 @@ module MLX
       end
     end
 
+    # Lazy view of a .safetensors file returned by
+    # MLX::Core.load(file, mmap: true). Each lookup wraps the mapped tensor
+    # bytes in a new array, and the file is only read when that array is
+    # evaluated. The mapping is copy-on-write, so ops that reuse a tensor's
+    # buffer never modify the file. On Metal, tensors whose data is not
+    # page-aligned in the file are copied when they are looked up.
+    class SafetensorsFile
+      include Enumerable
+
+      alias_method :include?, :key? if method_defined?(:key?)
+      alias_method :has_key?, :key? if method_defined?(:key?)
+      alias_method :length, :size if method_defined?(:size)
+
+      def each
+        return enum_for(:each) { size } unless block_given?
+
+        keys.each { |key| yield key, self[key] }
+        self
+      end
+
+      def fetch(key, *default)
+        return self[key] if key?(key)
+        return yield(key) if block_given?
+        return default.first unless default.empty?
+
+        raise KeyError, "tensor not found: #{key}"
+      end
+
+      def to_h
+        keys.to_h { |key| [key, self[key]] }
+      end
+    end
+
     class CustomFunction
       def initialize(fun)
         raise TypeError, "expected callable object" unless fun.respond_to?(:call)
@@ -288,25 +327,6 @@ module MLX
       end
     end
 
-    PY_EXTRACT_NPZ = <<~PY.freeze
-      import os, sys, zipfile
-      src = sys.argv[1]
-      out_dir = sys.argv[2]
-      with zipfile.ZipFile(src, "r") as zf:
-          zf.extractall(out_dir)
-    PY
-
-    PY_BUILD_NPZ = <<~PY.freeze
-      import os, sys, zipfile
-      out_path = sys.argv[1]
-      in_dir = sys.argv[2]
-      compressed = sys.argv[3] == "1"
-      mode = zipfile.ZIP_DEFLATED if compressed else zipfile.ZIP_STORED
-      with zipfile.ZipFile(out_path, "w", compression=mode, allowZip64=True) as zf:
-          for name in sorted(os.listdir(in_dir)):
-              zf.write(os.path.join(in_dir, name), arcname=name)
-    PY
-
     module_function
 
     def ensure_native!
@@ -321,7 +341,7 @@ module MLX
     end
 
     class << self
-      alias_method :native_load, :load if method_defined?(:load)
+      alias_method :native_load, :load if method_defined?(:load) && !method_defined?(:native_load)
       alias_method :native_grad, :grad if method_defined?(:grad) && !method_defined?(:native_grad)
       alias_method :native_value_and_grad,
                    :value_and_grad if method_defined?(:value_and_grad) && !method_defined?(:native_value_and_grad)
@@ -335,34 +355,100 @@ module MLX
       alias_method :native_export_to_dot,
                    :export_to_dot if method_defined?(:export_to_dot) && !method_defined?(:native_export_to_dot)
 
-      %i[savez savez_compressed].each do |method_name|
-        if method_defined?(method_name) && instance_method(method_name).owner == self
-          remove_method(method_name)
-        end
-      end
+      def load(file, format = nil, return_metadata = false, mmap: false, keys: nil, prefix: nil)
+        ensure_native!
+        path = file.respond_to?(:to_path) ? file.to_path.to_s : file.to_s
+        select = !(keys.nil? && prefix.nil?)
 
-      ARRAY_LEAF = :__mlx_array_leaf__
+        unless mmap
+          loaded = native_load(path, format, return_metadata)
+          return loaded unless select
 
-      def load(file, format = nil, return_metadata = false)
-        ensure_native!
-        format_name = (format || infer_format(file)).to_s
-        if format_name == "npz"
-          raise ArgumentError, "metadata not supported for format npz" if return_metadata
+          arrays, metadata = return_metadata ? loaded : [loaded, nil]
+          raise ArgumentError, "keys/prefix selection requires a format that loads a Hash" unless arrays.is_a?(Hash)
 
-          return load_npz(file)
+          selected = arrays.slice(*select_tensor_names(arrays.keys, keys, prefix))
+          return return_metadata ? [selected, metadata] : selected
         end
 
-        native_load(file, format, return_metadata)
+        format_name = (format || File.extname(path).delete_prefix(".")).to_s
+        raise ArgumentError, "mmap loading is only supported for safetensors" unless format_name == "safetensors"
+
+        tensors = SafetensorsFile.new(path)
+        tensors = tensors.slice(select_tensor_names(tensors.keys, keys, prefix)) if select
+        return_metadata ? [tensors, tensors.metadata] : tensors
       end
 
-      def savez(file, *args, **kwargs)
+      # Stacks a batch of samples into MLX arrays in one native pass. Hash
+      # samples collate per key, Ruby Array samples per position, and flat
+      # numeric Arrays or anything else as a single field. Fields whose
+      # leading dimension varies are right-padded with `pad_value` (up to a
+      # multiple of `pad_to_multiple_of` when given). Every field with a
+      # leading axis also gets an int32 lengths array: under `<key>_lengths`
+      # for Hash samples, appended after the fields for tuples, and as
+      # `[batch, lengths]` for a single field. Ruby lists of Integers
+      # collate as int32 and lists of booleans as bool_.
+      def collate(samples, pad_value: 0, pad_to_multiple_of: nil)
         ensure_native!
-        save_npz(file, args, kwargs, false)
+        collate_samples(samples.to_a, pad_value, pad_to_multiple_of)
       end
 
-      def savez_compressed(file, *args, **kwargs)
+      # Loads a sharded safetensors checkpoint from its `*.index.json` (or a
+      # directory holding exactly one). Shards are read concurrently on
+      # native threads; `expected` (name => array or shape) is checked
+      # against the shard headers before any tensor data is read.
+      def load_sharded(path, expected: nil, num_threads: nil)
         ensure_native!
-        save_npz(file, args, kwargs, true)
+        index_path = sharded_index_path(path.respond_to?(:to_path) ? path.to_path.to_s : path.to_s)
+        weight_map = JSON.parse(File.read(index_path)).fetch("weight_map") do
+          raise ArgumentError, "#{index_path} has no weight_map"
+        end
+        dir = File.dirname(index_path)
+        shards = weight_map.values.uniq.map { |file| File.join(dir, file) }
+
+        loaded = load_safetensors_shards(shards, expected, num_threads)
+        missing = weight_map.keys - loaded.keys
+        raise KeyError, "index lists tensors missing from shards: #{missing.first(5).join(", ")}" unless missing.empty?
+
+        loaded
+      end
+
+      # Splits `arrays` into safetensors shards of at most `max_shard_size`
+      # bytes (a single larger tensor gets its own shard), writes them in
+      # parallel and returns the path of the written index.
+      def save_sharded(dir, arrays, max_shard_size: 5 * 1024**3, prefix: "model", metadata: nil, num_threads: nil)
+        ensure_native!
+        raise ArgumentError, "max_shard_size must be positive" unless max_shard_size.positive?
+
+        groups = [[]]
+        group_bytes = 0
+        total_bytes = 0
+        arrays.each do |name, value|
+          array = value.is_a?(MLX::Core::Array) ? value : MLX::Core.array(value)
+          bytes = array.nbytes
+          if !groups.last.empty? && group_bytes + bytes > max_shard_size
+            groups << []
+            group_bytes = 0
+          end
+          groups.last << [name.to_s, array]
+          group_bytes += bytes
+          total_bytes += bytes
+        end
+
+        FileUtils.mkdir_p(dir)
+        shard_metadata = { "format" => "mlx" }.merge((metadata || {}).transform_keys(&:to_s))
+        weight_map = {}
+        shards = groups.each_with_index.map do |group, i|
+          file = format("%s-%05d-of-%05d.safetensors", prefix, i + 1, groups.length)
+          group.each { |name, _| weight_map[name] = file }
+          [File.join(dir, file), group.to_h, shard_metadata]
+        end
+        save_safetensors_shards(shards, num_threads)
+
+        index_path = File.join(dir, "#{prefix}.safetensors.index.json")
+        index = { "metadata" => { "total_size" => total_bytes }, "weight_map" => weight_map }
+        File.write(index_path, JSON.pretty_generate(index))
+        index_path
       end
 
       def export_to_dot(target, *outputs)
@@ -413,41 +499,42 @@ module MLX
 
       def compile(fun, inputs = nil, outputs = nil, shapeless = false)
         ensure_native!
-        cache = {}
+        cache = CompileCache.new(shapeless)
 
         lambda do |*args, **kwargs|
           flat_inputs = []
-          input_spec = flatten_tree_spec([args, kwargs], flat_inputs, false)
-          key = structure_cache_key(input_spec)
+          # The native TreeSpec hashes to a precomputed structure
+          # fingerprint, so it keys the cache directly.
+          input_spec = tree_flatten_spec([args, kwargs], flat_inputs, false)
 
-          entry = cache[key]
-          unless entry
+          entry = cache.fetch(input_spec, flat_inputs) do
             output_spec = nil
             lifted = lambda do |*flat_vars|
-              rebuilt, cursor = inflate_tree_from_arrays(input_spec, flat_vars, 0)
-              unless cursor == flat_vars.length
-                raise RuntimeError, "internal input reconstruction mismatch"
+              cache.trace do
+                rebuilt, cursor = tree_inflate(input_spec, flat_vars, 0)
+                unless cursor == flat_vars.length
+                  raise RuntimeError, "internal input reconstruction mismatch"
+                end
+
+                call_args = rebuilt[0]
+                call_kwargs = rebuilt[1]
+                raw_output = fun.call(*call_args, **call_kwargs)
+
+                flat_output = []
+                output_spec = tree_flatten_spec(raw_output, flat_output, false)
+                flat_output
               end
-
-              call_args = rebuilt[0]
-              call_kwargs = rebuilt[1]
-              raw_output = fun.call(*call_args, **call_kwargs)
-
-              flat_output = []
-              output_spec = flatten_tree_spec(raw_output, flat_output, false)
-              flat_output
             end
 
             compiled = native_compile(lifted, inputs, outputs, shapeless)
-            entry = { fn: compiled, output_spec: -> { output_spec } }
-            cache[key] = entry
+            { fn: compiled, output_spec: -> { output_spec } }
           end
 
           flat_output = normalize_array_sequence(entry[:fn].call(*flat_inputs), "compiled output")
           spec = entry[:output_spec].call
           raise RuntimeError, "missing output structure from compiled function" if spec.nil?
 
-          rebuilt, cursor = inflate_tree_from_arrays(spec, flat_output, 0)
+          rebuilt, cursor = tree_inflate(spec, flat_output, 0)
           unless cursor == flat_output.length
             raise RuntimeError, "internal output reconstruction mismatch"
           end
@@ -461,14 +548,13 @@ module MLX
 
         lambda do |*args, **kwargs|
           flat_inputs = []
-          input_spec = flatten_tree_spec([args, kwargs], flat_inputs, false)
-          key = structure_cache_key(input_spec)
+          input_spec = tree_flatten_spec([args, kwargs], flat_inputs, false)
 
-          entry = cache[key]
+          entry = cache[input_spec]
           unless entry
             output_spec = nil
             lifted = lambda do |*flat_vars|
-              rebuilt, cursor = inflate_tree_from_arrays(input_spec, flat_vars, 0)
+              rebuilt, cursor = tree_inflate(input_spec, flat_vars, 0)
               unless cursor == flat_vars.length
                 raise RuntimeError, "internal input reconstruction mismatch"
               end
@@ -478,20 +564,20 @@ module MLX
               raw_output = fun.call(*call_args, **call_kwargs)
 
               flat_output = []
-              output_spec = flatten_tree_spec(raw_output, flat_output, false)
+              output_spec = tree_flatten_spec(raw_output, flat_output, false)
               flat_output
             end
 
             checkpointed = native_checkpoint(lifted)
             entry = { fn: checkpointed, output_spec: -> { output_spec } }
-            cache[key] = entry
+            cache[input_spec] = entry
           end
 
           flat_output = normalize_array_sequence(entry[:fn].call(*flat_inputs), "checkpoint output")
           spec = entry[:output_spec].call
           raise RuntimeError, "missing output structure from checkpoint function" if spec.nil?
 
-          rebuilt, cursor = inflate_tree_from_arrays(spec, flat_output, 0)
+          rebuilt, cursor = tree_inflate(spec, flat_output, 0)
           unless cursor == flat_output.length
             raise RuntimeError, "internal output reconstruction mismatch"
           end
@@ -554,81 +640,42 @@ module MLX
         when MLX::Core::Array
           dlpack_value
         else
-          raise TypeError, "from_dlpack expects MLX::Core::DLPackCapsule or MLX::Core::Array"
+          if defined?(Fiddle::Pointer) && dlpack_value.is_a?(Fiddle::Pointer)
+            # Pointer to a DLManagedTensor whose ownership moves to MLX. Plain
+            # Integers are rejected; use from_dlpack_address for raw addresses.
+            from_dlpack_address(dlpack_value.to_i)
+          elsif dlpack_value.respond_to?(:consume)
+            from_dlpack_address(dlpack_value.consume)
+          elsif dlpack_value.respond_to?(:__dlpack__)
+            from_dlpack(dlpack_value.__dlpack__)
+          else
+            raise TypeError,
+                  "from_dlpack expects MLX::Core::DLPackCapsule, MLX::Core::Array, " \
+                  "a Fiddle::Pointer to a DLManagedTensor, or an object implementing __dlpack__"
+          end
         end
       end
 
       private
 
-      def infer_format(file)
-        path = file_path(file)
-        ext = File.extname(path).delete_prefix(".")
-        raise ArgumentError, "could not infer load format from file extension" if ext.empty?
+      def sharded_index_path(path)
+        return path unless File.directory?(path)
 
-        ext
-      end
+        candidates = Dir.glob(File.join(path, "*.index.json"))
+        raise ArgumentError, "expected exactly one *.index.json in #{path}, found #{candidates.length}" unless candidates.length == 1
 
-      def file_path(file)
-        if file.respond_to?(:to_path)
-          file.to_path.to_s
-        else
-          file.to_s
-        end
+        candidates.first
       end
 
-      def python_bin
-        ENV.fetch("PYTHON", "python3")
-      end
-
-      def run_python!(*argv)
-        stdout, stderr, status = Open3.capture3(*argv)
-        return if status.success?
-
-        raise RuntimeError, <<~MSG
-          python command failed: #{argv.join(" ")}
-          stdout:
-          #{stdout}
-          stderr:
-          #{stderr}
-        MSG
-      end
+      # Tensors named in `keys` (all of which must exist) plus those starting
+      # with any of the `prefix` strings, in file order.
+      def select_tensor_names(names, keys, prefix)
+        wanted = Array(keys).to_h { |key| [key.to_s, true] }
+        missing = wanted.keys - names
+        raise KeyError, "tensor not found: #{missing.first}" unless missing.empty?
 
-      def load_npz(file)
-        path = file_path(file)
-        Dir.mktmpdir("mlx-ruby-npz-load") do |dir|
-          run_python!(python_bin, "-c", PY_EXTRACT_NPZ, path, dir)
-          out = {}
-          Dir.glob(File.join(dir, "**", "*.npy")).sort.each do |npy_path|
-            rel = npy_path.delete_prefix(dir + File::SEPARATOR)
-            key = rel.end_with?(".npy") ? rel[0...-4] : rel
-            out[key] = native_load(npy_path, "npy", false)
-          end
-          out
-        end
-      end
-
-      def save_npz(file, args, kwargs, compressed)
-        path = file_path(file)
-        path = "#{path}.npz" unless path.end_with?(".npz")
-
-        arrays = kwargs.transform_keys(&:to_s)
-        args.each_with_index do |value, i|
-          key = "arr_#{i}"
-          if arrays.key?(key)
-            raise ArgumentError, "Cannot use un-named variables and keyword #{key}"
-          end
-          arrays[key] = value
-        end
-
-        Dir.mktmpdir("mlx-ruby-npz-save") do |dir|
-          arrays.each do |name, value|
-            array_value = value.is_a?(MLX::Core::Array) ? value : MLX::Core.array(value)
-            save(File.join(dir, "#{name}.npy"), array_value)
-          end
-          run_python!(python_bin, "-c", PY_BUILD_NPZ, path, dir, compressed ? "1" : "0")
-        end
-
-        nil
+        prefixes = Array(prefix).map(&:to_s)
+        names.select { |name| wanted.key?(name) || prefixes.any? { |p| name.start_with?(p) } }
       end
 
       def normalize_diff_targets(argnums, argnames)
@@ -789,7 +836,7 @@ module MLX
             raise ArgumentError,
                   "Can't compute gradient for positional argument #{index} when #{args.length} positional arguments were provided"
           end
-          spec = flatten_tree_spec(args[index], flat_inputs, true)
+          spec = tree_flatten_spec(args[index], flat_inputs, true)
           positional << { index: index, spec: spec }
         end
 
@@ -799,80 +846,13 @@ module MLX
             raise ArgumentError,
                   "Can't compute gradient for keyword argument '#{name}' because it was not provided"
           end
-          spec = flatten_tree_spec(kwargs[key], flat_inputs, true)
+          spec = tree_flatten_spec(kwargs[key], flat_inputs, true)
           keyword << { key: key, name: name, spec: spec }
         end
 
         [{ positional: positional, keyword: keyword }, flat_inputs]
       end
 
-      def flatten_tree_spec(value, arrays, strict_arrays)
-        if value.is_a?(MLX::Core::Array)
-          arrays << value
-          return ARRAY_LEAF
-        end
-        if value.is_a?(::Array)
-          return [:array, value.map { |item| flatten_tree_spec(item, arrays, strict_arrays) }]
-        end
-        if value.is_a?(::Hash)
-          return [:hash, value.map { |k, v| [k, flatten_tree_spec(v, arrays, strict_arrays)] }]
-        end
-        if strict_arrays
-          raise TypeError, "[tree_flatten] The argument should contain only arrays"
-        end
-        if value.nil? || value.is_a?(::Numeric) || value.is_a?(::String) ||
-            value.is_a?(::Symbol) || value == true || value == false
-          return [:const, value]
-        end
-        raise TypeError,
-              "[compile] Function arguments and outputs must be trees of arrays or constants (Numeric, String, Symbol, true/false, nil)"
-      end
-
-      def structure_cache_key(spec)
-        return "A" if spec == ARRAY_LEAF
-
-        tag, payload = spec
-        case tag
-        when :array
-          "L[#{payload.map { |entry| structure_cache_key(entry) }.join(",")}]"
-        when :hash
-          pairs = payload.map do |key, child|
-            "#{key.inspect}:#{structure_cache_key(child)}"
-          end
-          "H{#{pairs.join(",")}}"
-        when :const
-          "C(#{payload.class}:#{payload.inspect})"
-        else
-          raise ArgumentError, "invalid tree specification"
-        end
-      end
-
-      def inflate_tree_from_arrays(spec, arrays, cursor)
-        return [arrays.fetch(cursor), cursor + 1] if spec == ARRAY_LEAF
-
-        tag, payload = spec
-        case tag
-        when :array
-          out = []
-          payload.each do |child_spec|
-            item, cursor = inflate_tree_from_arrays(child_spec, arrays, cursor)
-            out << item
-          end
-          [out, cursor]
-        when :hash
-          out = {}
-          payload.each do |key, child_spec|
-            item, cursor = inflate_tree_from_arrays(child_spec, arrays, cursor)
-            out[key] = item
-          end
-          [out, cursor]
-        when :const
-          [payload, cursor]
-        else
-          raise ArgumentError, "invalid tree specification"
-        end
-      end
-
       def normalize_raw_grads(raw)
         normalize_array_sequence(raw, "gradient")
       end
@@ -901,12 +881,12 @@ module MLX
         cursor = 0
 
         positional_grads = selections[:positional].map do |entry|
-          value, cursor = inflate_tree_from_arrays(entry[:spec], grad_arrays, cursor)
+          value, cursor = tree_inflate(entry[:spec], grad_arrays, cursor)
           value
         end
         keyword_grads = {}
         selections[:keyword].each do |entry|
-          value, cursor = inflate_tree_from_arrays(entry[:spec], grad_arrays, cursor)
+          value, cursor = tree_inflate(entry[:spec], grad_arrays, cursor)
           keyword_grads[entry[:name]] = value
         end
         unless cursor == grad_arrays.length
@@ -934,12 +914,12 @@ module MLX
         cursor = 0
 
         selections[:positional].each do |entry|
-          value, cursor = inflate_tree_from_arrays(entry[:spec], flat_vars, cursor)
+          value, cursor = tree_inflate(entry[:spec], flat_vars, cursor)
           rebuilt_args[entry[:index]] = value
         end
 
         selections[:keyword].each do |entry|
-          value, cursor = inflate_tree_from_arrays(entry[:spec], flat_vars, cursor)
+          value, cursor = tree_inflate(entry[:spec], flat_vars, cursor)
           rebuilt_kwargs[entry[:key]] = value
         end
 
@@ -1006,26 +986,6 @@ module MLX
         size * itemsize
       end
 
-      def add(other)
-        MLX::Core.add(self, other)
-      end
-
-      def subtract(other)
-        MLX::Core.subtract(self, other)
-      end
-
-      def multiply(other)
-        MLX::Core.multiply(self, other)
-      end
-
-      def divide(other)
-        MLX::Core.divide(self, other)
-      end
-
-      def exp
-        MLX::Core.exp(self)
-      end
-
       def sin
         MLX::Core.sin(self)
       end
@@ -1034,14 +994,6 @@ module MLX
         MLX::Core.cos(self)
       end
 
-      def mean(axis = nil)
-        MLX::Core.mean(self, axis)
-      end
-
-      def sum(axis = nil)
-        MLX::Core.sum(self, axis)
-      end
-
       def var(axis = nil, keepdims = nil, ddof = nil)
         MLX::Core.var(self, axis, keepdims, ddof)
       end
@@ -1050,47 +1002,14 @@ module MLX
         MLX::Core.std(self, axis, keepdims, ddof)
       end
 
-      def max(axis = nil, keepdims = nil)
-        MLX::Core.max(self, axis, keepdims)
-      end
-
-      def min(axis = nil, keepdims = nil)
-        MLX::Core.min(self, axis, keepdims)
-      end
-
-      def reshape(*shape)
-        target = shape.length == 1 ? shape[0] : shape
-        MLX::Core.reshape(self, target)
-      end
-
-      def transpose(axes = nil)
-        MLX::Core.transpose(self, axes)
-      end
-
       def squeeze(axis = nil)
         MLX::Core.squeeze(self, axis)
       end
 
-      def square
-        MLX::Core.square(self)
-      end
-
-      def sqrt
-        MLX::Core.sqrt(self)
-      end
-
-      def rsqrt
-        MLX::Core.rsqrt(self)
-      end
-
       def reciprocal
         MLX::Core.reciprocal(self)
       end
 
-      def abs
-        MLX::Core.abs(self)
-      end
-
       def all(axis = nil, keepdims = nil)
         MLX::Core.all(self, axis, keepdims)
       end
@@ -1107,14 +1026,6 @@ module MLX
         MLX::Core.argmin(self, axis, keepdims)
       end
 
-      def astype(dtype, stream = nil)
-        if stream.nil?
-          MLX::Core.astype(self, dtype)
-        else
-          MLX::Core.astype(self, dtype, stream)
-        end
-      end
-
       def conj
         MLX::Core.conj(self)
       end
@@ -1143,14 +1054,6 @@ module MLX
         MLX::Core.diagonal(self, *args)
       end
 
-      def flatten(start_axis = 0, end_axis = -1)
-        MLX::Core.flatten(self, start_axis, end_axis)
-      end
-
-      def log
-        MLX::Core.log(self)
-      end
-
       def log10
         MLX::Core.log10(self)
       end
@@ -1216,34 +1119,6 @@ module MLX
         to_a
       end
 
-      def __add__(other)
-        add(other)
-      end
-
-      def __sub__(other)
-        subtract(other)
-      end
-
-      def __mul__(other)
-        multiply(other)
-      end
-
-      def __truediv__(other)
-        divide(other)
-      end
-
-      def __div__(other)
-        __truediv__(other)
-      end
-
-      def __matmul__(other)
-        MLX::Core.matmul(self, other)
-      end
-
-      def __imatmul__(other)
-        __matmul__(other)
-      end
-
       def __len__
         shape.first || 0
       end
@@ -1299,14 +1174,6 @@ module MLX
         MLX::Core.not_equal(self, other)
       end
 
-      def __abs__
-        MLX::Core.abs(self)
-      end
-
-      def __neg__
-        MLX::Core.negative(self)
-      end
-
       def __pow__(other)
         MLX::Core.power(self, other)
       end
@@ -1443,16 +1310,6 @@ module MLX
         self[index]
       end
 
-      def __setitem__(index, value)
-        fast_path = __setitem_1d_device_fast_path(index, value)
-        return fast_path unless fast_path.nil?
-
-        copy = __ruby_deep_copy(to_a)
-        replacement = value.is_a?(MLX::Core::Array) ? value.to_a : value
-        __apply_setitem!(copy, index, replacement)
-        MLX::Core.array(copy, dtype)
-      end
-
       def __copy__
         MLX::Core.array(to_a, dtype)
       end
@@ -1513,173 +1370,6 @@ module MLX
       end
 
       alias __dlpack_device__ __dlpack_device
-
-      private
-
-      def __setitem_1d_device_fast_path(index, replacement)
-        return nil unless ndim == 1
-
-        if index.is_a?(::Integer)
-          normalized = __normalize_1d_index(index)
-          index_array = MLX::Core.array([normalized], MLX::Core.int32)
-          values_array = __coerce_setitem_values_1d(replacement, 1)
-          return MLX::Core.put_along_axis(self, index_array, values_array, 0)
-        end
-
-        if index.is_a?(MLX::Core::Array) && index.ndim == 1
-          case __dtype_name(index.dtype)
-          when "bool_"
-            return nil unless index.shape[0] == shape[0]
-
-            replacement_array = __coerce_setitem_mask_values_1d(replacement, shape[0])
-            return MLX::Core.where(index, replacement_array, self)
-          when "uint8", "uint16", "uint32", "uint64", "int8", "int16", "int32", "int64"
-            index_array = index.astype(MLX::Core.int32)
-            values_array = __coerce_setitem_values_1d(replacement, index_array.size)
-            return MLX::Core.put_along_axis(self, index_array, values_array, 0)
-          end
-        end
-
-        return nil unless index.is_a?(::Array) && index.all? { |entry| entry.is_a?(::Integer) }
-
-        normalized = index.map { |entry| __normalize_1d_index(entry) }
-        index_array = MLX::Core.array(normalized, MLX::Core.int32)
-        values_array = __coerce_setitem_values_1d(replacement, normalized.length)
-        MLX::Core.put_along_axis(self, index_array, values_array, 0)
-      rescue StandardError
-        nil
-      end
-
-      def __normalize_1d_index(index)
-        size_1d = shape[0]
-        normalized = index
-        normalized += size_1d if normalized.negative?
-        if normalized.negative? || normalized >= size_1d
-          raise IndexError, "index out of range"
-        end
-
-        normalized
-      end
-
-      def __coerce_setitem_values_1d(values, count)
-        case values
-        when MLX::Core::Array
-          return MLX::Core.full([count], values, dtype) if values.size == 1 && count > 1
-          raise ArgumentError, "__setitem__ replacement values must match index list length" if values.size != count
-
-          MLX::Core.reshape(values.astype(dtype), [count])
-        when ::Array
-          value_array = MLX::Core.array(values, dtype)
-          return MLX::Core.full([count], value_array, dtype) if value_array.size == 1 && count > 1
-          raise ArgumentError, "__setitem__ replacement values must match index list length" if value_array.size != count
-
-          MLX::Core.reshape(value_array, [count])
-        else
-          MLX::Core.full([count], values, dtype)
-        end
-      end
-
-      def __coerce_setitem_mask_values_1d(values, count)
-        case values
-        when MLX::Core::Array
-          return MLX::Core.full([count], values, dtype) if values.size == 1
-          raise ArgumentError, "__setitem__ replacement values must match mask length" if values.size != count
-
-          MLX::Core.reshape(values.astype(dtype), [count])
-        when ::Array
-          value_array = MLX::Core.array(values, dtype)
-          return MLX::Core.full([count], value_array, dtype) if value_array.size == 1
-          raise ArgumentError, "__setitem__ replacement values must match mask length" if value_array.size != count
-
-          MLX::Core.reshape(value_array, [count])
-        else
-          MLX::Core.full([count], values, dtype)
-        end
-      end
-
-      def __dtype_name(dtype_obj)
-        if dtype_obj.respond_to?(:name)
-          dtype_obj.name.to_s
-        else
-          dtype_obj.to_s
-        end
-      end
-
-      def __apply_setitem!(data, index, replacement)
-        if index.is_a?(::Integer)
-          data[index] = replacement
-          return
-        end
-
-        normalized = if index.is_a?(MLX::Core::Array)
-          index.to_a
-        elsif index.is_a?(::Array)
-          index
-        else
-          raise ArgumentError, "__setitem__ supports Integer, Integer list, or boolean mask indices"
-        end
-
-        unless data.is_a?(::Array)
-          raise ArgumentError, "__setitem__ list/mask indices require array values"
-        end
-
-        if normalized.all? { |v| v == true || v == false }
-          __apply_boolean_mask_setitem!(data, normalized, replacement)
-          return
-        end
-
-        unless normalized.all? { |v| v.is_a?(::Integer) }
-          raise ArgumentError, "__setitem__ list indices must be all Integers or all booleans"
-        end
-
-        __apply_integer_list_setitem!(data, normalized, replacement)
-      end
-
-      def __apply_boolean_mask_setitem!(data, mask, replacement)
-        if mask.length != data.length
-          raise ArgumentError, "__setitem__ boolean mask must match array length"
-        end
-
-        replacement_values = replacement.is_a?(::Array) ? replacement.flatten : nil
-        replacement_index = 0
-
-        mask.each_with_index do |flag, i|
-          next unless flag
-
-          if replacement_values
-            if replacement_index >= replacement_values.length
-              raise ArgumentError, "__setitem__ replacement values shorter than mask true count"
-            end
-            data[i] = replacement_values[replacement_index]
-            replacement_index += 1
-          else
-            data[i] = replacement
-          end
-        end
-      end
-
-      def __apply_integer_list_setitem!(data, indices, replacement)
-        if replacement.is_a?(::Array)
-          values = replacement.flatten
-          if values.length == 1
-            indices.each { |i| data[i] = values[0] }
-            return
-          end
-          if values.length != indices.length
-            raise ArgumentError, "__setitem__ replacement values must match index list length"
-          end
-
-          indices.each_with_index { |i, offset| data[i] = values[offset] }
-        else
-          indices.each { |i| data[i] = replacement }
-        end
-      end
-
-      def __ruby_deep_copy(value)
-        return value.map { |item| __ruby_deep_copy(item) } if value.is_a?(::Array)
-
-        value
-      end
     end
   end
 end
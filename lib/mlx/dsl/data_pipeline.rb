@@ -63,9 +63,18 @@ module MLX
           enum.each { |item| yield item }
         end
 
-        def map(&block)
+        # With num_workers: N the block runs on a pool of N threads, which
+        # pays off for transforms that spend their time in GVL-releasing
+        # native code such as file reads or zlib inflation. ordered: false
+        # yields results as soon as they finish instead of holding them in
+        # the reorder buffer.
+        def map(num_workers: 0, ordered: true, &block)
           raise ArgumentError, "pipeline map requires a block" unless block_given?
 
+          workers = num_workers.to_i
+          raise ArgumentError, "pipeline map num_workers must be non-negative" if workers.negative?
+          return self.class.new(lambda { __dsl_parallel_map(block, workers, ordered) }) if workers.positive?
+
           self.class.new(lambda {
             upstream = @factory.call
             Enumerator.new do |y|
@@ -113,6 +122,97 @@ module MLX
           })
         end
 
+        # Routes each item to the bucket whose [previous boundary, boundary)
+        # range holds its length and yields a bucket as soon as it holds its
+        # batch size, so batches contain samples of similar length. There is
+        # one more bucket than boundaries; at most sum(batch_sizes) items are
+        # buffered. `length` is a callable, a Hash key, or nil to measure the
+        # item itself.
+        def bucket_by_length(boundaries:, batch_sizes:, length: nil, drop_last: false)
+          limits = Array(boundaries).map(&:to_i)
+          sizes = Array(batch_sizes).map(&:to_i)
+          unless limits.each_cons(2).all? { |lower, upper| lower < upper }
+            raise ArgumentError, "pipeline bucket_by_length boundaries must be strictly increasing"
+          end
+          if sizes.length != limits.length + 1
+            raise ArgumentError, "pipeline bucket_by_length needs #{limits.length + 1} batch_sizes for #{limits.length} boundaries"
+          end
+          raise ArgumentError, "pipeline bucket_by_length batch_sizes must be positive" unless sizes.all?(&:positive?)
+
+          self.class.new(lambda {
+            upstream = @factory.call
+            Enumerator.new do |y|
+              buckets = Array.new(sizes.length) { [] }
+              upstream.each do |item|
+                measured = __dsl_item_length(item, length, "pipeline bucket_by_length")
+                bucket = limits.bsearch_index { |limit| limit > measured } || limits.length
+                buckets[bucket] << item
+                next if buckets[bucket].length < sizes[bucket]
+
+                y << buckets[bucket]
+                buckets[bucket] = []
+              end
+              buckets.each { |chunk| y << chunk unless drop_last || chunk.empty? }
+            end
+          })
+        end
+
+        # Packs items into batches whose padded size (item count times the
+        # longest length) stays within max_tokens. With buffer_size: N, up to
+        # N items are read ahead and packed in length order, which groups
+        # similar lengths; without it items are packed in arrival order.
+        def batch_by_tokens(max_tokens:, length: nil, buffer_size: nil)
+          budget = max_tokens.to_i
+          raise ArgumentError, "pipeline batch_by_tokens max_tokens must be positive" if budget <= 0
+          unless buffer_size.nil?
+            lookahead = buffer_size.to_i
+            raise ArgumentError, "pipeline batch_by_tokens buffer_size must be positive" if lookahead <= 0
+          end
+
+          self.class.new(lambda {
+            upstream = @factory.call
+            Enumerator.new do |y|
+              pending = []
+              pack = lambda do |flush|
+                pending.sort_by!.with_index { |(measured, _item), order| [measured, order] } unless lookahead.nil?
+                batches = __dsl_pack_by_tokens(pending, budget)
+                # Keep the last, possibly under-filled batch for the next
+                # window unless the source is exhausted.
+                pending = flush ? [] : batches.pop
+                batches.each { |chunk| y << chunk.map(&:last) }
+              end
+
+              upstream.each do |item|
+                measured = __dsl_item_length(item, length, "pipeline batch_by_tokens")
+                if measured > budget
+                  raise ArgumentError, "pipeline batch_by_tokens item length #{measured} exceeds max_tokens #{budget}"
+                end
+
+                pending << [measured, item]
+                if lookahead.nil?
+                  pack.call(false) if pending.length * pending.map(&:first).max > budget
+                elsif pending.length >= lookahead
+                  pack.call(false)
+                end
+              end
+              pack.call(true)
+            end
+          })
+        end
+
+        # Turns each batch (an Array of samples, e.g. from #batch) into MLX
+        # arrays with MLX::Core.collate.
+        def collate(pad_value: 0, pad_to_multiple_of: nil)
+          self.class.new(lambda {
+            upstream = @factory.call
+            Enumerator.new do |y|
+              upstream.each do |samples|
+                y << MLX::Core.collate(samples, pad_value: pad_value, pad_to_multiple_of: pad_to_multiple_of)
+              end
+            end
+          })
+        end
+
         def take(count)
           limit = count.to_i
           raise ArgumentError, "pipeline take count must be non-negative" if limit.negative?
@@ -120,14 +220,16 @@ module MLX
           self.class.new(lambda {
             upstream = @factory.call
             Enumerator.new do |y|
+              next if limit.zero?
+
+              # Internal iteration so the break unwinds upstream stages
+              # (e.g. stops a prefetch producer) instead of leaving them
+              # suspended in an external enumerator.
               seen = 0
-              while seen < limit
-                begin
-                  y << upstream.next
-                  seen += 1
-                rescue StopIteration
-                  break
-                end
+              upstream.each do |item|
+                y << item
+                seen += 1
+                break if seen >= limit
               end
             end
           })
@@ -164,13 +266,20 @@ module MLX
           end
         end
 
-        def shuffle(seed: nil, random: nil)
+        # Without buffer_size the whole epoch is materialized and shuffled.
+        # With buffer_size: N items stream through an N-slot buffer and each
+        # output is drawn uniformly from it, so memory stays bounded and the
+        # first item is available after N reads.
+        def shuffle(seed: nil, random: nil, buffer_size: nil)
           if !seed.nil? && !random.nil?
             raise ArgumentError, "pipeline shuffle accepts either seed: or random:, not both"
           end
+          unless buffer_size.nil?
+            capacity = buffer_size.to_i
+            raise ArgumentError, "pipeline shuffle buffer_size must be positive" if capacity <= 0
+          end
 
           self.class.new(lambda {
-            items = @factory.call.to_a
             rng = if !random.nil?
               random
             elsif !seed.nil?
@@ -178,34 +287,90 @@ module MLX
             else
               Random.new
             end
-            items.shuffle(random: rng).to_enum
+            next @factory.call.to_a.shuffle(random: rng).to_enum if capacity.nil?
+
+            upstream = @factory.call
+            Enumerator.new do |y|
+              buffer = []
+              upstream.each do |item|
+                if buffer.length < capacity
+                  buffer << item
+                  next
+                end
+
+                slot = rng.rand(capacity)
+                y << buffer[slot]
+                buffer[slot] = item
+              end
+              buffer.shuffle!(random: rng)
+              buffer.each { |item| y << item }
+            end
           })
         end
 
-        def prefetch(size = 1)
-          prefetch_size = size.to_i
-          raise ArgumentError, "pipeline prefetch size must be positive" if prefetch_size <= 0
+        # Expands each item into the elements of the enumerable returned by
+        # the block, e.g. a list of shard paths into the records they hold.
+        def flat_map(&block)
+          raise ArgumentError, "pipeline flat_map requires a block" unless block_given?
 
           self.class.new(lambda {
             upstream = @factory.call
             Enumerator.new do |y|
-              buffer = []
-
-              prefetch_size.times do
-                begin
-                  buffer << upstream.next
-                rescue StopIteration
-                  break
+              index = 0
+              upstream.each do |item|
+                expanded = __dsl_call_with_context(block, item, index, "pipeline flat_map")
+                unless expanded.respond_to?(:each)
+                  raise ArgumentError, "pipeline flat_map block must return an object that responds to #each"
                 end
+
+                expanded.each { |value| y << value }
+                index += 1
               end
+            end
+          })
+        end
+
+        # Runs the upstream stages on a producer thread that stays up to
+        # `size` items ahead of the consumer, so decoding and collation
+        # overlap with the training step. Upstream exceptions are re-raised
+        # in the consumer. Stopping early (break, take, first) closes the
+        # queue and joins the producer. With async_eval: true the consumer
+        # schedules the MLX arrays of the next item with
+        # MLX::Core.async_eval before yielding the current one; evaluation
+        # stays on the consumer thread because MLX does not support
+        # concurrent evaluation from several threads.
+        def prefetch(size = 1, async_eval: false)
+          prefetch_size = size.to_i
+          raise ArgumentError, "pipeline prefetch size must be positive" if prefetch_size <= 0
+
+          self.class.new(lambda {
+            Enumerator.new do |y|
+              queue = SizedQueue.new(prefetch_size)
+              producer = __dsl_start_prefetch_producer(queue)
+              held = []
+              begin
+                while (entry = queue.pop)
+                  kind, value = entry
+                  break if kind == :done
 
-              until buffer.empty?
-                y << buffer.shift
-                begin
-                  buffer << upstream.next
-                rescue StopIteration
-                  # Exhausted upstream; continue draining buffer.
+                  if kind == :error
+                    held.each { |item| y << item }
+                    raise value
+                  end
+                  unless async_eval
+                    y << value
+                    next
+                  end
+
+                  MLX::Core.async_eval(value)
+                  y << held.shift unless held.empty?
+                  held << value
                 end
+                held.each { |item| y << item }
+              ensure
+                queue.close
+                queue.clear
+                producer.join
               end
             end
           })
@@ -213,6 +378,125 @@ module MLX
 
         private
 
+        def __dsl_item_length(item, length, label)
+          value = case length
+          when nil then item
+          when Symbol, String then item.fetch(length)
+          else
+            raise ArgumentError, "#{label} length must be a callable, a Hash key, or nil" unless length.respond_to?(:call)
+
+            return Integer(length.call(item))
+          end
+          return value.shape.first.to_i if value.respond_to?(:shape)
+          return value.length if value.respond_to?(:length)
+
+          raise ArgumentError, "#{label} cannot measure the length of #{value.class}; pass length:"
+        end
+
+        # Greedily splits [length, item] pairs into consecutive groups whose
+        # count times maximum length fits the budget.
+        def __dsl_pack_by_tokens(pairs, budget)
+          batches = []
+          current = []
+          longest = 0
+          pairs.each do |pair|
+            widest = [longest, pair.first].max
+            if !current.empty? && (current.length + 1) * widest > budget
+              batches << current
+              current = []
+              widest = pair.first
+            end
+            current << pair
+            longest = widest
+          end
+          batches << current unless current.empty?
+          batches
+        end
+
+        def __dsl_start_prefetch_producer(queue)
+          factory = @factory
+          Thread.new do
+            Thread.current.name = "mlx-dsl-prefetch"
+            Thread.current.report_on_exception = false
+            begin
+              factory.call.each do |item|
+                queue.push([:item, item])
+              end
+              queue.push([:done, nil])
+            rescue ClosedQueueError
+              # Consumer stopped early; nothing left to deliver.
+            rescue Exception => e
+              begin
+                queue.push([:error, e])
+              rescue ClosedQueueError
+                nil
+              end
+            end
+          end
+        end
+
+        def __dsl_parallel_map(block, workers, ordered)
+          upstream = @factory.call
+          Enumerator.new do |y|
+            # Upstream is read on the consumer thread; at most `window` items
+            # are in flight (or waiting in the reorder buffer) at once.
+            window = workers * 2
+            jobs = Queue.new
+            results = Queue.new
+            pool = Array.new(workers) { __dsl_start_map_worker(block, jobs, results) }
+            pending = {}
+            submitted = 0
+            emitted = 0
+            completed = 0
+
+            drain_one = lambda do
+              kind, index, value = results.pop
+              raise value if kind == :error
+
+              completed += 1
+              if ordered
+                pending[index] = value
+                while pending.key?(emitted)
+                  y << pending.delete(emitted)
+                  emitted += 1
+                end
+              else
+                y << value
+                emitted += 1
+              end
+            end
+
+            begin
+              upstream.each do |item|
+                jobs << [submitted, item]
+                submitted += 1
+                drain_one.call while (ordered ? submitted - emitted : submitted - completed) >= window
+              end
+              drain_one.call while emitted < submitted
+            ensure
+              jobs.close
+              jobs.clear
+              pool.each(&:join)
+            end
+          end
+        end
+
+        def __dsl_start_map_worker(block, jobs, results)
+          Thread.new do
+            Thread.current.name = "mlx-dsl-map"
+            Thread.current.report_on_exception = false
+            while (job = jobs.pop)
+              index, item = job
+              begin
+                results << [:item, index, __dsl_call_with_context(block, item, index, "pipeline map")]
+              rescue Exception => e
+                results << [:error, index, e]
+                break
+              end
+            end
+          end
+        end
+
         def __dsl_call_with_context(callable, item, index, label)
           values = {
             item: item,
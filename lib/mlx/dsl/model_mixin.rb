@@ -178,10 +178,10 @@ module MLX
           __dsl_ensure_parent_dir!(path)
           payload = {
             "format" => "mlx_dsl_checkpoint_v1",
-            "model" => __dsl_serialize_tree(parameters),
+            "model" => __dsl_serialize_tree(parameters, binary: true),
             "metadata" => metadata || {}
           }
-          payload["optimizer"] = __dsl_serialize_tree(optimizer.state) unless optimizer.nil?
+          payload["optimizer"] = __dsl_serialize_tree(optimizer.state, binary: true) unless optimizer.nil?
 
           File.binwrite(path, Marshal.dump(payload))
           return path
@@ -642,16 +642,21 @@ module MLX
         self
       end
 
-      def __dsl_serialize_tree(value)
+      # With binary: true arrays are kept as-is and Marshal stores them through
+      # MLX::Core::Array#_dump (raw bytes); otherwise they become JSON-safe
+      # value lists.
+      def __dsl_serialize_tree(value, binary: false)
         if value.is_a?(MLX::Core::Array)
+          return value if binary
+
           return { "__mlx_array__" => value.__getstate__ }
         end
         if value.is_a?(Array)
-          return value.map { |entry| __dsl_serialize_tree(entry) }
+          return value.map { |entry| __dsl_serialize_tree(entry, binary: binary) }
         end
         if value.is_a?(Hash)
           return value.each_with_object({}) do |(key, entry), out|
-            out[key.to_s] = __dsl_serialize_tree(entry)
+            out[key.to_s] = __dsl_serialize_tree(entry, binary: binary)
           end
         end
 
@@ -17,6 +17,13 @@ module MLX
 
       def load_weights(file_or_weights, strict: true)
         weights = file_or_weights
+        if weights.is_a?(String) && (weights.end_with?(".index.json") || File.directory?(weights))
+          expected = strict ? MLX::Utils.tree_flatten(parameters, destination: {}) : nil
+          loaded = MLX::Core.load_sharded(weights, expected: expected)
+          update(MLX::Utils.tree_unflatten(loaded.to_a), strict: false) unless loaded.empty?
+          return self
+        end
+
         if weights.is_a?(String)
           loaded = MLX::Core.load(weights)
           weights = loaded.to_a
@@ -54,10 +61,12 @@ module MLX
         self
       end
 
-      def save_weights(file)
+      def save_weights(file, max_shard_size: nil)
         params_dict = MLX::Utils.tree_flatten(parameters, destination: {})
 
-        if file.end_with?(".npz")
+        if max_shard_size
+          MLX::Core.save_sharded(file, params_dict, max_shard_size: max_shard_size)
+        elsif file.end_with?(".npz")
           kwargs = params_dict.each_with_object({}) do |(k, v), out|
             out[k.to_sym] = v
           end
@@ -5,6 +5,8 @@ module MLX
     module_function
 
     def tree_map(fn, tree, *rest, is_leaf: nil)
+      return Utils.native_tree_map(fn, tree, rest, is_leaf) if Utils.respond_to?(:native_tree_map)
+
       if !is_leaf.nil? && is_leaf.call(tree)
         return fn.call(tree, *rest)
       end
@@ -57,6 +59,9 @@ module MLX
       unless destination.is_a?(Array) || destination.is_a?(Hash)
         raise ArgumentError, "destination must be an Array, Hash, or nil"
       end
+      if Utils.respond_to?(:native_tree_flatten)
+        return Utils.native_tree_flatten(tree, prefix, is_leaf, destination)
+      end
 
       add = if destination.is_a?(Array)
         ->(k, v) { destination << [k, v] }
@@ -90,6 +95,8 @@ module MLX
     end
 
     def tree_unflatten(tree)
+      return Utils.native_tree_unflatten(tree) if Utils.respond_to?(:native_tree_unflatten)
+
       items = if tree.is_a?(Hash)
         tree.to_a
       elsif tree.is_a?(Array)
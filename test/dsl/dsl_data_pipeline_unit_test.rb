@@ -60,6 +60,154 @@ class DslDataPipelineUnitTest < Minitest::Test
     assert_equal (1..8).to_a.sort, left.sort
   end
 
+  def test_pipeline_collate_builds_padded_batches
+    records = [{ids: [1, 2, 3], y: 0}, {ids: [4], y: 1}, {ids: [5, 6], y: 1}]
+    batches = MLX::DSL::Data.from(records).batch(2).collate(pad_value: 0).to_a
+
+    assert_equal 2, batches.length
+    assert_equal [[1, 2, 3], [4, 0, 0]], batches[0][:ids].tolist
+    assert_equal MLX::Core.int32, batches[0][:ids].dtype
+    assert_equal [3, 1], batches[0][:ids_lengths].tolist
+    assert_equal [[5, 6]], batches[1][:ids].tolist
+    assert_equal [2], batches[1][:ids_lengths].tolist
+    assert_equal [1], batches[1][:y].tolist
+  end
+
+  def test_pipeline_bucket_by_length_groups_similar_lengths
+    words = %w[a bb ccccc d eeeeee ff ggggggg h]
+    batches = MLX::DSL::Data.from(words).bucket_by_length(boundaries: [3, 6], batch_sizes: [3, 2, 1]).to_a
+
+    assert_equal [%w[a bb d], %w[eeeeee], %w[ggggggg], %w[ff h], %w[ccccc]], batches
+    assert_equal [%w[a bb d], %w[eeeeee ggggggg]],
+                 MLX::DSL::Data.from(words).bucket_by_length(boundaries: [3, 6], batch_sizes: [3, 2, 2], drop_last: true).to_a
+  end
+
+  def test_pipeline_bucket_by_length_accepts_length_key_and_validates
+    records = [{ids: [1, 2]}, {ids: [3]}, {ids: [4, 5, 6, 7]}]
+    batches = MLX::DSL::Data.from(records).bucket_by_length(boundaries: [3], batch_sizes: [2, 2], length: :ids).to_a
+    assert_equal [[records[0], records[1]], [records[2]]], batches
+
+    assert_raises(ArgumentError) { MLX::DSL::Data.from([]).bucket_by_length(boundaries: [3, 2], batch_sizes: [1, 1, 1]) }
+    error = assert_raises(ArgumentError) { MLX::DSL::Data.from([]).bucket_by_length(boundaries: [3], batch_sizes: [1]) }
+    assert_match(/batch_sizes/, error.message)
+  end
+
+  def test_pipeline_batch_by_tokens_caps_padded_size
+    lengths = [2, 3, 8, 1, 4, 4, 2, 7, 1]
+    batches = MLX::DSL::Data.from(lengths).batch_by_tokens(max_tokens: 8, length: ->(x) { x }).to_a
+
+    assert_equal [[2, 3], [8], [1, 4], [4, 2], [7], [1]], batches
+    assert(batches.all? { |batch| batch.length * batch.max <= 8 })
+  end
+
+  def test_pipeline_batch_by_tokens_lookahead_sorts_within_buffer
+    lengths = [1, 6, 1, 6, 1, 6, 1, 6]
+    arrival = MLX::DSL::Data.from(lengths).batch_by_tokens(max_tokens: 12, length: ->(x) { x }).to_a
+    sorted = MLX::DSL::Data.from(lengths).batch_by_tokens(max_tokens: 12, length: ->(x) { x }, buffer_size: 8).to_a
+
+    assert_equal [[1, 6]] * 4, arrival
+    assert_equal [[1, 1, 1, 1], [6, 6], [6, 6]], sorted
+
+    error = assert_raises(ArgumentError) do
+      MLX::DSL::Data.from([[1] * 20]).batch_by_tokens(max_tokens: 8).to_a
+    end
+    assert_match(/exceeds max_tokens/, error.message)
+  end
+
+  def test_pipeline_buffered_shuffle_is_seeded_and_streams
+    pulled = []
+    source = MLX::DSL::Data.pipeline do
+      Enumerator.new do |y|
+        (1..100).each do |x|
+          pulled << x
+          y << x
+        end
+      end
+    end
+    left = source.shuffle(buffer_size: 8, seed: 3)
+
+    first = left.first
+    assert_operator pulled.length, :<=, 9
+    assert_includes (1..9).to_a, first
+
+    pulled.clear
+    epoch = left.to_a
+    assert_equal epoch, left.to_a
+    assert_equal (1..100).to_a, epoch.sort
+    refute_equal (1..100).to_a, epoch
+    refute_equal epoch, source.shuffle(buffer_size: 8, seed: 4).to_a
+  end
+
+  def test_pipeline_buffered_shuffle_handles_short_sources_and_validates_size
+    assert_equal [1, 2, 3], MLX::DSL::Data.from([3, 1, 2]).shuffle(buffer_size: 16, seed: 1).to_a.sort
+    error = assert_raises(ArgumentError) do
+      MLX::DSL::Data.from([1]).shuffle(buffer_size: 0)
+    end
+    assert_match(/buffer_size/, error.message)
+  end
+
+  def test_pipeline_shard_then_buffer_shuffle
+    shards = {a: [1, 2, 3], b: [4, 5, 6], c: [7, 8, 9]}
+    pipeline = MLX::DSL::Data
+      .from(shards.keys)
+      .shuffle(seed: 5)
+      .flat_map { |name| shards.fetch(name) }
+      .shuffle(buffer_size: 2, seed: 5)
+
+    assert_equal pipeline.to_a, pipeline.to_a
+    assert_equal (1..9).to_a, pipeline.to_a.sort
+  end
+
+  def test_pipeline_parallel_map_preserves_order_by_default
+    pipeline = MLX::DSL::Data.from((0...12).to_a).map(num_workers: 4) do |x, index|
+      sleep(0.001 * ((12 - x) % 4))
+      [x * x, index]
+    end
+
+    assert_equal((0...12).map { |x| [x * x, x] }, pipeline.to_a)
+  end
+
+  def test_pipeline_parallel_map_unordered_yields_every_result
+    pipeline = MLX::DSL::Data.from((0...12).to_a).map(num_workers: 3, ordered: false) do |x|
+      sleep(0.001 * (x % 3))
+      x + 100
+    end
+
+    assert_equal((100...112).to_a, pipeline.to_a.sort)
+  end
+
+  def test_pipeline_parallel_map_runs_items_concurrently
+    started = Queue.new
+    pipeline = MLX::DSL::Data.from([0, 1]).map(num_workers: 2) do |x|
+      started << x
+      deadline = Process.clock_gettime(Process::CLOCK_MONOTONIC) + 2.0
+      sleep(0.005) while started.size < 2 && Process.clock_gettime(Process::CLOCK_MONOTONIC) < deadline
+      started.size
+    end
+
+    assert_equal [2, 2], pipeline.to_a
+  end
+
+  def test_pipeline_parallel_map_propagates_errors_and_stops_workers
+    pipeline = MLX::DSL::Data.from((1..20).to_a).map(num_workers: 2) do |x|
+      raise KeyError, "bad record #{x}" if x == 5
+
+      x
+    end
+
+    error = assert_raises(KeyError) { pipeline.to_a }
+    assert_match(/bad record 5/, error.message)
+    assert_equal [1, 2, 3], MLX::DSL::Data.from((1..20).to_a).repeat.map(num_workers: 2) { |x| x }.take(3).to_a
+    assert_empty(Thread.list.select { |t| t.name == "mlx-dsl-map" && t.alive? })
+  end
+
+  def test_pipeline_map_validates_num_workers
+    error = assert_raises(ArgumentError) do
+      MLX::DSL::Data.from([1]).map(num_workers: -1) { |x| x }
+    end
+    assert_match(/num_workers/, error.message)
+  end
+
   def test_pipeline_prefetch_preserves_item_order
     pipeline = MLX::DSL::Data.from([1, 2, 3, 4]).prefetch(2).map { |x| x * 10 }
     assert_equal [10, 20, 30, 40], pipeline.to_a
@@ -71,6 +219,77 @@ class DslDataPipelineUnitTest < Minitest::Test
     end
     assert_match(/prefetch/i, error.message)
   end
+
+  def test_pipeline_prefetch_produces_on_background_thread_ahead_of_consumer
+    produced = Queue.new
+    producer_threads = []
+    pipeline = MLX::DSL::Data.from((1..6).to_a).map do |x|
+      producer_threads << Thread.current
+      produced << x
+      x
+    end.prefetch(3)
+
+    ran_ahead = false
+    pipeline.each do |x|
+      next unless x == 1
+
+      deadline = Process.clock_gettime(Process::CLOCK_MONOTONIC) + 2.0
+      sleep(0.005) while produced.size < 3 && Process.clock_gettime(Process::CLOCK_MONOTONIC) < deadline
+      ran_ahead = produced.size >= 3
+    end
+
+    assert ran_ahead, "producer should run ahead while the consumer is busy"
+    refute_includes producer_threads, Thread.current
+  end
+
+  def test_pipeline_prefetch_propagates_upstream_errors
+    pipeline = MLX::DSL::Data.from([1, 2, 3]).map do |x|
+      raise KeyError, "bad record #{x}" if x == 3
+
+      x
+    end.prefetch(2)
+
+    seen = []
+    error = assert_raises(KeyError) do
+      pipeline.each { |x| seen << x }
+    end
+    assert_equal [1, 2], seen
+    assert_match(/bad record 3/, error.message)
+  end
+
+  def test_pipeline_prefetch_stops_producer_when_consumer_stops_early
+    pipeline = MLX::DSL::Data.from([1, 2, 3]).repeat.prefetch(2)
+
+    assert_equal [1, 2, 3, 1, 2], pipeline.take(5).to_a
+    assert_equal 1, pipeline.first
+    assert_empty(Thread.list.select { |t| t.name == "mlx-dsl-prefetch" && t.alive? })
+  end
+
+  def test_pipeline_prefetch_async_evaluates_items_when_requested
+    scheduled = []
+    threads = []
+    core = MLX::Core.singleton_class
+    core.alias_method(:__test_async_eval, :async_eval)
+    core.define_method(:async_eval) do |*trees|
+      threads << Thread.current
+      scheduled.concat(trees)
+    end
+    begin
+      items = [{x: 1}, {x: 2}]
+      seen = []
+      MLX::DSL::Data.from(items).prefetch(1, async_eval: true).each do |item|
+        seen << [item, scheduled.dup]
+      end
+      assert_equal [[items[0], items], [items[1], items]], seen
+      assert_equal [Thread.current], threads.uniq
+      scheduled.clear
+      MLX::DSL::Data.from(items).prefetch(1).to_a
+      assert_empty scheduled
+    ensure
+      core.alias_method(:async_eval, :__test_async_eval)
+      core.remove_method(:__test_async_eval)
+    end
+  end
 end
 
 $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
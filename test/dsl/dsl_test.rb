@@ -426,6 +426,22 @@ class DslTest < Minitest::Test
     end
   end
 
+  def test_marshal_checkpoint_stores_arrays_as_binary
+    model = DslAffine.new(in_dim: 4, out_dim: 3)
+
+    Tempfile.create(["mlx-dsl-checkpoint", ".bin"], TestSupport.test_tmp_dir) do |f|
+      model.weight.define_singleton_method(:to_a) { raise "marshal checkpoint should not call to_a" }
+      model.save_checkpoint(f.path)
+
+      payload = Marshal.load(File.binread(f.path))
+      assert_instance_of MLX::Core::Array, payload.fetch("model").fetch("weight")
+
+      restored = DslAffine.new(in_dim: 4, out_dim: 3)
+      restored.load_checkpoint(f.path)
+      assert_nested_close [[1.0] * 4] * 3, restored.weight.to_a
+    end
+  end
+
   def test_checkpoint_roundtrip_native_npz_model_and_optimizer
     model = DslAffine.new(in_dim: 1, out_dim: 1)
     optimizer = MLX::Optimizers::SGD.new(learning_rate: 0.1)
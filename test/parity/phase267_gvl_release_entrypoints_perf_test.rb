@@ -14,13 +14,13 @@ class Phase267GvlReleaseEntrypointsPerfTest < Minitest::Test
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
     segment = source[/static VALUE core_eval\(.*?^}\n/m]
     refute_nil segment
-    assert_match(/rb_thread_call_without_gvl\(/, segment)
+    assert_match(/call_with_gvl_policy\(GvlWork::Eval,/, segment)
   end
 
   def test_core_async_eval_has_no_gvl_path
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
     segment = source[/static VALUE core_async_eval\(.*?^}\n/m]
     refute_nil segment
-    assert_match(/rb_thread_call_without_gvl\(/, segment)
+    assert_match(/call_with_gvl_policy\(GvlWork::Eval,/, segment)
   end
 end
@@ -7,6 +7,6 @@ class Phase268NestedArrayIngestFastPathPerfTest < Minitest::Test
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
     segment = source[/static mx::array tensor_array_from_ruby\(.*?^}\n/m]
     refute_nil segment
-    assert_match(/std::vector<float>/, segment)
+    assert_match(/nested_array_typed<float>/, segment)
   end
 end
@@ -8,7 +8,7 @@ class Phase270ToAVectorFastPathPerfTest < Minitest::Test
     segment = source[/static VALUE array_to_a\(.*?^}\n/m]
     refute_nil segment
 
-    assert_match(/if \(wrapper->array\.ndim\(\) == 1\)/, segment)
-    assert_match(/if \(wrapper->array\.ndim\(\) == 1\) \{\n\s*wrapper->array\.eval\(\);/m, segment)
+    assert_match(/if \(host\.ndim\(\) == 1\)/, segment)
+    assert_match(/if \(host\.ndim\(\) == 1\) \{.*?build_flat_ruby_array\(/m, segment)
   end
 end
@@ -3,12 +3,12 @@
 require_relative "test_helper"
 
 class Phase272NestedIngestReservePerfTest < Minitest::Test
-  def test_infer_shape_and_flatten_typed_reserves_capacity_for_known_subtrees
+  def test_nested_ingest_sizes_the_output_before_filling
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
-    segment = source[/template <typename T>\nstatic void infer_shape_and_flatten_typed\(.*?^}\n/m]
+    segment = source[/static mx::array tensor_array_from_ruby\(.*?^}\n/m]
     refute_nil segment
 
-    assert_match(/flat\.reserve\(/, segment)
-    assert_match(/shape\.size\(\) > depth \+ 1/, segment)
+    assert_match(/nested_array_shape\(value\)/, segment)
+    refute_match(/std::vector/, segment)
   end
 end
@@ -7,20 +7,20 @@ class Phase276BlockingIoGvlReleasePerfTest < Minitest::Test
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
     segment = source[/static VALUE core_synchronize\(.*?^}\n/m]
     refute_nil segment
-    assert_match(/rb_thread_call_without_gvl\(/, segment)
+    assert_match(/call_with_gvl_policy\(GvlWork::Eval,/, segment)
   end
 
   def test_core_save_releases_gvl
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
     segment = source[/static VALUE core_save\(.*?^}\n/m]
     refute_nil segment
-    assert_match(/rb_thread_call_without_gvl\(/, segment)
+    assert_match(/call_with_gvl_policy\(GvlWork::IO,/, segment)
   end
 
   def test_core_load_npy_branch_releases_gvl
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
     segment = source[/static VALUE core_load\(.*?^}\n/m]
     refute_nil segment
-    assert_match(/format_v == "npy".*rb_thread_call_without_gvl\(/m, segment)
+    assert_match(/format_v == "npy".*call_with_gvl_policy\(GvlWork::IO,/m, segment)
   end
 end
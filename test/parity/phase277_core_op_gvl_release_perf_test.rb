@@ -5,14 +5,15 @@ require_relative "test_helper"
 class Phase277CoreOpGvlReleasePerfTest < Minitest::Test
   TARGET_FUNCTIONS = %w[core_add core_subtract core_multiply core_divide core_matmul].freeze
 
-  def test_high_traffic_core_ops_use_shared_no_gvl_array_helper
+  def test_high_traffic_core_ops_follow_graph_gvl_policy
     source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
-    assert_match(/static mx::array call_mx_array_without_gvl\(/, source)
+    assert_match(/static std::invoke_result_t<Fn&> call_with_gvl_policy\(/, source)
+    refute_match(/call_mx_array_without_gvl/, source)
 
     TARGET_FUNCTIONS.each do |fn_name|
       segment = source[/static VALUE #{Regexp.escape(fn_name)}\(.*?^}\n/m]
       refute_nil segment, "missing function segment for #{fn_name}"
-      assert_match(/call_mx_array_without_gvl\(/, segment, "#{fn_name} should execute compute without GVL")
+      assert_match(/call_with_gvl_policy\(GvlWork::Graph,/, segment, "#{fn_name} should follow the graph GVL policy")
     end
   end
 end
@@ -0,0 +1,60 @@
+# frozen_string_literal: true
+
+require "tempfile"
+require_relative "test_helper"
+
+class Phase278BinaryIngestPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_from_bytes_builds_array_from_packed_string
+    packed = [1.5, -2.0, 3.25, 4.0, 5.5, 6.0].pack("e*")
+    x = MLX::Core.from_bytes(packed, [2, 3], MLX::Core.float32)
+
+    assert_equal [2, 3], x.shape
+    assert_equal MLX::Core.float32, x.dtype
+    assert_equal [[1.5, -2.0, 3.25], [4.0, 5.5, 6.0]], x.to_a
+
+    tokens = MLX::Core.from_bytes([7, -1, 42].pack("l<*"), nil, :int32)
+    assert_equal [3], tokens.shape
+    assert_equal [7, -1, 42], tokens.to_a
+  end
+
+  def test_from_bytes_rejects_size_mismatch
+    assert_raises(ArgumentError) do
+      MLX::Core.from_bytes([1, 2, 3].pack("l<*"), [2, 2], MLX::Core.int32)
+    end
+  end
+
+  def test_from_bytes_rejects_negative_and_overflowing_shapes
+    assert_raises(ArgumentError) { MLX::Core.from_bytes("", [-1, 0], MLX::Core.int32) }
+    assert_raises(ArgumentError) { MLX::Core.from_bytes("", [2**31 - 1] * 4, MLX::Core.int32) }
+  end
+
+  def test_from_io_reads_from_current_position
+    Tempfile.create(["mlx-from-io", ".bin"], TestSupport.test_tmp_dir) do |file|
+      file.binmode
+      file.write("HDR!")
+      file.write([1, 2, 3, 4].pack("s<*"))
+      file.write([9.0, 8.0].pack("E*"))
+      file.flush
+      file.rewind
+
+      assert_equal "HDR!", file.read(4)
+      shorts = MLX::Core.from_io(file, [2, 2], MLX::Core.int16)
+      assert_equal [[1, 2], [3, 4]], shorts.to_a
+      assert_equal 12, file.pos
+
+      doubles = MLX::Core.from_io(file, [2], MLX::Core.float64)
+      assert_equal [9.0, 8.0], doubles.to_a
+      assert_raises(EOFError) { MLX::Core.from_io(file, [1], MLX::Core.int32) }
+    end
+  end
+end
@@ -0,0 +1,56 @@
+# frozen_string_literal: true
+
+require "fiddle"
+require_relative "test_helper"
+
+class Phase279ArrayMemoryViewPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_memory_view_exposes_format_shape_and_strides
+    x = MLX::Core.array([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]], MLX::Core.float32)
+    x.define_singleton_method(:to_a) do
+      raise "memory view export should not call to_a"
+    end
+
+    view = Fiddle::MemoryView.new(x)
+    begin
+      assert_equal "f", view.format
+      assert_equal 4, view.item_size
+      assert_equal 2, view.ndim
+      assert_equal [2, 3], view.shape
+      assert_equal [12, 4], view.strides
+      assert_equal 24, view.byte_size
+      assert view.readonly?
+      assert_equal [1.0, 2.0, 3.0, 4.0, 5.0, 6.0], view.to_s.unpack("f*")
+      assert_in_delta 6.0, view[1, 2], 1e-6
+    ensure
+      view.release
+    end
+  end
+
+  def test_memory_view_materializes_non_contiguous_arrays
+    x = MLX::Core.transpose(MLX::Core.array([[1, 2], [3, 4]], MLX::Core.int32))
+    view = Fiddle::MemoryView.new(x)
+    begin
+      assert_equal "l", view.format
+      assert_equal [2, 2], view.shape
+      assert_equal [1, 3, 2, 4], view.to_s.unpack("l*")
+    ensure
+      view.release
+    end
+  end
+
+  def test_memory_view_refuses_half_precision_arrays
+    [MLX::Core.float16, MLX::Core.bfloat16].each do |dtype|
+      assert_raises(ArgumentError) { Fiddle::MemoryView.new(MLX::Core.array([1.0, 2.0], dtype)) }
+    end
+  end
+end
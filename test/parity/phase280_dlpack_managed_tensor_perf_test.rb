@@ -0,0 +1,64 @@
+# frozen_string_literal: true
+
+require "fiddle"
+require_relative "test_helper"
+
+class Phase280DlpackManagedTensorPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_capsule_exports_managed_tensor_layout
+    x = MLX::Core.array([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]], MLX::Core.float32)
+    capsule = x.__dlpack__
+    address = capsule.address
+    assert_kind_of Integer, address
+    refute capsule.consumed?
+
+    # DLTensor: data, device{int32,int32}, ndim, dtype{u8,u8,u16}, shape*, strides*, byte_offset
+    header = Fiddle::Pointer.new(address).to_s(48)
+    data, device_type, _device_id, ndim, code, bits, lanes, shape_ptr, strides_ptr, offset =
+      header.unpack("Q l l l C C S Q Q Q")
+    assert_equal 1, device_type
+    assert_equal 2, ndim
+    assert_equal [2, 32, 1], [code, bits, lanes]
+    assert_equal 0, offset
+    assert_equal [2, 3], Fiddle::Pointer.new(shape_ptr).to_s(16).unpack("q*")
+    assert_equal [3, 1], Fiddle::Pointer.new(strides_ptr).to_s(16).unpack("q*")
+    assert_equal [1.0, 2.0, 3.0, 4.0, 5.0, 6.0], Fiddle::Pointer.new(data).to_s(24).unpack("f*")
+  end
+
+  def test_consumed_capsule_roundtrips_through_address
+    x = MLX::Core.transpose(MLX::Core.array([[1, 2], [3, 4]], MLX::Core.int32))
+    capsule = x.__dlpack__
+    address = capsule.consume
+    assert capsule.consumed?
+    assert_raises(RuntimeError) { capsule.consume }
+
+    y = MLX::Core.from_dlpack_address(address)
+    assert_equal MLX::Core.int32, y.dtype
+    assert_equal [[1, 3], [2, 4]], y.to_a
+
+    pointer = Fiddle::Pointer.new(MLX::Core.array([5, 6], MLX::Core.int32).__dlpack__.consume)
+    assert_equal [5, 6], MLX::Core.from_dlpack(pointer).to_a
+  end
+
+  def test_from_dlpack_rejects_plain_integers
+    assert_raises(TypeError) { MLX::Core.from_dlpack(5) }
+  end
+
+  def test_from_dlpack_accepts_dlpack_producers
+    x = MLX::Core.array([1.5, 2.5], MLX::Core.float32)
+    producer = Object.new
+    producer.define_singleton_method(:__dlpack__) { x.__dlpack__ }
+
+    assert_equal [1.5, 2.5], MLX::Core.from_dlpack(producer).to_a
+    assert_raises(TypeError) { MLX::Core.from_dlpack(Object.new) }
+  end
+end
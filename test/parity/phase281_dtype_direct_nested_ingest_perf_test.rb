@@ -0,0 +1,51 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase281DtypeDirectNestedIngestPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_integer_batches_keep_exact_values
+    tokens = MLX::Core.array([[1, 2, 3], [2_147_483_647, -2_147_483_648, 0]], MLX::Core.int32)
+    assert_equal MLX::Core.int32, tokens.dtype
+    assert_equal [[1, 2, 3], [2_147_483_647, -2_147_483_648, 0]], tokens.to_a
+
+    big = MLX::Core.array([2**63 + 1, 5], MLX::Core.uint64)
+    assert_equal [2**63 + 1, 5], big.to_a
+
+    wide = MLX::Core.array([9_007_199_254_740_993], MLX::Core.int64)
+    assert_equal [9_007_199_254_740_993], wide.to_a
+  end
+
+  def test_half_precision_and_bool_targets
+    half = MLX::Core.array([[0.5, 1.5], [2, 3]], MLX::Core.float16)
+    assert_equal MLX::Core.float16, half.dtype
+    assert_equal [[0.5, 1.5], [2.0, 3.0]], half.to_a
+
+    brain = MLX::Core.array([1.0, -2.0], MLX::Core.bfloat16)
+    assert_equal MLX::Core.bfloat16, brain.dtype
+    assert_equal [1.0, -2.0], brain.to_a
+
+    mask = MLX::Core.array([true, false, 1, 0], MLX::Core.bool_)
+    assert_equal [true, false, true, false], mask.to_a
+  end
+
+  def test_malformed_input_is_rejected
+    assert_raises(ArgumentError) { MLX::Core.array([[1, 2], [3]], MLX::Core.int32) }
+    assert_raises(ArgumentError) { MLX::Core.array([1, [2]], MLX::Core.int32) }
+    assert_raises(ArgumentError) { MLX::Core.array([[1], 2], MLX::Core.int32) }
+    assert_raises(ArgumentError) { MLX::Core.array([[], [1, 2]]) }
+    assert_raises(ArgumentError) { MLX::Core.array([[[]], [[1]]], MLX::Core.int32) }
+    assert_equal [2, 0], MLX::Core.array([[], []]).shape
+    assert_raises(TypeError) { MLX::Core.array([1, "2"], MLX::Core.int32) }
+    assert_equal [3, 0], MLX::Core.array([[], [], []], MLX::Core.int32).shape
+  end
+end
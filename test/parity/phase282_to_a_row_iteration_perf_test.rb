@@ -0,0 +1,44 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase282ToARowIterationPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_to_a_widens_half_precision_and_reads_strided_views
+    half = MLX::Core.array([[0.5, -1.25], [2.0, 4.0]], MLX::Core.float16)
+    assert_equal [[0.5, -1.25], [2.0, 4.0]], half.to_a
+    assert_equal [[0.5, 2.0], [-1.25, 4.0]], MLX::Core.transpose(half).to_a
+    assert_equal 0.5, MLX::Core.array(0.5, MLX::Core.bfloat16).to_a
+  end
+
+  def test_each_row_yields_rows_lazily
+    x = MLX::Core.reshape(MLX::Core.arange(0, 12, 1, MLX::Core.int32), [3, 2, 2])
+    rows = []
+    x.each_row { |row| rows << row }
+    assert_equal x.to_a, rows
+
+    enum = x.each_row
+    assert_kind_of Enumerator, enum
+    assert_equal [[0, 1], [2, 3]], enum.next
+    assert_equal [0, 1, 2], MLX::Core.array([0, 1, 2], MLX::Core.int32).each_row.to_a
+  end
+
+  def test_each_slice_groups_rows_and_stops_on_break
+    x = MLX::Core.reshape(MLX::Core.arange(0, 10, 1, MLX::Core.int32), [5, 2])
+    assert_equal [[[0, 1], [2, 3]], [[4, 5], [6, 7]], [[8, 9]]], x.each_slice(2).to_a
+
+    first = x.each_slice(3) { |slice| break slice }
+    assert_equal [[0, 1], [2, 3], [4, 5]], first
+    assert_raises(ArgumentError) { x.each_slice(0) { |_| nil } }
+    assert_raises(TypeError) { MLX::Core.array(1.0).each_row { |_| nil } }
+  end
+end
@@ -0,0 +1,45 @@
+# frozen_string_literal: true
+
+require "objspace"
+require_relative "test_helper"
+
+class Phase283ArrayGcAccountingPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    MLX::Core.set_gc_memory_fraction(nil) if defined?(MLX::Core) && MLX::Core.respond_to?(:set_gc_memory_fraction)
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_memsize_reports_array_nbytes
+    x = MLX::Core.zeros([1024, 256], MLX::Core.float32)
+    assert_operator ObjectSpace.memsize_of(x), :>=, x.nbytes
+
+    y = MLX::Core::Array.new([[1, 2], [3, 4]], MLX::Core.int64)
+    assert_operator ObjectSpace.memsize_of(y), :>=, 32
+  end
+
+  def test_gc_memory_fraction_policy_round_trips
+    assert_nil MLX::Core.gc_memory_fraction
+    assert_nil MLX::Core.set_gc_memory_fraction(0.75)
+    assert_in_delta 0.75, MLX::Core.gc_memory_fraction, 1e-12
+    assert_in_delta 0.75, MLX::Core.set_gc_memory_fraction(nil), 1e-12
+    assert_nil MLX::Core.gc_memory_fraction
+
+    assert_raises(ArgumentError) { MLX::Core.set_gc_memory_fraction(0) }
+    assert_raises(ArgumentError) { MLX::Core.set_gc_memory_fraction(1.5) }
+  end
+
+  def test_policy_collects_under_pressure
+    MLX::Core.set_gc_memory_fraction(1e-9)
+    before = GC.count
+    x = MLX::Core.ones([256, 256], MLX::Core.float32)
+    MLX::Core.eval(x)
+    MLX::Core.add(x, x)
+    assert_operator GC.count, :>, before
+  end
+end
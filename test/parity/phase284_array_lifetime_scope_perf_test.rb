@@ -0,0 +1,75 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase284ArrayLifetimeScopePerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_scope_releases_intermediates_and_keeps_results
+    leaked = nil
+    kept = nil
+    result = MLX::Core.scope do
+      a = MLX::Core.array([1.0, 2.0, 3.0])
+      leaked = MLX::Core.multiply(a, 2.0)
+      kept = MLX::Core.keep(MLX::Core.add(a, 1.0))
+      { "sum" => MLX::Core.sum(leaked) }
+    end
+
+    assert_in_delta 12.0, result["sum"].item, 1e-6
+    assert_equal [2.0, 3.0, 4.0], kept.to_a
+    error = assert_raises(RuntimeError) { leaked.to_a }
+    assert_match(/released/, error.message)
+  end
+
+  def test_nested_scopes_hand_results_to_the_parent
+    inner = nil
+    outer_result = MLX::Core.scope do
+      inner = MLX::Core.scope { MLX::Core.array([5, 6], MLX::Core.int32) }
+      assert_equal [5, 6], inner.to_a
+      MLX::Core.array(0.0)
+    end
+
+    assert_equal 0.0, outer_result.item
+    assert_raises(RuntimeError) { inner.to_a }
+  end
+
+  def test_scope_releases_on_exception_and_ignores_outer_arrays
+    outer = MLX::Core.array([1, 2], MLX::Core.int32)
+    temp = nil
+    assert_raises(ArgumentError) do
+      MLX::Core.scope do
+        MLX::Core.keep(outer)
+        temp = MLX::Core.add(outer, outer)
+        raise ArgumentError, "boom"
+      end
+    end
+
+    assert_equal [1, 2], outer.to_a
+    assert_raises(RuntimeError) { temp.to_a }
+    assert_raises(LocalJumpError) { MLX::Core.scope }
+  end
+
+  def test_arrays_created_in_other_fibers_do_not_join_the_scope
+    rows = Enumerator.new do |y|
+      y << MLX::Core.array([1, 2], MLX::Core.int32)
+      y << MLX::Core.array([3, 4], MLX::Core.int32)
+    end
+    first = nil
+    MLX::Core.scope do
+      first = rows.next
+      MLX::Core.array(0.0)
+    end
+    second = rows.next
+
+    assert_equal [1, 2], first.to_a
+    assert_equal [3, 4], second.to_a
+  end
+end
@@ -0,0 +1,43 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase285ArrayWrapperPoolPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_array_wrap_constructs_wrapper_in_place
+    source = File.read(File.join(RUBY_ROOT, "ext", "mlx", "native.cpp"))
+    segment = source[/static VALUE array_wrap\(mx::array array\) \{.*?^}\n/m]
+    refute_nil segment
+    assert_match(/new ArrayWrapper\(std::move\(array\)\)/, segment)
+    refute_match(/wrapper->array = array;/, segment)
+  end
+
+  def test_wrapper_stats_track_churn_and_reuse
+    MLX::Core.reset_wrapper_stats
+    x = MLX::Core.array([1.0, 2.0])
+    100.times { MLX::Core.add(x, x) }
+    GC.start
+
+    stats = MLX::Core.wrapper_stats
+    %w[created freed live pool_hits pooled].each { |key| assert_kind_of Integer, stats.fetch(key) }
+    assert_operator stats["created"], :>=, 100
+    assert_operator stats["live"], :>=, 1
+
+    100.times { MLX::Core.add(x, x) }
+    assert_operator MLX::Core.wrapper_stats["pool_hits"], :>, 0
+
+    MLX::Core.reset_wrapper_stats
+    reset = MLX::Core.wrapper_stats
+    assert_equal 0, reset["created"]
+    assert_operator reset["live"], :>=, 1
+  end
+end
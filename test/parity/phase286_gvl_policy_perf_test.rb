@@ -0,0 +1,48 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase286GvlPolicyPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+    @previous_policy = MLX::Core.gvl_policy
+  end
+
+  def teardown
+    if @previous_policy
+      @previous_policy.each { |kind, release| MLX::Core.set_gvl_policy(kind.to_sym, release) }
+    end
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_default_policy_holds_for_graph_and_releases_for_eval_and_io
+    assert_equal({ "graph" => false, "eval" => true, "io" => true }, MLX::Core.gvl_policy)
+  end
+
+  def test_counters_split_held_and_released_work
+    MLX::Core.reset_gvl_stats
+    x = MLX::Core.array([1.0, 2.0])
+    y = MLX::Core.add(x, x)
+    MLX::Core.eval(y)
+
+    stats = MLX::Core.gvl_stats
+    assert_operator stats["graph"]["held_calls"], :>=, 1
+    assert_equal 0, stats["graph"]["released_calls"]
+    assert_operator stats["eval"]["released_calls"], :>=, 1
+    assert_operator stats["eval"]["released_seconds"], :>=, 0.0
+  end
+
+  def test_policy_is_configurable_per_kind
+    assert_equal false, MLX::Core.set_gvl_policy(:graph, true)
+    MLX::Core.reset_gvl_stats
+    x = MLX::Core.array([1.0, 2.0])
+    assert_equal [2.0, 4.0], MLX::Core.add(x, x).to_a
+    assert_operator MLX::Core.gvl_stats["graph"]["released_calls"], :>=, 1
+
+    assert_equal true, MLX::Core.set_gvl_policy("eval", false)
+    assert_equal false, MLX::Core.gvl_policy["eval"]
+    assert_raises(ArgumentError) { MLX::Core.set_gvl_policy(:compile, true) }
+  end
+end
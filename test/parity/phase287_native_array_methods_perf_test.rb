@@ -0,0 +1,55 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase287NativeArrayMethodsPerfTest < Minitest::Test
+  NATIVE_METHODS = %i[
+    add subtract multiply divide __add__ __sub__ __mul__ __truediv__ __matmul__ __neg__
+    square sqrt rsqrt exp log abs sum mean max min reshape transpose flatten astype
+  ].freeze
+
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_hot_path_methods_are_defined_natively
+    NATIVE_METHODS.each do |name|
+      method = MLX::Core::Array.instance_method(name)
+      assert_nil method.source_location, "#{name} should be a native method"
+    end
+  end
+
+  def test_native_methods_match_module_functions
+    x = MLX::Core.array([[1.0, 4.0], [9.0, 16.0]], MLX::Core.float32)
+
+    assert_equal [[2.0, 5.0], [10.0, 17.0]], x.__add__(1.0).to_a
+    assert_equal [[1.0, 2.0], [3.0, 4.0]], x.sqrt.to_a
+    assert_equal [5.0, 25.0], x.sum(1).to_a
+    assert_equal [[5.0], [25.0]], x.sum(1, true).to_a
+    assert_equal 30.0, x.sum.item
+    assert_equal 7.5, x.mean.item
+    assert_equal [9.0, 16.0], x.max(0).to_a
+    assert_equal 1.0, x.min([0, 1]).item
+    assert_equal [1.0, 4.0, 9.0, 16.0], x.flatten.to_a
+    assert_equal [[1.0, 4.0, 9.0, 16.0]], x.reshape(1, 4).to_a
+    assert_equal [4], x.reshape([4]).shape
+    assert_equal [[1.0, 9.0], [4.0, 16.0]], x.transpose.to_a
+    assert_equal [[1.0, 9.0], [4.0, 16.0]], x.transpose([1, 0]).to_a
+    assert_equal MLX::Core.int32, x.astype(MLX::Core.int32).dtype
+    assert_equal [[37.0, 68.0], [153.0, 292.0]], x.__matmul__(x).to_a
+    assert_equal [[-1.0, -4.0], [-9.0, -16.0]], x.__neg__.to_a
+  end
+
+  def test_native_methods_raise_ruby_errors
+    x = MLX::Core.array([1.0, 2.0, 3.0])
+    assert_raises(ArgumentError) { x.sum(0, true, 1) }
+    assert_raises(RuntimeError) { x.add(MLX::Core.array([1.0, 2.0])) }
+    assert_raises(RuntimeError) { x.reshape(2, 2) }
+  end
+end
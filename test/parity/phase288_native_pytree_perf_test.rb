@@ -0,0 +1,58 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase288NativePytreePerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_tree_spec_round_trips_and_keys_by_structure
+    a = MLX::Core.array([1.0])
+    b = MLX::Core.array([2.0])
+    tree = [{ "w" => a, "meta" => [1, :x, nil] }, [b]]
+
+    arrays = []
+    spec = MLX::Core.tree_flatten_spec(tree, arrays, false)
+    assert_kind_of MLX::Core::TreeSpec, spec
+    assert_equal 2, spec.leaf_count
+    assert_equal [a, b].map(&:object_id), arrays.map(&:object_id)
+
+    rebuilt, cursor = MLX::Core.tree_inflate(spec, arrays, 0)
+    assert_equal 2, cursor
+    assert_same a, rebuilt[0]["w"]
+    assert_equal [1, :x, nil], rebuilt[0]["meta"]
+    assert_same b, rebuilt[1][0]
+
+    same = MLX::Core.tree_flatten_spec([{ "w" => b, "meta" => [1, :x, nil] }, [a]], [], false)
+    different = MLX::Core.tree_flatten_spec([{ "w" => b, "meta" => [1.0, :x, nil] }, [a]], [], false)
+    assert_equal spec.hash, same.hash
+    assert spec.eql?(same)
+    refute spec.eql?(different)
+    assert_equal 1, { spec => 1, same => 1 }.size
+
+    assert_raises(TypeError) { MLX::Core.tree_flatten_spec([a, 1], [], true) }
+    assert_raises(TypeError) { MLX::Core.tree_flatten_spec([Object.new], [], false) }
+    assert_raises(IndexError) { MLX::Core.tree_inflate(spec, [a], 0) }
+  end
+
+  def test_utils_tree_helpers_use_native_engine
+    assert MLX::Utils.respond_to?(:native_tree_map)
+
+    tree = { "a" => [1, 2], "b" => { "c" => 3 } }
+    mapped = MLX::Utils.tree_map(->(x, y) { x + y }, tree, { "a" => [10, 20], "b" => { "c" => 30 } })
+    assert_equal({ "a" => [11, 22], "b" => { "c" => 33 } }, mapped)
+
+    flat = MLX::Utils.tree_flatten(tree, prefix: ".model")
+    assert_equal [["model.a.0", 1], ["model.a.1", 2], ["model.b.c", 3]], flat
+    assert_equal({ "model" => { "a" => [1, 2], "b" => { "c" => 3 } } }, MLX::Utils.tree_unflatten(flat))
+    assert_equal({ "a.0" => 1, "a.1" => 2, "b.c" => 3 }, MLX::Utils.tree_flatten(tree, destination: {}))
+    assert_equal [[1, 2], [3]], MLX::Utils.tree_flatten([[1, 2], [3]], is_leaf: ->(x) { x.is_a?(Array) && x.all?(Integer) }).map(&:last)
+  end
+end
@@ -0,0 +1,100 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase289CompileCachePerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+    @previous_limit = MLX::Core.compile_cache_limit
+    MLX::Core.reset_compile_stats
+  end
+
+  def teardown
+    MLX::Core.set_compile_cache_limit(@previous_limit) if @previous_limit
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_cache_keys_on_shape_and_dtype
+    fn = MLX::Core.compile(->(x) { MLX::Core.add(x, x) })
+
+    fn.call(MLX::Core.array([1.0, 2.0]))
+    fn.call(MLX::Core.array([3.0, 4.0]))
+    fn.call(MLX::Core.array([1.0, 2.0, 3.0]))
+    out = fn.call(MLX::Core.array([1, 2], MLX::Core.int32))
+
+    assert_equal [2, 4], out.to_a
+    stats = MLX::Core.compile_stats
+    assert_equal 1, stats["hits"]
+    assert_equal 3, stats["misses"]
+    assert_equal 3, stats["traces"]
+    assert_operator stats["trace_seconds"], :>=, 0.0
+  end
+
+  def test_shapeless_cache_ignores_dimension_sizes
+    fn = MLX::Core.compile(->(x) { MLX::Core.multiply(x, x) }, nil, nil, true)
+
+    fn.call(MLX::Core.array([1.0, 2.0]))
+    assert_equal [1.0, 4.0, 9.0], fn.call(MLX::Core.array([1.0, 2.0, 3.0])).to_a
+
+    stats = MLX::Core.compile_stats
+    assert_equal 1, stats["misses"]
+    assert_equal 1, stats["hits"]
+  end
+
+  def test_lru_eviction_bounds_entries
+    assert_raises(ArgumentError) { MLX::Core.set_compile_cache_limit(0) }
+    MLX::Core.set_compile_cache_limit(2)
+    MLX::Core.reset_compile_stats
+    fn = MLX::Core.compile(->(x) { MLX::Core.add(x, x) })
+
+    a = MLX::Core.array([1.0])
+    b = MLX::Core.array([1.0, 2.0])
+    c = MLX::Core.array([1.0, 2.0, 3.0])
+    fn.call(a)
+    fn.call(b)
+    fn.call(a)
+    fn.call(c)
+    fn.call(a)
+
+    # Entries left by earlier tests are older and may be evicted first.
+    stats = MLX::Core.compile_stats
+    assert_operator stats["evictions"], :>=, 1
+    assert_equal 2, stats["hits"]
+    assert_equal 2, stats["entries"]
+
+    fn.call(b)
+    assert_equal 4, MLX::Core.compile_stats["misses"]
+  end
+
+  def test_limit_is_shared_across_compiled_functions
+    MLX::Core.set_compile_cache_limit(2)
+    double = MLX::Core.compile(->(x) { MLX::Core.add(x, x) })
+    square = MLX::Core.compile(->(x) { MLX::Core.multiply(x, x) })
+    a = MLX::Core.array([1.0, 2.0])
+    b = MLX::Core.array([1.0, 2.0, 3.0])
+
+    double.call(a)
+    square.call(a)
+    double.call(b)
+    assert_equal 2, MLX::Core.compile_stats["entries"]
+
+    MLX::Core.reset_compile_stats
+    square.call(a)
+    double.call(a)
+    stats = MLX::Core.compile_stats
+    assert_equal 1, stats["hits"]
+    assert_equal 1, stats["misses"]
+  end
+
+  def test_fetch_leaves_cache_unchanged_when_block_raises
+    cache = MLX::Core::CompileCache.new
+    spec = MLX::Core.tree_flatten_spec([1], [], false)
+    assert_raises(RuntimeError) { cache.fetch(spec, []) { raise "boom" } }
+    assert_equal 0, cache.size
+    assert_equal :ok, cache.fetch(spec, []) { :ok }
+    assert_equal :ok, cache.fetch(spec, []) { :other }
+    assert_equal 1, cache.size
+  end
+end
@@ -0,0 +1,59 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase290NativeNpzPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_npz_round_trips_natively
+    x = MLX::Core.array([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]], MLX::Core.float32)
+    y = MLX::Core.arange(0, 12, 1, MLX::Core.int64)
+    h = MLX::Core.array([0.5, -1.5], MLX::Core.bfloat16)
+    t = MLX::Core.transpose(x)
+
+    TestSupport.mktmpdir do |dir|
+      path = File.join(dir, "weights")
+      MLX::Core.savez(path, y, x: x, h: h, t: t)
+      assert_equal "PK\x03\x04".b, File.binread(path + ".npz", 4)
+
+      loaded = MLX::Core.load(path + ".npz")
+      assert_equal %w[arr_0 h t x], loaded.keys.sort
+      assert_equal MLX::Core.int64, loaded["arr_0"].dtype
+      assert_equal MLX::Core.bfloat16, loaded["h"].dtype
+      assert MLX::Core.array_equal(y, loaded["arr_0"])
+      assert MLX::Core.array_equal(x, loaded["x"])
+      assert MLX::Core.array_equal(h, loaded["h"])
+      assert MLX::Core.array_equal(t, loaded["t"])
+    end
+  end
+
+  def test_compressed_members_are_deflated
+    x = MLX::Core.zeros([4096], MLX::Core.float32)
+
+    TestSupport.mktmpdir do |dir|
+      stored = File.join(dir, "stored.npz")
+      deflated = File.join(dir, "deflated.npz")
+      MLX::Core.savez(stored, x: x)
+      MLX::Core.savez_compressed(deflated, x: x)
+
+      assert_operator File.size(deflated), :<, File.size(stored) / 4
+      assert MLX::Core.array_equal(x, MLX::Core.load(deflated)["x"])
+    end
+  end
+
+  def test_corrupt_archive_raises
+    TestSupport.mktmpdir do |dir|
+      path = File.join(dir, "broken.npz")
+      File.binwrite(path, "not a zip archive at all, just bytes")
+      assert_raises(RuntimeError) { MLX::Core.load(path) }
+    end
+  end
+end
@@ -0,0 +1,112 @@
+# frozen_string_literal: true
+
+require "json"
+require_relative "test_helper"
+
+class Phase291SafetensorsMmapPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_mmap_load_is_lazy_and_selectable
+    TestSupport.mktmpdir do |dir|
+      path = write_safetensors(
+        File.join(dir, "model.safetensors"),
+        {
+          "encoder.w" => ["F32", [2, 2], [1.0, 2.0, 3.0, 4.0].pack("e*")],
+          "encoder.b" => ["F32", [2], [5.0, 6.0].pack("e*")],
+          "decoder.ids" => ["I32", [3], [7, 8, 9].pack("l<*")],
+          "head.mask" => ["U8", [3], [1, 0, 1].pack("C*")]
+        },
+        { "format" => "mlx" }
+      )
+
+      tensors = MLX::Core.load(path, mmap: true)
+      assert_kind_of MLX::Core::SafetensorsFile, tensors
+      assert_equal %w[encoder.w encoder.b decoder.ids head.mask], tensors.keys
+      assert_equal 4, tensors.size
+      assert_equal 16 + 8 + 12 + 3, tensors.nbytes
+      assert tensors.key?("decoder.ids")
+      assert_nil tensors["missing"]
+      assert_raises(KeyError) { tensors.fetch("missing") }
+
+      assert_equal [[1.0, 2.0], [3.0, 4.0]], tensors["encoder.w"].to_a
+      assert_equal MLX::Core.int32, tensors["decoder.ids"].dtype
+      assert_equal [7, 8, 9], tensors.fetch("decoder.ids").to_a
+      assert_equal [1, 0, 1], tensors["head.mask"].to_a
+
+      selected, metadata = MLX::Core.load(path, "safetensors", true, mmap: true, keys: ["head.mask"], prefix: "encoder.")
+      assert_equal({ "format" => "mlx" }, metadata)
+      assert_equal %w[encoder.w encoder.b head.mask], selected.keys
+      assert_equal [5.0, 6.0], selected.to_h["encoder.b"].to_a
+
+      assert_raises(KeyError) { MLX::Core.load(path, mmap: true, keys: ["nope"]) }
+      assert_raises(ArgumentError) { MLX::Core.load(File.join(dir, "x.npz"), mmap: true) }
+    end
+  end
+
+  def test_ops_that_reuse_mapped_buffers_leave_the_file_untouched
+    TestSupport.mktmpdir do |dir|
+      path = write_safetensors(
+        File.join(dir, "w.safetensors"),
+        { "w" => ["F32", [4], [0.0, 1.0, 2.0, 3.0].pack("e*")] },
+        {}
+      )
+      before = File.binread(path)
+
+      tensors = MLX::Core.load(path, mmap: true)
+      out = MLX::Core.add(tensors["w"], 1.0)
+      GC.start
+      assert_equal [1.0, 2.0, 3.0, 4.0], out.to_a
+      assert_equal before, File.binread(path)
+      assert_equal [0.0, 1.0, 2.0, 3.0], tensors["w"].to_a
+    end
+  end
+
+  def test_rejects_malformed_headers
+    TestSupport.mktmpdir do |dir|
+      path = File.join(dir, "broken.safetensors")
+      File.binwrite(path, [64].pack("Q<") + "{\"x\": {")
+      assert_raises(RuntimeError) { MLX::Core.load(path, mmap: true) }
+
+      bad_offsets = write_safetensors(
+        File.join(dir, "offsets.safetensors"), { "x" => ["F32", [4], [1.0].pack("e*")] }, nil
+      )
+      assert_raises(RuntimeError) { MLX::Core.load(bad_offsets, mmap: true) }
+    end
+  end
+
+  def test_npz_load_supports_key_selection
+    x = MLX::Core.array([1.0], MLX::Core.float32)
+    TestSupport.mktmpdir do |dir|
+      path = File.join(dir, "weights.npz")
+      MLX::Core.savez(path, **{ "layer.0.w": x, "layer.1.w": x, "head.w": x })
+
+      assert_equal %w[layer.0.w layer.1.w], MLX::Core.load(path, prefix: "layer.").keys.sort
+      assert_equal %w[head.w], MLX::Core.load(path, keys: ["head.w"]).keys
+    end
+  end
+
+  private
+
+  def write_safetensors(path, tensors, metadata)
+    header = {}
+    header["__metadata__"] = metadata if metadata
+    data = +"".b
+    tensors.each do |name, (dtype, shape, bytes)|
+      declared = shape.inject(1, :*) * (dtype == "U8" ? 1 : 4)
+      header[name] = { "dtype" => dtype, "shape" => shape, "data_offsets" => [data.bytesize, data.bytesize + declared] }
+      data << bytes
+    end
+    json = JSON.generate(header)
+    json << " " * ((8 - (json.bytesize % 8)) % 8)
+    File.binwrite(path, [json.bytesize].pack("Q<") + json + data)
+    path
+  end
+end
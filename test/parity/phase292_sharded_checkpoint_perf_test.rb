@@ -0,0 +1,70 @@
+# frozen_string_literal: true
+
+require "json"
+require_relative "test_helper"
+
+class Phase292ShardedCheckpointPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_save_sharded_splits_by_byte_budget_and_round_trips
+    arrays = {
+      "a.w" => MLX::Core.ones([4, 4], MLX::Core.float32),
+      "a.b" => MLX::Core.array([1, 2, 3, 4], MLX::Core.int32),
+      "b.w" => MLX::Core.full([8, 8], 2.0, MLX::Core.float16),
+      "c.w" => MLX::Core.transpose(MLX::Core.reshape(MLX::Core.arange(6), [2, 3]))
+    }
+
+    TestSupport.mktmpdir do |dir|
+      index_path = MLX::Core.save_sharded(dir, arrays, max_shard_size: 80, num_threads: 2)
+      index = JSON.parse(File.read(index_path))
+      assert_equal 16 * 4 + 16 + 64 * 2 + 24, index["metadata"]["total_size"]
+      shards = index["weight_map"].values.uniq
+      assert_equal 3, shards.length
+      assert_equal "model-00001-of-00003.safetensors", index["weight_map"]["a.w"]
+      assert_equal "model-00002-of-00003.safetensors", index["weight_map"]["b.w"]
+
+      loaded = MLX::Core.load_sharded(dir, num_threads: 4)
+      assert_equal arrays.keys.sort, loaded.keys.sort
+      arrays.each { |name, array| assert MLX::Core.array_equal(array, loaded[name]), name }
+      assert_equal MLX::Core.float16, loaded["b.w"].dtype
+      assert_equal({ "format" => "mlx" }, MLX::Core.load(File.join(dir, shards.first), mmap: true).metadata)
+    end
+  end
+
+  def test_load_sharded_validates_headers_against_expected_shapes
+    TestSupport.mktmpdir do |dir|
+      MLX::Core.save_sharded(dir, { "w" => MLX::Core.zeros([2, 2]), "b" => MLX::Core.zeros([2]) }, max_shard_size: 16)
+
+      err = assert_raises(ArgumentError) { MLX::Core.load_sharded(dir, expected: { "w" => [2, 3], "b" => [2] }) }
+      assert_match(/Expected shape \[2, 3\] but received shape \[2, 2\] for parameter w/, err.message)
+      err = assert_raises(ArgumentError) { MLX::Core.load_sharded(dir, expected: { "w" => [2, 2] }) }
+      assert_match(/Received 1 parameters not in model/, err.message)
+      err = assert_raises(ArgumentError) { MLX::Core.load_sharded(dir, expected: { "w" => [2, 2], "b" => [2], "c" => [1] }) }
+      assert_match(/Missing 1 parameters/, err.message)
+    end
+  end
+
+  def test_module_weights_round_trip_through_shards
+    model = MLX::NN::Linear.new(4, 3)
+    other = MLX::NN::Linear.new(4, 3)
+
+    TestSupport.mktmpdir do |dir|
+      model.save_weights(dir, max_shard_size: 16)
+      assert_operator Dir.glob(File.join(dir, "*.safetensors")).length, :>=, 2
+
+      other.load_weights(File.join(dir, "model.safetensors.index.json"))
+      assert MLX::Core.array_equal(model.weight, other.weight)
+      assert MLX::Core.array_equal(model.bias, other.bias)
+
+      assert_raises(ArgumentError) { MLX::NN::Linear.new(4, 5).load_weights(dir) }
+    end
+  end
+end
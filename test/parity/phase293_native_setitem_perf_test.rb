@@ -0,0 +1,107 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase293NativeSetitemPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_setitem_is_native_and_does_not_round_trip_through_ruby
+    assert_equal :__setitem__, MLX::Core::Array.instance_method(:__setitem__).name
+    assert_nil MLX::Core::Array.instance_method(:__setitem__).source_location
+
+    x = MLX::Core.reshape(MLX::Core.arange(0, 24, 1, MLX::Core.float32), [2, 3, 4])
+    x.define_singleton_method(:to_a) { raise "__setitem__ should not call to_a" }
+    out = x.__setitem__([1, 0..1, (0..) % 2], -1.0)
+
+    expected = (0...24).map(&:to_f).each_slice(4).each_slice(3).to_a
+    [0, 1].each { |j| [0, 2].each { |k| expected[1][j][k] = -1.0 } }
+    assert_equal expected, out.tolist
+  end
+
+  def test_setitem_basic_indices_with_broadcast_values
+    x = MLX::Core.zeros([2, 3, 4], MLX::Core.int32)
+
+    row = x.__setitem__(1, [1, 2, 3, 4])
+    assert_equal [[1, 2, 3, 4]] * 3, row.tolist[1]
+    assert_equal [[0] * 4] * 3, row.tolist[0]
+
+    stepped = x.__setitem__([:"...", 3.step(0, -2)], MLX::Core.array([7, 8], MLX::Core.int32))
+    assert_equal [0, 8, 0, 7], stepped.tolist[0][2]
+
+    column = x.__setitem__(0, 1...3, -1, 5)
+    assert_equal [[0, 0, 0, 0], [0, 0, 0, 5], [0, 0, 0, 5]], column.tolist[0]
+
+    expanded = x.__setitem__([nil, 0, 0], [[9, 9, 9, 9]])
+    assert_equal [9, 9, 9, 9], expanded.tolist[0][0]
+    assert_equal [[0] * 4] * 3, x.tolist[0]
+  end
+
+  def test_setitem_integer_arrays_scatter_with_numpy_layout
+    x = MLX::Core.zeros([2, 3, 4], MLX::Core.float32)
+
+    pairs = x.__setitem__([MLX::Core.array([0, 1], MLX::Core.int32), MLX::Core.array([1, -1], MLX::Core.int32)], [[1.0], [2.0]])
+    assert_equal [1.0] * 4, pairs.tolist[0][1]
+    assert_equal [2.0] * 4, pairs.tolist[1][2]
+
+    split = x.__setitem__([MLX::Core.array([0, 1], MLX::Core.int32), 0..-1, MLX::Core.array([0, 3], MLX::Core.int32)], [[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]])
+    assert_equal [1.0, 2.0, 3.0], split.tolist[0].map(&:first)
+    assert_equal [4.0, 5.0, 6.0], split.tolist[1].map(&:last)
+  end
+
+  def test_setitem_plain_ruby_list_indices_and_masks
+    x = MLX::Core.zeros([3, 2], MLX::Core.float32)
+
+    rows = x.__setitem__([0, 2], 1.0)
+    assert_equal [[1.0, 1.0], [0.0, 0.0], [1.0, 1.0]], rows.tolist
+
+    reordered = x.__setitem__([2, 0], [[4.0, 5.0], [6.0, 7.0]])
+    assert_equal [[6.0, 7.0], [0.0, 0.0], [4.0, 5.0]], reordered.tolist
+
+    masked = x.__setitem__([[true, false], [false, false], [false, true]], 3.0)
+    assert_equal [[3.0, 0.0], [0.0, 0.0], [0.0, 3.0]], masked.tolist
+  end
+
+  def test_setitem_boolean_masks
+    x = MLX::Core.reshape(MLX::Core.arange(0, 6, 1, MLX::Core.float32), [2, 3])
+    mask = MLX::Core.greater(x, 2.0)
+
+    clipped = x.__setitem__(mask, 0.0)
+    assert_equal [[0.0, 1.0, 2.0], [0.0, 0.0, 0.0]], clipped.tolist
+
+    packed = x.__setitem__(MLX::Core.greater(x, 3.0), [7.0, 8.0])
+    assert_equal [[0.0, 1.0, 2.0], [3.0, 7.0, 8.0]], packed.tolist
+
+    rows = x.__setitem__([true, false], [5.0, 6.0, 7.0])
+    assert_equal [[5.0, 6.0, 7.0], [3.0, 4.0, 5.0]], rows.tolist
+
+    # Per-element values follow mask order even when they also broadcast
+    # to the full shape.
+    mask = MLX::Core.array([[false, true, true], [true, false, false]])
+    ordered = x.__setitem__(mask, [7.0, 8.0, 9.0])
+    assert_equal [[0.0, 7.0, 8.0], [9.0, 4.0, 5.0]], ordered.tolist
+  end
+
+  def test_setitem_on_zero_dim_arrays
+    scalar = MLX::Core.array(3.0)
+    assert_equal 5.0, scalar.__setitem__(nil, 5.0).item
+    assert_equal 6.0, scalar.__setitem__(:"...", 6.0).item
+  end
+
+  def test_setitem_errors
+    x = MLX::Core.zeros([2, 3], MLX::Core.float32)
+
+    assert_raises(IndexError) { x.__setitem__(2, 1.0) }
+    assert_raises(IndexError) { x.__setitem__(0, 0, 0, 1.0) }
+    assert_raises(ArgumentError) { x.__setitem__([:"...", 0, :"..."], 1.0) }
+    assert_raises(ArgumentError) { x.__setitem__(0, [1.0, 2.0]) }
+    assert_raises(TypeError) { x.__setitem__("0", 1.0) }
+  end
+end
@@ -0,0 +1,90 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase294NativeGetitemPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def grid
+    MLX::Core.reshape(MLX::Core.arange(0, 24, 1, MLX::Core.int32), [2, 3, 4])
+  end
+
+  def reference
+    (0...24).each_slice(4).each_slice(3).to_a
+  end
+
+  def test_ranges_steps_and_negative_indices
+    x = grid
+    x.define_singleton_method(:to_a) { raise "[] should not call to_a" }
+
+    assert_equal reference[1][-1], x[-1, -1].tolist
+    assert_equal reference.map { |plane| plane[1..2].map { |row| row[0] } }, x[0..-1, 1..2, 0].tolist
+    assert_equal reference[0][0].values_at(0, 2), x[0, 0, (0..) % 2].tolist
+    assert_equal reference[0][0].reverse, x[0, 0, 3.step(0, -1)].tolist
+    assert_equal reference[1][2].values_at(3, 1), x[1, 2, 3.step(0, -2)].tolist
+    assert_equal [0, 3, 4], x[(5..), 0...3].shape
+  end
+
+  def test_newaxis_and_ellipsis
+    x = grid
+
+    assert_equal [2, 3, 1], x[:"...", nil, 1].shape
+    assert_equal [1, 4], x[nil, 1, 2].shape
+    assert_equal reference.map { |plane| plane.map(&:last) }, x[:ellipsis, -1].tolist
+    assert_equal [2, 3, 4], x[[:"..."]].shape
+  end
+
+  def test_zero_dim_arrays
+    scalar = MLX::Core.array(3.0)
+    assert_equal [1], scalar[nil].shape
+    assert_equal [], scalar[:"..."].shape
+    assert_equal [3.0], scalar[nil].tolist
+  end
+
+  def test_integer_array_gathers_follow_numpy_layout
+    x = grid
+
+    assert_equal [reference[1], reference[0]], x[[1, 0]].tolist
+    assert_equal [reference[0][1], reference[1][2]], x[MLX::Core.array([0, 1], MLX::Core.int32), [1, 2]].tolist
+    assert_equal [[4, 7], [16, 19]], x[0..-1, 1, MLX::Core.array([0, 3], MLX::Core.int32)].tolist
+    assert_equal [[12, 16, 20], [15, 19, 23]], x[1, 0..-1, MLX::Core.array([0, -1], MLX::Core.int32)].tolist
+  end
+
+  def test_plain_ruby_lists_index_as_integers_and_masks
+    x = grid
+
+    assert_equal [reference[0][1], reference[1][2]], x[[0, 1], [1, 2]].tolist
+    assert_equal [2, 1, 3, 4], x[[[1], [0]]].shape
+    assert_equal [reference[1][2]], x[[1], [2]].tolist
+    assert_equal [reference[0][0], reference[1][2]], x[[[true, false, false], [false, false, true]]].tolist
+    assert_equal [reference[1]], x[[false, true]].tolist
+  end
+
+  def test_boolean_masks
+    x = grid
+    mask = MLX::Core.array([[true, false, false], [false, false, true]], MLX::Core.bool_)
+
+    assert_equal [reference[0][0], reference[1][2]], x[mask].tolist
+    assert_equal [[4, 8], [16, 20]], x[0..-1, [false, true, true], 0].tolist
+  end
+
+  def test_errors
+    x = grid
+
+    assert_raises(IndexError) { x[2] }
+    assert_raises(IndexError) { x[0, 0, 0, 0] }
+    assert_raises(IndexError) { x[0, 0, 4] }
+    assert_raises(IndexError) { x[[true, false, true]] }
+    assert_raises(ArgumentError) { x[:"...", :"..."] }
+    assert_raises(TypeError) { x["a"] }
+    assert_raises(TypeError) { x[MLX::Core.array([0.5], MLX::Core.float32)] }
+  end
+end
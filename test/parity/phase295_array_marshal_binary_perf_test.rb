@@ -0,0 +1,63 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase295ArrayMarshalBinaryPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_marshal_round_trip_uses_raw_bytes
+    x = MLX::Core.reshape(MLX::Core.arange(0, 12, 1, MLX::Core.float32), [3, 4])
+    x.define_singleton_method(:to_a) { raise "Marshal.dump should not call to_a" }
+
+    blob = Marshal.dump(x)
+    assert_operator blob.bytesize, :<, 12 * 4 + 64
+
+    restored = Marshal.load(blob)
+    assert_instance_of MLX::Core::Array, restored
+    assert_equal [3, 4], restored.shape
+    assert_equal MLX::Core.float32, restored.dtype
+    assert_equal (0...12).map(&:to_f).each_slice(4).to_a, restored.tolist
+  end
+
+  def test_marshal_preserves_dtype_and_layout
+    {
+      MLX::Core.bfloat16 => [1.5, -2.0],
+      MLX::Core.int64 => [7, -9],
+      MLX::Core.bool_ => [true, false],
+      MLX::Core.uint8 => [255, 0]
+    }.each do |dtype, values|
+      restored = Marshal.load(Marshal.dump(MLX::Core.array(values, dtype)))
+      assert_equal dtype, restored.dtype
+      assert_equal values, restored.tolist
+    end
+
+    transposed = MLX::Core.transpose(MLX::Core.reshape(MLX::Core.arange(0, 6, 1, MLX::Core.int32), [2, 3]))
+    assert_equal [[0, 3], [1, 4], [2, 5]], Marshal.load(Marshal.dump(transposed)).tolist
+
+    scalar = Marshal.load(Marshal.dump(MLX::Core.array(3.0, MLX::Core.float32)))
+    assert_equal [], scalar.shape
+    assert_equal [0, 2], Marshal.load(Marshal.dump(MLX::Core.zeros([0, 2], MLX::Core.float32))).shape
+  end
+
+  def test_load_rejects_malformed_payloads
+    assert_raises(ArgumentError) { MLX::Core::Array._load("nope") }
+    blob = MLX::Core.array([1.0, 2.0], MLX::Core.float32)._dump(-1)
+    assert_raises(ArgumentError) { MLX::Core::Array._load(blob[0...-1]) }
+
+    bad_descr = blob.dup
+    bad_descr[5, 3] = "<z9"
+    error = assert_raises(ArgumentError) { MLX::Core::Array._load(bad_descr) }
+    assert_match(/\A\[Array\._load\] unknown dtype descriptor <z9\z/, error.message)
+
+    bad_descr[5, 3] = ">f4"
+    assert_raises(ArgumentError) { MLX::Core::Array._load(bad_descr) }
+  end
+end
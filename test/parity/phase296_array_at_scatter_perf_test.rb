@@ -0,0 +1,60 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase296ArrayAtScatterPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_repeated_indices_accumulate
+    x = MLX::Core.zeros([4], MLX::Core.float32)
+    x.define_singleton_method(:to_a) { raise "at[] should not call to_a" }
+    idx = MLX::Core.array([0, 2, 2, 2, 3], MLX::Core.int32)
+
+    assert_equal [1.0, 0.0, 3.0, 1.0], x.at[idx].add(1.0).tolist
+    assert_equal [-1.0, 0.0, -3.0, -1.0], x.at[idx].subtract(1.0).tolist
+
+    ones = MLX::Core.ones([4], MLX::Core.float32)
+    assert_equal [2.0, 1.0, 8.0, 2.0], ones.at[idx].multiply(2.0).tolist
+    assert_equal [0.5, 1.0, 0.125, 0.5], ones.at[idx].divide(2.0).tolist
+
+    values = MLX::Core.array([5.0, -1.0, 7.0, 2.0, -4.0], MLX::Core.float32)
+    assert_equal [5.0, 1.0, 7.0, 1.0], ones.at[idx].maximum(values).tolist
+    assert_equal [1.0, 1.0, -1.0, -4.0], ones.at[idx].minimum(values).tolist
+  end
+
+  def test_histogram_and_segment_sum
+    bins = MLX::Core.array([1, 3, 1, 0, 1], MLX::Core.int32)
+    assert_equal [1, 3, 0, 1], MLX::Core.zeros([4], MLX::Core.int32).at[bins].add(1).tolist
+    assert_equal [2, 1, 0, 0], MLX::Core.zeros([4], MLX::Core.int32).at[[0, 0, 1]].add(1).tolist
+    assert_equal [1.0, 0.0, 4.0], MLX::Core.zeros([3], MLX::Core.float32).at[[true, false, true]].add([1.0, 4.0]).tolist
+
+    rows = MLX::Core.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], MLX::Core.float32)
+    segments = MLX::Core.array([1, 0, 1], MLX::Core.int32)
+    assert_equal [[3.0, 4.0], [6.0, 8.0]], MLX::Core.zeros([2, 2], MLX::Core.float32).at[segments].add(rows).tolist
+  end
+
+  def test_nd_index_tuples
+    x = MLX::Core.zeros([2, 3], MLX::Core.float32)
+
+    assert_equal [[0.0, 0.0, 0.0], [0.0, 2.0, 0.0]], x.at[[1, 1], 1].add(1.0).tolist
+    assert_equal [[0.0, 1.0, 1.0], [0.0, 1.0, 1.0]], x.at[0..-1, 1..].add(1.0).tolist
+    assert_equal [[5.0, 5.0, 5.0], [5.0, 5.0, 5.0]], x.at[:"..."].add(5.0).tolist
+
+    mask = MLX::Core.array([true, false], MLX::Core.bool_)
+    assert_equal [[0.0, 3.0, 0.0], [0.0, 0.0, 0.0]], x.at[mask, 1].maximum(3.0).tolist
+  end
+
+  def test_requires_indices
+    x = MLX::Core.zeros([2], MLX::Core.float32)
+    assert_raises(ArgumentError) { x.at.add(1.0) }
+    assert_raises(ArgumentError) { x.at[] }
+  end
+end
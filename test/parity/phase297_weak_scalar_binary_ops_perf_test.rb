@@ -0,0 +1,51 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase297WeakScalarBinaryOpsPerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_scalars_adopt_the_array_dtype
+    bf16 = MLX::Core.array([1.0, 2.0], MLX::Core.bfloat16)
+    assert_equal MLX::Core.bfloat16, (bf16 * 2).dtype
+    assert_equal MLX::Core.bfloat16, (bf16 + 0.5).dtype
+    assert_equal [2.0, 4.0], (bf16 * 2).tolist
+
+    half = MLX::Core.array([1.0], MLX::Core.float16)
+    assert_equal MLX::Core.float16, MLX::Core.subtract(1.0, half).dtype
+    assert_equal MLX::Core.float16, half.__rmul__(3).dtype
+
+    int8 = MLX::Core.array([1, 2], MLX::Core.int8)
+    assert_equal MLX::Core.int8, (int8 + 1).dtype
+    assert_equal MLX::Core.int8, MLX::Core.maximum(int8, 0).dtype
+    assert_equal [3, 4], MLX::Core.add(int8, 2).tolist
+  end
+
+  def test_promotions_that_change_kind_still_apply
+    int32 = MLX::Core.array([1, 2], MLX::Core.int32)
+    assert_equal MLX::Core.float32, (int32 * 1.5).dtype
+    assert_equal MLX::Core.int64, MLX::Core.add(int32, 2**40).dtype
+
+    flags = MLX::Core.array([true, false], MLX::Core.bool_)
+    assert_equal MLX::Core.int32, MLX::Core.add(flags, 1).dtype
+    assert_equal MLX::Core.bool_, MLX::Core.logical_and(flags, true).dtype
+
+    assert_equal MLX::Core.bool_, MLX::Core.greater(int32, 1).dtype
+    assert_equal [false, true], MLX::Core.greater(int32, 1).tolist
+  end
+
+  def test_arrays_on_both_sides_use_normal_promotion
+    half = MLX::Core.array([1.0], MLX::Core.float16)
+    single = MLX::Core.array([1.0], MLX::Core.float32)
+    assert_equal MLX::Core.float32, (half + single).dtype
+    assert_equal MLX::Core.int64, MLX::Core.add(2, 3).dtype
+  end
+end
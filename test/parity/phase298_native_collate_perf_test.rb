@@ -0,0 +1,91 @@
+# frozen_string_literal: true
+
+require_relative "test_helper"
+
+class Phase298NativeCollatePerfTest < Minitest::Test
+  def setup
+    TestSupport.build_native_extension!
+    $LOAD_PATH.unshift(File.join(RUBY_ROOT, "lib"))
+    require "mlx"
+  end
+
+  def teardown
+    $LOAD_PATH.delete(File.join(RUBY_ROOT, "lib"))
+  end
+
+  def test_hash_samples_stack_and_pad_per_key
+    samples = [
+      {tokens: [1, 2, 3], label: 0, features: MLX::Core.array([[0.5, 1.0]])},
+      {tokens: [4], label: 1, features: MLX::Core.array([[2.0, 3.0], [4.0, 5.0]])}
+    ]
+    batch = MLX::Core.collate(samples, pad_value: -1)
+
+    assert_equal %i[tokens label features tokens_lengths features_lengths].sort, batch.keys.sort
+    assert_equal [[1, 2, 3], [4, -1, -1]], batch[:tokens].tolist
+    assert_equal MLX::Core.int32, batch[:tokens].dtype
+    assert_equal [3, 1], batch[:tokens_lengths].tolist
+    assert_equal MLX::Core.int32, batch[:tokens_lengths].dtype
+    assert_equal [0, 1], batch[:label].tolist
+    assert_equal [2, 2, 2], batch[:features].shape
+    assert_equal [[[0.5, 1.0], [-1.0, -1.0]], [[2.0, 3.0], [4.0, 5.0]]], batch[:features].tolist
+    assert_equal [1, 2], batch[:features_lengths].tolist
+  end
+
+  def test_pad_to_multiple_of_and_dtype_promotion
+    batch = MLX::Core.collate(
+      [{"x" => [1, 2]}, {"x" => MLX::Core.array([3.5, 4.5], MLX::Core.float16)}],
+      pad_to_multiple_of: 4
+    )
+
+    assert_equal MLX::Core.float16, batch["x"].dtype
+    assert_equal [2, 4], batch["x"].shape
+    assert_equal [[1.0, 2.0, 0.0, 0.0], [3.5, 4.5, 0.0, 0.0]], batch["x"].tolist
+    assert_equal [2, 2], batch["x_lengths"].tolist
+  end
+
+  def test_tuple_and_single_field_samples
+    inputs, targets, input_lengths = MLX::Core.collate([[[1, 2], 0], [[3, 4, 5], 1]])
+    assert_equal [[1, 2, 0], [3, 4, 5]], inputs.tolist
+    assert_equal [0, 1], targets.tolist
+    assert_equal [2, 3], input_lengths.tolist
+
+    stacked, lengths = MLX::Core.collate([MLX::Core.array([1.0, 2.0]), MLX::Core.array([3.0])], pad_value: 9)
+    assert_equal [[1.0, 2.0], [3.0, 9.0]], stacked.tolist
+    assert_equal [2, 1], lengths.tolist
+
+    assert_equal [5, 6], MLX::Core.collate([5, 6]).tolist
+
+    strided = MLX::Core.arange(6).reshape([2, 3]).transpose
+    batch, = MLX::Core.collate([strided])
+    assert_equal [[[0, 3], [1, 4], [2, 5]]], batch.tolist
+  end
+
+  def test_numeric_array_samples_pad_as_sequences
+    tokens, lengths = MLX::Core.collate([[1, 2, 3], [4], []], pad_value: -1)
+
+    assert_equal [[1, 2, 3], [4, -1, -1], [-1, -1, -1]], tokens.tolist
+    assert_equal MLX::Core.int32, tokens.dtype
+    assert_equal [3, 1, 0], lengths.tolist
+    assert_equal MLX::Core.int32, lengths.dtype
+
+    mask, = MLX::Core.collate([[true, false], [true]], pad_value: false)
+    assert_equal MLX::Core.bool_, mask.dtype
+    assert_equal [[true, false], [true, false]], mask.tolist
+  end
+
+  def test_lengths_keys_keep_the_key_encoding
+    batch = MLX::Core.collate([{"größe" => [1, 2]}, {"größe" => [3]}])
+
+    assert_equal Encoding::UTF_8, batch.keys.last.encoding
+    assert_equal [2, 1], batch["größe_lengths"].tolist
+    assert_equal [3], MLX::Core.collate([{größe: [1, 2, 3]}])[:größe_lengths].tolist
+  end
+
+  def test_invalid_batches_raise_argument_error
+    assert_raises(ArgumentError) { MLX::Core.collate([]) }
+    assert_raises(ArgumentError) { MLX::Core.collate([{x: 1}, {y: 2}]) }
+    assert_raises(ArgumentError) { MLX::Core.collate([[[1], 2], [1]]) }
+    assert_raises(ArgumentError) { MLX::Core.collate([[[1, 2]], [[[1], [2]]]]) }
+    assert_raises(ArgumentError) { MLX::Core.collate([[1]], pad_to_multiple_of: 0) }
+  end
+end